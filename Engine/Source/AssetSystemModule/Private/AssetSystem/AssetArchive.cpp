@@ -0,0 +1,249 @@
+#include "aspch.h"
+#include "AssetArchive.h"
+
+#include "AssetSystem/AssetManager.h"
+
+#include <CoreUtilities/StringHash.h>
+#include <CoreUtilities/StringUtility.h>
+
+#include <numeric>
+
+namespace Volt
+{
+	namespace Utility
+	{
+		// Keeps the start of every asset 16 byte aligned, so the streams can read values in place.
+		inline static constexpr uint64_t ASSET_DATA_ALIGNMENT = 16;
+
+		VT_INLINE uint64_t AlignAssetDataOffset(uint64_t offset)
+		{
+			return (offset + ASSET_DATA_ALIGNMENT - 1) & ~(ASSET_DATA_ALIGNMENT - 1);
+		}
+	}
+
+	AssetArchive::AssetArchive(const std::filesystem::path& archivePath)
+		: m_archivePath(archivePath), m_mappedFile(archivePath)
+	{
+		if (!m_mappedFile.IsValid())
+		{
+			VT_LOGC(Error, LogAssetSystem, "Failed to open asset archive {0}!", archivePath);
+			return;
+		}
+
+		const uint8_t* archiveData = m_mappedFile.GetData();
+		const size_t archiveSize = m_mappedFile.GetSize();
+
+		AssetArchiveHeader header{};
+		if (archiveSize < sizeof(AssetArchiveHeader))
+		{
+			VT_LOGC(Error, LogAssetSystem, "Asset archive {0} is truncated!", archivePath);
+			return;
+		}
+
+		memcpy_s(&header, sizeof(AssetArchiveHeader), archiveData, sizeof(AssetArchiveHeader));
+
+		// Compared against every loose file with the same path, so it is only read once.
+		std::error_code writeTimeError;
+		m_writeTime = std::filesystem::last_write_time(archivePath, writeTimeError);
+
+		if (header.magic != AssetArchiveHeader::Magic || header.version != AssetArchiveHeader::CurrentVersion)
+		{
+			VT_LOGC(Error, LogAssetSystem, "Asset archive {0} has an unsupported version!", archivePath);
+			return;
+		}
+
+		const size_t tableSize = sizeof(AssetArchiveEntry) * header.entryCount;
+		if (sizeof(AssetArchiveHeader) + tableSize > archiveSize || header.pathTableOffset + header.pathTableSize > archiveSize)
+		{
+			VT_LOGC(Error, LogAssetSystem, "Asset archive {0} is truncated!", archivePath);
+			return;
+		}
+
+		// The table is read with a single copy, the asset data is left in the mapping
+		m_entries.resize(header.entryCount);
+		memcpy_s(m_entries.data(), tableSize, archiveData + sizeof(AssetArchiveHeader), tableSize);
+
+		for (const auto& entry : m_entries)
+		{
+			if (entry.dataOffset + entry.dataSize > archiveSize || static_cast<uint64_t>(entry.pathOffset) + entry.pathLength > header.pathTableSize)
+			{
+				VT_LOGC(Error, LogAssetSystem, "Asset archive {0} has an invalid entry for asset {1}!", archivePath, entry.handle);
+				m_entries.clear();
+				return;
+			}
+		}
+
+		m_pathTable = std::string_view{ reinterpret_cast<const char*>(archiveData + header.pathTableOffset), header.pathTableSize };
+
+		m_pathHashOrder.resize(m_entries.size());
+		std::iota(m_pathHashOrder.begin(), m_pathHashOrder.end(), 0u);
+		std::sort(m_pathHashOrder.begin(), m_pathHashOrder.end(), [&](uint32_t lhs, uint32_t rhs)
+		{
+			return m_entries[lhs].pathHash < m_entries[rhs].pathHash;
+		});
+
+		m_isValid = true;
+	}
+
+	const AssetArchiveEntry* AssetArchive::FindEntry(AssetHandle handle) const
+	{
+		const uint64_t handleValue = handle.Get();
+
+		auto it = std::lower_bound(m_entries.begin(), m_entries.end(), handleValue, [](const AssetArchiveEntry& entry, uint64_t value)
+		{
+			return entry.handle < value;
+		});
+
+		if (it == m_entries.end() || it->handle != handleValue)
+		{
+			return nullptr;
+		}
+
+		return &*it;
+	}
+
+	const AssetArchiveEntry* AssetArchive::FindEntry(std::string_view filePath) const
+	{
+		const uint64_t pathHash = GetPathHash(filePath);
+
+		auto it = std::lower_bound(m_pathHashOrder.begin(), m_pathHashOrder.end(), pathHash, [&](uint32_t index, uint64_t value)
+		{
+			return m_entries[index].pathHash < value;
+		});
+
+		for (; it != m_pathHashOrder.end() && m_entries[*it].pathHash == pathHash; ++it)
+		{
+			const auto& entry = m_entries[*it];
+			if (GetAssetFilePath(entry) == filePath)
+			{
+				return &entry;
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::span<const uint8_t> AssetArchive::GetAssetData(const AssetArchiveEntry& entry) const
+	{
+		return { m_mappedFile.GetData() + entry.dataOffset, entry.dataSize };
+	}
+
+	std::string_view AssetArchive::GetAssetFilePath(const AssetArchiveEntry& entry) const
+	{
+		return m_pathTable.substr(entry.pathOffset, entry.pathLength);
+	}
+
+	bool AssetArchive::Write(const std::filesystem::path& archivePath, const Vector<AssetArchiveSourceFile>& sourceFiles)
+	{
+		VT_PROFILE_FUNCTION();
+
+		Vector<const AssetArchiveSourceFile*> sortedSourceFiles;
+		sortedSourceFiles.reserve(sourceFiles.size());
+
+		for (const auto& sourceFile : sourceFiles)
+		{
+			sortedSourceFiles.emplace_back(&sourceFile);
+		}
+
+		std::sort(sortedSourceFiles.begin(), sortedSourceFiles.end(), [](const AssetArchiveSourceFile* lhs, const AssetArchiveSourceFile* rhs)
+		{
+			return lhs->handle.Get() < rhs->handle.Get();
+		});
+
+		Vector<AssetArchiveEntry> entries;
+		Vector<const AssetArchiveSourceFile*> packedSourceFiles;
+		std::string pathTable;
+
+		entries.reserve(sortedSourceFiles.size());
+		packedSourceFiles.reserve(sortedSourceFiles.size());
+
+		for (const auto* sourceFile : sortedSourceFiles)
+		{
+			if (!entries.empty() && entries.back().handle == sourceFile->handle.Get())
+			{
+				VT_LOGC(Warning, LogAssetSystem, "Asset {0} was added to archive {1} more than once, only the first one is packed!", sourceFile->handle, archivePath);
+				continue;
+			}
+
+			std::error_code errorCode{};
+			const uint64_t fileSize = std::filesystem::file_size(sourceFile->filesystemPath, errorCode);
+			if (errorCode)
+			{
+				VT_LOGC(Error, LogAssetSystem, "Unable to pack asset {0}, file {1} could not be read!", sourceFile->handle, sourceFile->filesystemPath);
+				continue;
+			}
+
+			const std::string filePath = ::Utility::ReplaceCharacter(sourceFile->filePath.string(), '\\', '/');
+
+			AssetArchiveEntry& entry = entries.emplace_back();
+			entry.handle = sourceFile->handle.Get();
+			entry.typeGuid = sourceFile->type->GetGUID();
+			entry.dataSize = fileSize;
+			entry.pathHash = GetPathHash(filePath);
+			entry.pathOffset = static_cast<uint32_t>(pathTable.size());
+			entry.pathLength = static_cast<uint32_t>(filePath.size());
+
+			pathTable += filePath;
+			packedSourceFiles.emplace_back(sourceFile);
+		}
+
+		AssetArchiveHeader header{};
+		header.magic = AssetArchiveHeader::Magic;
+		header.version = AssetArchiveHeader::CurrentVersion;
+		header.entryCount = static_cast<uint32_t>(entries.size());
+		header.pathTableOffset = sizeof(AssetArchiveHeader) + sizeof(AssetArchiveEntry) * entries.size();
+		header.pathTableSize = pathTable.size();
+
+		uint64_t currentDataOffset = header.pathTableOffset + header.pathTableSize;
+		for (auto& entry : entries)
+		{
+			currentDataOffset = Utility::AlignAssetDataOffset(currentDataOffset);
+			entry.dataOffset = currentDataOffset;
+			currentDataOffset += entry.dataSize;
+		}
+
+		std::ofstream stream(archivePath, std::ios::out | std::ios::binary);
+		if (!stream)
+		{
+			VT_LOGC(Error, LogAssetSystem, "Unable to create asset archive {0}!", archivePath);
+			return false;
+		}
+
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(AssetArchiveHeader));
+		stream.write(reinterpret_cast<const char*>(entries.data()), sizeof(AssetArchiveEntry) * entries.size());
+		stream.write(pathTable.data(), pathTable.size());
+
+		constexpr std::array<char, Utility::ASSET_DATA_ALIGNMENT> padding{};
+		uint64_t writtenSize = header.pathTableOffset + header.pathTableSize;
+
+		// Files are streamed one at a time, the whole archive is never held in memory
+		Vector<uint8_t> fileData;
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			const auto& entry = entries[i];
+
+			stream.write(padding.data(), entry.dataOffset - writtenSize);
+
+			std::ifstream sourceStream(packedSourceFiles[i]->filesystemPath, std::ios::in | std::ios::binary);
+			fileData.resize_uninitialized(entry.dataSize);
+			sourceStream.read(reinterpret_cast<char*>(fileData.data()), fileData.size());
+
+			if (!sourceStream || static_cast<uint64_t>(sourceStream.gcount()) != entry.dataSize)
+			{
+				VT_LOGC(Error, LogAssetSystem, "Failed to read {0} while writing asset archive {1}!", packedSourceFiles[i]->filesystemPath, archivePath);
+				return false;
+			}
+
+			stream.write(reinterpret_cast<const char*>(fileData.data()), fileData.size());
+			writtenSize = entry.dataOffset + entry.dataSize;
+		}
+
+		VT_LOGC(Info, LogAssetSystem, "Packed {0} assets into {1}!", entries.size(), archivePath);
+		return true;
+	}
+
+	uint64_t AssetArchive::GetPathHash(std::string_view filePath)
+	{
+		return StringHash::Construct(filePath).hash;
+	}
+}
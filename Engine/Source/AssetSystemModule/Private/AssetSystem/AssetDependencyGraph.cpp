@@ -3,6 +3,8 @@
 
 #include "AssetSystem/AssetManager.h"
 
+#include <unordered_set>
+
 namespace Volt
 {
 	AssetDependencyGraph::AssetDependencyGraph()
@@ -41,7 +43,6 @@ namespace Volt
 
 	void AssetDependencyGraph::AddDependencyToAsset(AssetHandle handle, AssetHandle dependency)
 	{
-		// #TODO_Ivar: Check if asset already is a dependency, so we don't add it twice
 		WriteLock lock{ m_mutex };
 		if (!DoAssetExistInGraph(handle))
 		{
@@ -55,7 +56,26 @@ namespace Volt
 			return;
 		}
 
-		m_graph.LinkNodes(m_assetNodeIds.at(handle), m_assetNodeIds.at(dependency));
+		const UUID64 nodeId = m_assetNodeIds.at(handle);
+		const UUID64 dependencyNodeId = m_assetNodeIds.at(dependency);
+
+		if (m_graph.FindEdge(nodeId, dependencyNodeId) != 0)
+		{
+			return;
+		}
+
+		m_graph.LinkNodes(nodeId, dependencyNodeId);
+	}
+
+	void AssetDependencyGraph::RemoveDependencyToAsset(AssetHandle handle, AssetHandle dependency)
+	{
+		WriteLock lock{ m_mutex };
+		if (!DoAssetExistInGraph(handle) || !DoAssetExistInGraph(dependency))
+		{
+			return;
+		}
+
+		m_graph.RemoveEdge(m_graph.FindEdge(m_assetNodeIds.at(handle), m_assetNodeIds.at(dependency)));
 	}
 
 	void AssetDependencyGraph::OnAssetChanged(AssetHandle handle, AssetChangedState state)
@@ -77,7 +97,7 @@ namespace Volt
 		}
 	}
 
-	const Vector<AssetHandle> AssetDependencyGraph::GetAssetDependencyChain(AssetHandle handle) const
+	const Vector<AssetHandle> AssetDependencyGraph::GetAssetsDependentOn(AssetHandle handle) const
 	{
 		if (!DoAssetExistInGraph(handle))
 		{
@@ -88,43 +108,29 @@ namespace Volt
 		Vector<AssetHandle> result;
 		result.emplace_back(handle);
 
-		const auto& node = m_graph.GetNodeFromID(m_assetNodeIds.at(handle));
+		const UUID64 nodeId = m_assetNodeIds.at(handle);
 
-		for (const auto& output : node.GetInputEdges())
-		{
-			const auto& edge = m_graph.GetEdgeFromID(output);
-			auto nodeRes = GetAssetDependencyChain(m_graph.GetNodeFromID(edge.startNode).nodeData.handle);
+		// Walks the incoming edges breadth first, so every dependant is visited once, even when several paths lead to it
+		std::unordered_set<UUID64> visitedNodes;
+		visitedNodes.insert(nodeId);
 
-			for (const auto& res : nodeRes)
-			{
-				result.emplace_back(res);
-			}
-		}
+		Vector<UUID64> nodesToVisit;
+		nodesToVisit.emplace_back(nodeId);
 
-		return result;
-	}
-
-	const Vector<AssetHandle> AssetDependencyGraph::GetAssetsDependentOn(AssetHandle handle) const
-	{
-		if (!DoAssetExistInGraph(handle))
-		{
-			VT_LOG(Warning, "[AssetDependencyGraph]: Trying to get chain of asset not in the graph!");
-			return {};
-		}
-
-		Vector<AssetHandle> result;
-		result.emplace_back(handle);
-
-		const auto& node = m_graph.GetNodeFromID(m_assetNodeIds.at(handle));
-
-		for (const auto& output : node.GetInputEdges())
+		for (size_t i = 0; i < nodesToVisit.size(); i++)
 		{
-			const auto& edge = m_graph.GetEdgeFromID(output);
-			auto nodeRes = GetAssetDependencyChain(m_graph.GetNodeFromID(edge.startNode).nodeData.handle);
+			const auto& node = m_graph.GetNodeFromID(nodesToVisit[i]);
 
-			for (const auto& res : nodeRes)
+			for (const auto& input : node.GetInputEdges())
 			{
-				result.emplace_back(res);
+				const UUID64 dependantNodeId = m_graph.GetEdgeFromID(input).startNode;
+				if (!visitedNodes.insert(dependantNodeId).second)
+				{
+					continue;
+				}
+
+				result.emplace_back(m_graph.GetNodeFromID(dependantNodeId).nodeData.handle);
+				nodesToVisit.emplace_back(dependantNodeId);
 			}
 		}
 
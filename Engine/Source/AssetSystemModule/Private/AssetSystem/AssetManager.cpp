@@ -2,13 +2,13 @@
 #include "AssetManager.h"
 
 #include "AssetSystem/AssetDependencyGraph.h"
+#include "AssetSystem/AssetArchive.h"
 #include "AssetSystem/AssetFactory.h"
 #include "AssetSystem/Serialization/AssetSerializer.h"
 #include "AssetSystem/AssetSerializerRegistry.h"
 
 #include <JobSystem/JobSystem.h>
 
-#include <JobSystem/TaskGraph.h>
 
 #include <CoreUtilities/Time/ScopedTimer.h>
 #include <CoreUtilities/ThreadUtilities.h>
@@ -37,15 +37,26 @@ namespace Volt
 	void AssetManager::Initialize()
 	{
 		m_dependencyGraph = CreateScope<AssetDependencyGraph>();
+		m_streamingScheduler = CreateScope<AssetStreamingScheduler>([this](const AssetMetadata& metadata, Ref<Asset> asset)
+		{
+			DeserializeQueuedAsset(metadata, asset);
+		});
+
 		LoadAllAssetMetadata();
 	}
 
 	void AssetManager::Shutdown()
 	{
+		// Finishes or cancels all requests in flight
+		m_streamingScheduler = nullptr;
+
 		m_assetCache.clear();
 		m_memoryAssets.clear();
 		m_assetRegistry.clear();
+		m_pathIndex.clear();
+		m_stemIndex.clear();
 
+		m_archives.clear();
 		m_dependencyGraph = nullptr;
 	}
 
@@ -155,6 +166,17 @@ namespace Volt
 		asset->handle = metadata.handle;
 		asset->assetName = metadata.filePath.stem().string();
 
+		// The serializer reads archived assets through their regular file path
+		std::optional<PrefetchedFileScope> archivedFile;
+		if (metadata.isArchived)
+		{
+			const std::span<const uint8_t> archivedData = GetArchivedAssetData(assetHandle);
+			if (!archivedData.empty())
+			{
+				archivedFile.emplace(GetFilesystemPath(metadata.filePath), archivedData);
+			}
+		}
+
 		{
 #ifndef VT_DIST
 			ScopedTimer timer{};
@@ -185,28 +207,28 @@ namespace Volt
 		VT_LOGC(Info, LogAssetSystem, "Fetching asset meta data...");
 		ScopedTimer timer{};
 
+		// Loose files are always crawled, they replace archived assets that are missing from or older than them
+		MountAssetArchives(m_engineDirectory);
+		if (m_projectDirectory.lexically_normal() != m_engineDirectory.lexically_normal())
+		{
+			MountAssetArchives(m_projectDirectory);
+		}
+
 		const auto projectAssetFiles = GetProjectAssetFiles();
 		const auto engineAssetFiles = GetEngineAssetFiles();
 
-		TaskGraph taskGraph{};
-
-		for (auto file : engineAssetFiles)
+		const size_t engineAssetFileCount = engineAssetFiles.size();
+		JobSystem::ParallelFor(engineAssetFileCount + projectAssetFiles.size(), [&](size_t fileIndex)
 		{
-			taskGraph.AddTask([this, file]() 
+			if (fileIndex < engineAssetFileCount)
 			{
-				DeserializeAssetMetadata(file);
-			});
-		}
-
-		for (auto file : projectAssetFiles)
-		{
-			taskGraph.AddTask([this, file]()
+				DeserializeAssetMetadata(engineAssetFiles[fileIndex]);
+			}
+			else
 			{
-				DeserializeAssetMetadata(GetFilesystemPath(file));
-			});
-		}
-
-		taskGraph.ExecuteAndWait();
+				DeserializeAssetMetadata(GetFilesystemPath(projectAssetFiles[fileIndex - engineAssetFileCount]));
+			}
+		});
 
 		for (const auto& [handle, metadata] : m_assetRegistry)
 		{
@@ -220,6 +242,20 @@ namespace Volt
 	{
 		constexpr size_t assetHeaderSize = SerializedAssetMetadata::HeaderSize;
 
+		const std::filesystem::path relativePath = GetRelativePath(assetPath);
+
+		// The archive is kept unless the loose file has been saved since it was cooked, in which case the file doesn't have to be opened
+		if (const AssetArchive* archive = GetArchiveForFilePath(relativePath))
+		{
+			std::error_code assetError;
+			const auto assetWriteTime = std::filesystem::last_write_time(assetPath, assetError);
+
+			if (assetError || assetWriteTime <= archive->GetWriteTime())
+			{
+				return;
+			}
+		}
+
 		BinaryStreamReader streamReader{ assetPath, assetHeaderSize };
 		if (!streamReader.IsStreamValid())
 		{
@@ -242,11 +278,136 @@ namespace Volt
 			WriteLock lock{ m_assetRegistryMutex };
 			AssetMetadata& metadata = m_assetRegistry[serializedMetadata.handle];
 			metadata.handle = serializedMetadata.handle;
-			metadata.filePath = GetRelativePath(assetPath);
+			metadata.isArchived = false;
 			metadata.type = serializedMetadata.type;
+			SetAssetFilePath(metadata, relativePath);
+		}
+	}
+
+	void AssetManager::MountAssetArchives(const std::filesystem::path& directory)
+	{
+		if (!FileSystem::Exists(directory))
+		{
+			return;
+		}
+
+		// Directory iteration order is unspecified, sorting makes the precedence between archives deterministic
+		Vector<std::filesystem::path> archivePaths;
+		for (const auto& directoryEntry : std::filesystem::directory_iterator(directory))
+		{
+			if (directoryEntry.path().extension() == AssetArchive::Extension)
+			{
+				archivePaths.emplace_back(directoryEntry.path());
+			}
+		}
+
+		std::sort(archivePaths.begin(), archivePaths.end());
+
+		for (const auto& archivePath : archivePaths)
+		{
+			Scope<AssetArchive> archive = CreateScope<AssetArchive>(archivePath);
+			if (!archive->IsValid())
+			{
+				continue;
+			}
+
+			{
+				WriteLock lock{ m_assetRegistryMutex };
+				for (const auto& entry : archive->GetEntries())
+				{
+					AssetMetadata& metadata = m_assetRegistry[entry.handle];
+					metadata.handle = entry.handle;
+					metadata.type = GetAssetTypeRegistry().GetTypeFromGUID(entry.typeGuid);
+					metadata.isArchived = true;
+					SetAssetFilePath(metadata, archive->GetAssetFilePath(entry));
+				}
+			}
+
+			VT_LOGC(Info, LogAssetSystem, "Mounted asset archive {0} with {1} assets!", archivePath, archive->GetEntries().size());
+
+			m_archives.emplace_back(std::move(archive));
 		}
 	}
 
+	const AssetArchive* AssetManager::GetArchiveForAsset(AssetHandle handle) const
+	{
+		for (auto it = m_archives.rbegin(); it != m_archives.rend(); ++it)
+		{
+			if ((*it)->FindEntry(handle))
+			{
+				return it->get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	const AssetArchive* AssetManager::GetArchiveForFilePath(const std::filesystem::path& filePath) const
+	{
+		if (m_archives.empty())
+		{
+			return nullptr;
+		}
+
+		const std::string pathKey = GetPathIndexKey(filePath);
+		for (auto it = m_archives.rbegin(); it != m_archives.rend(); ++it)
+		{
+			if ((*it)->FindEntry(pathKey))
+			{
+				return it->get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::span<const uint8_t> AssetManager::GetArchivedAssetData(AssetHandle handle) const
+	{
+		const AssetArchive* archive = GetArchiveForAsset(handle);
+		if (!archive)
+		{
+			return {};
+		}
+
+		return archive->GetAssetData(*archive->FindEntry(handle));
+	}
+
+	bool AssetManager::CookAssetArchive(const std::filesystem::path& archivePath, const Vector<AssetHandle>& handles)
+	{
+		auto& instance = Get();
+
+		Vector<AssetArchiveSourceFile> sourceFiles;
+		sourceFiles.reserve(handles.size());
+
+		{
+			ReadLock lock{ instance.m_assetRegistryMutex };
+
+			for (const auto& handle : handles)
+			{
+				const auto& metadata = GetMetadataFromHandle(handle);
+				if (!metadata.IsValid() || metadata.isMemoryAsset)
+				{
+					VT_LOGC(Warning, LogAssetSystem, "Unable to pack asset {0}, it has no file!", handle);
+					continue;
+				}
+
+				if (metadata.isArchived)
+				{
+					VT_LOGC(Warning, LogAssetSystem, "Unable to pack asset {0}, it is already in an archive!", handle);
+					continue;
+				}
+
+				AssetArchiveSourceFile& sourceFile = sourceFiles.emplace_back();
+				sourceFile.handle = metadata.handle;
+				sourceFile.type = metadata.type;
+				sourceFile.filePath = metadata.filePath;
+				sourceFile.filesystemPath = GetFilesystemPath(metadata.filePath);
+			}
+		}
+
+		return AssetArchive::Write(archivePath, sourceFiles);
+	}
+
 	void AssetManager::Unload(AssetHandle assetHandle)
 	{
 		{
@@ -319,19 +480,21 @@ namespace Volt
 		}
 
 		// If the asset already exists in the registry, we only update the file path
-		if (!instance.m_assetRegistry.contains(asset->handle))
-		{
-			AssetMetadata& metaData = instance.m_assetRegistry[asset->handle];
-			metaData.filePath = GetCleanAssetFilePath(targetFilePath);
-			metaData.handle = asset->handle;
-			metaData.isLoaded = true;
-			metaData.type = asset->GetType();
-		}
-		else
 		{
 			WriteLock lock{ instance.m_assetRegistryMutex };
-			AssetMetadata& metaData = instance.m_assetRegistry[asset->handle];
-			metaData.filePath = GetCleanAssetFilePath(targetFilePath);
+			if (!instance.m_assetRegistry.contains(asset->handle))
+			{
+				AssetMetadata& metaData = instance.m_assetRegistry[asset->handle];
+				metaData.handle = asset->handle;
+				metaData.isLoaded = true;
+				metaData.type = asset->GetType();
+				instance.SetAssetFilePath(metaData, GetCleanAssetFilePath(targetFilePath));
+			}
+			else
+			{
+				AssetMetadata& metaData = instance.m_assetRegistry[asset->handle];
+				instance.SetAssetFilePath(metaData, GetCleanAssetFilePath(targetFilePath));
+			}
 		}
 
 		AssetMetadata metadata = s_nullMetadata;
@@ -359,6 +522,12 @@ namespace Volt
 #endif
 		}
 
+		{
+			// The loose file is now newer than the archived one
+			WriteLock lock{ instance.m_assetRegistryMutex };
+			GetMetadataFromHandleMutable(asset->handle).isArchived = false;
+		}
+
 		{
 			WriteLock lock{ instance.m_assetCacheMutex };
 			if (!instance.m_assetCache.contains(asset->handle))
@@ -407,6 +576,12 @@ namespace Volt
 #endif
 		}
 
+		{
+			// The loose file is now newer than the archived one
+			WriteLock lock{ instance.m_assetRegistryMutex };
+			GetMetadataFromHandleMutable(asset->handle).isArchived = false;
+		}
+
 		{
 			WriteLock lock{ instance.m_assetCacheMutex };
 			if (!instance.m_assetCache.contains(asset->handle))
@@ -441,7 +616,7 @@ namespace Volt
 
 		{
 			WriteLock lock{ m_assetRegistryMutex };
-			m_assetRegistry[asset->handle].filePath = newPath;
+			SetAssetFilePath(m_assetRegistry[asset->handle], newPath);
 		}
 	}
 
@@ -469,7 +644,7 @@ namespace Volt
 
 		{
 			WriteLock lock{ m_assetRegistryMutex };
-			m_assetRegistry[assetHandle].filePath = newPath;
+			SetAssetFilePath(m_assetRegistry[assetHandle], newPath);
 		}
 	}
 
@@ -482,8 +657,13 @@ namespace Volt
 		{
 			WriteLock lock{ m_assetRegistryMutex };
 			AssetMetadata& metadata = GetMetadataFromFilePathMutable(sourcePath);
+			if (!metadata.IsValid())
+			{
+				VT_LOGC(Warning, LogAssetSystem, "Trying to move invalid asset {0} in registry!", sourcePath);
+				return;
+			}
 
-			metadata.filePath = GetCleanAssetFilePath(targetPath);
+			SetAssetFilePath(metadata, GetCleanAssetFilePath(targetPath));
 			assetHandle = metadata.handle;
 		}
 	}
@@ -534,7 +714,7 @@ namespace Volt
 
 				newPath.erase(directoryStringLoc, sourceDir.string().length());
 				newPath.insert(directoryStringLoc, targetDir.string());
-				metadata.filePath = GetCleanAssetFilePath(newPath);
+				SetAssetFilePath(metadata, GetCleanAssetFilePath(newPath));
 			}
 		}
 	}
@@ -553,7 +733,7 @@ namespace Volt
 				return;
 			}
 
-			m_assetRegistry.at(assetHandle).filePath = newPath;
+			SetAssetFilePath(m_assetRegistry.at(assetHandle), newPath);
 		}
 
 		{
@@ -578,7 +758,7 @@ namespace Volt
 			return;
 		}
 
-		metadata.filePath = GetCleanAssetFilePath(targetFilePath);
+		SetAssetFilePath(metadata, GetCleanAssetFilePath(targetFilePath));
 	}
 
 	void AssetManager::RemoveAsset(AssetHandle assetHandle)
@@ -591,6 +771,7 @@ namespace Volt
 		}
 
 		WriteLock lock{ m_assetRegistryMutex };
+		RemoveFromPathIndex(metadata);
 		m_assetRegistry.erase(assetHandle);
 
 		const std::filesystem::path filePath = metadata.filePath;
@@ -687,6 +868,7 @@ namespace Volt
 
 		{
 			WriteLock lock{ m_assetRegistryMutex };
+			RemoveFromPathIndex(metadata);
 			m_assetRegistry.erase(assetHandle);
 		}
 
@@ -718,6 +900,7 @@ namespace Volt
 
 		{
 			WriteLock lock{ m_assetRegistryMutex };
+			RemoveFromPathIndex(metadata);
 			m_assetRegistry.erase(metadata.handle);
 		}
 
@@ -775,6 +958,7 @@ namespace Volt
 					WriteLock registryMutex{ m_assetRegistryMutex };
 					if (m_assetRegistry.contains(handle))
 					{
+						RemoveFromPathIndex(m_assetRegistry.at(handle));
 						m_assetRegistry.erase(handle);
 					}
 				}
@@ -829,8 +1013,8 @@ namespace Volt
 			WriteLock lock{ m_assetRegistryMutex };
 			AssetMetadata& metadata = m_assetRegistry[newHandle];
 			metadata.handle = newHandle;
-			metadata.filePath = cleanFilePath;
 			metadata.type = type;
+			SetAssetFilePath(metadata, cleanFilePath);
 		}
 
 		m_dependencyGraph->AddAssetToGraph(newHandle);
@@ -921,7 +1105,7 @@ namespace Volt
 		return asset;
 	}
 
-	Ref<Asset> AssetManager::QueueAssetRaw(AssetHandle assetHandle)
+	Ref<Asset> AssetManager::QueueAssetRaw(AssetHandle assetHandle, AssetLoadPriority priority)
 	{
 		if (assetHandle == Asset::Null())
 		{
@@ -936,7 +1120,7 @@ namespace Volt
 
 		Ref<Asset> asset = GetAssetFactory().CreateAssetOfType(assetType);
 		asset->SetFlag(AssetFlag::Queued, true);
-		Get().QueueAssetInternal(assetHandle, asset);
+		Get().QueueAssetInternal(assetHandle, asset, priority);
 
 		return asset;
 	}
@@ -992,17 +1176,13 @@ namespace Volt
 		auto& instance = Get();
 		ReadLock lock{ instance.m_assetRegistryMutex };
 
-		std::filesystem::path cleanPath = GetRelativePath(filePath);
-
-		for (const auto& [handle, metaData] : instance.m_assetRegistry)
+		const AssetMetadata* metadata = instance.FindMetadataFromPathIndex(GetRelativePath(filePath));
+		if (!metadata)
 		{
-			if (metaData.filePath == cleanPath)
-			{
-				return metaData;
-			}
+			return s_nullMetadata;
 		}
 
-		return s_nullMetadata;
+		return *metadata;
 	}
 
 	const AssetManager::AssetRegistry& AssetManager::GetAssetRegistry()
@@ -1044,8 +1224,18 @@ namespace Volt
 
 		ReadLock lock{ instance.m_assetRegistryMutex };
 
-		for (const auto& [handle, metadata] : instance.m_assetRegistry)
+		const std::filesystem::path filenamePath = filename;
+
+		auto it = instance.m_stemIndex.find(filenamePath.stem().string());
+		if (it == instance.m_stemIndex.end())
+		{
+			return {};
+		}
+
+		// The stem index does not include the extension, so there might be multiple candidates
+		for (const auto& handle : it->second)
 		{
+			const auto& metadata = instance.m_assetRegistry.at(handle);
 			if (metadata.filePath.filename() == filename)
 			{
 				return metadata.filePath;
@@ -1104,7 +1294,7 @@ namespace Volt
 		return GetCleanAssetFilePath(relativePath);
 	}
 
-	void AssetManager::QueueAssetInternal(AssetHandle assetHandle, Ref<Asset>& asset)
+	void AssetManager::QueueAssetInternal(AssetHandle assetHandle, Ref<Asset>& asset, AssetLoadPriority priority)
 	{
 		// Check if asset is loaded
 		{
@@ -1113,6 +1303,7 @@ namespace Volt
 			if (m_assetCache.contains(assetHandle))
 			{
 				asset = m_assetCache.at(assetHandle);
+				m_streamingScheduler->RaisePriority(assetHandle, priority);
 				return;
 			}
 		}
@@ -1144,56 +1335,85 @@ namespace Volt
 		}
 
 		m_dependencyGraph->AddAssetToGraph(assetHandle);
+		const std::span<const uint8_t> archivedData = metadata.isArchived ? GetArchivedAssetData(assetHandle) : std::span<const uint8_t>{};
+		m_streamingScheduler->Enqueue(metadata, GetFilesystemPath(metadata.filePath), asset, priority, archivedData);
 
-		// If not, queue
-		{
-			JobSystem::CreateAndRunJob([this, metadata, handle = assetHandle]()
-			{
-				Ref<Asset> asset;
-				{
-					ReadLock lock{ m_assetCacheMutex };
-					asset = m_assetCache.at(handle);
-				}
+#ifndef VT_DIST
+		VT_LOGC(Trace, LogAssetSystem, "Queued asset {0} for loading!", metadata.filePath);
+#endif
+	}
 
-				if (handle != Asset::Null())
-				{
-					asset->handle = handle;
-				}
+	void AssetManager::DeserializeQueuedAsset(const AssetMetadata& metadata, Ref<Asset> asset)
+	{
+		const AssetHandle handle = metadata.handle;
 
-				asset->assetName = metadata.filePath.stem().string();
+		if (handle != Asset::Null())
+		{
+			asset->handle = handle;
+		}
 
-				{
+		asset->assetName = metadata.filePath.stem().string();
+
+		{
 #ifndef VT_DIST
-					ScopedTimer timer{};
+			ScopedTimer timer{};
 #endif
-					GetAssetSerializerRegistry().GetSerializer(metadata.type).Deserialize(metadata, asset);
+			GetAssetSerializerRegistry().GetSerializer(metadata.type).Deserialize(metadata, asset);
 
 #ifndef VT_DIST
-					VT_LOGC(Trace, LogAssetSystem, "Loaded asset {0} with handle {1} in {2} seconds!", metadata.filePath.string().c_str(), asset->handle, timer.GetTime<Time::Seconds>());
+			VT_LOGC(Trace, LogAssetSystem, "Loaded asset {0} with handle {1} in {2} seconds!", metadata.filePath.string().c_str(), asset->handle, timer.GetTime<Time::Seconds>());
 #endif
-				}
+		}
 
-				asset->SetFlag(AssetFlag::Queued, false);
+		asset->SetFlag(AssetFlag::Queued, false);
 
-				{
-					ReadLock lock{ m_assetRegistryMutex };
-					m_assetRegistry.at(handle).isLoaded = true;
-				}
+		{
+			WriteLock lock{ m_assetRegistryMutex };
+			if (m_assetRegistry.contains(handle))
+			{
+				m_assetRegistry.at(handle).isLoaded = true;
+			}
+		}
 
-				{
-					WriteLock lock{ m_assetCacheMutex };
-					m_assetCache[handle] = asset;
-				}
+		{
+			WriteLock lock{ m_assetCacheMutex };
+			m_assetCache[handle] = asset;
+		}
+
+		m_dependencyGraph->OnAssetChanged(handle, AssetChangedState::Updated);
+		QueueAssetChanged(asset->handle, AssetChangedState::Updated);
+	}
 
-				m_dependencyGraph->OnAssetChanged(handle, AssetChangedState::Updated);
-				QueueAssetChanged(asset->handle, AssetChangedState::Updated);
+	bool AssetManager::CancelQueuedAsset(AssetHandle handle)
+	{
+		auto& instance = Get();
+		if (!instance.m_streamingScheduler->Cancel(handle))
+		{
+			return false;
+		}
 
-			});
+		Ref<Asset> asset;
+
+		{
+			WriteLock lock{ instance.m_assetCacheMutex };
+			if (auto it = instance.m_assetCache.find(handle); it != instance.m_assetCache.end())
+			{
+				asset = it->second;
+				instance.m_assetCache.erase(it);
+			}
+		}
+
+		if (asset)
+		{
+			asset->SetFlag(AssetFlag::Queued, false);
+			asset->SetFlag(AssetFlag::Invalid, true);
+		}
 
 #ifndef VT_DIST
-			VT_LOGC(Trace, LogAssetSystem, "Queued asset {0} for loading!", metadata.filePath);
+		VT_LOGC(Trace, LogAssetSystem, "Cancelled queued asset {0}!", handle);
 #endif
-		}
+
+		return true;
 	}
 
 	AssetMetadata& AssetManager::GetMetadataFromHandleMutable(AssetHandle handle)
@@ -1210,17 +1430,13 @@ namespace Volt
 
 	AssetMetadata& AssetManager::GetMetadataFromFilePathMutable(const std::filesystem::path filePath)
 	{
-		auto& instance = Get();
-
-		for (auto& [handle, metaData] : instance.m_assetRegistry)
+		AssetMetadata* metadata = Get().FindMetadataFromPathIndex(filePath);
+		if (!metadata)
 		{
-			if (metaData.filePath == filePath)
-			{
-				return metaData;
-			}
+			return s_nullMetadata;
 		}
 
-		return s_nullMetadata;
+		return *metadata;
 	}
 
 	const std::filesystem::path AssetManager::GetCleanAssetFilePath(const std::filesystem::path& filePath)
@@ -1229,6 +1445,72 @@ namespace Volt
 		return pathClean;
 	}
 
+	std::string AssetManager::GetPathIndexKey(const std::filesystem::path& path)
+	{
+		return ::Utility::ReplaceCharacter(path.string(), '\\', '/');
+	}
+
+	void AssetManager::AddToPathIndex(const AssetMetadata& metadata)
+	{
+		// Memory assets do not have a path
+		if (metadata.filePath.empty())
+		{
+			return;
+		}
+
+		m_pathIndex[GetPathIndexKey(metadata.filePath)] = metadata.handle;
+		m_stemIndex[metadata.filePath.stem().string()].emplace_back(metadata.handle);
+	}
+
+	void AssetManager::RemoveFromPathIndex(const AssetMetadata& metadata)
+	{
+		if (metadata.filePath.empty())
+		{
+			return;
+		}
+
+		// Another asset might have been registered with the same path afterwards
+		if (auto it = m_pathIndex.find(GetPathIndexKey(metadata.filePath)); it != m_pathIndex.end() && it->second == metadata.handle)
+		{
+			m_pathIndex.erase(it);
+		}
+
+		if (auto it = m_stemIndex.find(metadata.filePath.stem().string()); it != m_stemIndex.end())
+		{
+			auto& handles = it->second;
+			handles.erase(std::remove(handles.begin(), handles.end(), metadata.handle), handles.end());
+
+			if (handles.empty())
+			{
+				m_stemIndex.erase(it);
+			}
+		}
+	}
+
+	void AssetManager::SetAssetFilePath(AssetMetadata& metadata, const std::filesystem::path& filePath)
+	{
+		RemoveFromPathIndex(metadata);
+		metadata.filePath = filePath;
+		AddToPathIndex(metadata);
+	}
+
+	AssetMetadata* AssetManager::FindMetadataFromPathIndex(const std::filesystem::path& filePath)
+	{
+		auto it = m_pathIndex.find(GetPathIndexKey(filePath));
+		if (it == m_pathIndex.end())
+		{
+			return nullptr;
+		}
+
+		auto registryIt = m_assetRegistry.find(it->second);
+		if (registryIt == m_assetRegistry.end())
+		{
+			return nullptr;
+		}
+
+		return &registryIt->second;
+	}
+
 	Vector<std::filesystem::path> AssetManager::GetEngineAssetFiles()
 	{
 		Vector<std::filesystem::path> files;
@@ -0,0 +1,338 @@
+#include "aspch.h"
+#include "AssetStreamingScheduler.h"
+
+#include <JobSystem/JobSystem.h>
+
+#include <CoreUtilities/ThreadUtilities.h>
+#include <CoreUtilities/FileIO/BinaryStreamReader.h>
+
+namespace Volt
+{
+	AssetStreamingScheduler::AssetStreamingScheduler(const DeserializeFunction& deserializeFunction)
+		: m_deserializeFunction(deserializeFunction)
+	{
+		m_ioThread = std::thread(&AssetStreamingScheduler::IOThreadLoop, this);
+		Thread::SetThreadName(m_ioThread.native_handle(), "Volt::AssetIO");
+	}
+
+	AssetStreamingScheduler::~AssetStreamingScheduler()
+	{
+		{
+			std::scoped_lock lock{ m_mutex };
+			m_isRunning = false;
+		}
+
+		m_ioCondition.notify_all();
+		m_ioThread.join();
+
+		Vector<AssetHandle> activeHandles;
+		{
+			std::scoped_lock lock{ m_mutex };
+			for (const auto& [handle, request] : m_activeRequests)
+			{
+				activeHandles.emplace_back(handle);
+			}
+		}
+
+		for (const auto& handle : activeHandles)
+		{
+			if (!Cancel(handle))
+			{
+				Wait(handle);
+			}
+		}
+
+		// Jobs that lost their request to a waiting thread still reference the scheduler.
+		uint32_t outstandingJobCount = m_outstandingJobCount.load(std::memory_order_acquire);
+		while (outstandingJobCount > 0)
+		{
+			m_outstandingJobCount.wait(outstandingJobCount, std::memory_order_acquire);
+			outstandingJobCount = m_outstandingJobCount.load(std::memory_order_acquire);
+		}
+	}
+
+	void AssetStreamingScheduler::Enqueue(const AssetMetadata& metadata, const std::filesystem::path& filesystemPath, Ref<Asset> asset, AssetLoadPriority priority, std::span<const uint8_t> archivedFileData)
+	{
+		bool isNewRequest = false;
+
+		{
+			std::scoped_lock lock{ m_mutex };
+			if (!m_activeRequests.contains(metadata.handle))
+			{
+				Ref<Request> request = CreateRef<Request>();
+				request->metadata = metadata;
+				request->filesystemPath = filesystemPath;
+				request->asset = asset;
+				request->archivedFileData = archivedFileData;
+				request->priority = priority;
+
+				m_activeRequests[metadata.handle] = request;
+				PushQueueEntry(request, priority);
+
+				isNewRequest = true;
+			}
+		}
+
+		if (!isNewRequest)
+		{
+			RaisePriority(metadata.handle, priority);
+			return;
+		}
+
+		m_ioCondition.notify_one();
+	}
+
+	void AssetStreamingScheduler::RaisePriority(AssetHandle handle, AssetLoadPriority priority)
+	{
+		{
+			std::scoped_lock lock{ m_mutex };
+
+			auto it = m_activeRequests.find(handle);
+			if (it == m_activeRequests.end())
+			{
+				return;
+			}
+
+			const Ref<Request>& request = it->second;
+			if (request->state.load(std::memory_order_acquire) != RequestState::Queued || priority <= request->priority.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			request->priority = priority;
+			PushQueueEntry(request, priority);
+		}
+
+		m_ioCondition.notify_one();
+	}
+
+	bool AssetStreamingScheduler::Cancel(AssetHandle handle)
+	{
+		Ref<Request> request;
+
+		{
+			std::scoped_lock lock{ m_mutex };
+
+			auto it = m_activeRequests.find(handle);
+			if (it == m_activeRequests.end())
+			{
+				return false;
+			}
+
+			request = it->second;
+		}
+
+		RequestState expected = RequestState::Queued;
+		if (!request->state.compare_exchange_strong(expected, RequestState::Cancelled, std::memory_order_acq_rel))
+		{
+			// Reading and deserializing requests have to run to completion.
+			if (expected != RequestState::Read || !request->state.compare_exchange_strong(expected, RequestState::Cancelled, std::memory_order_acq_rel))
+			{
+				return false;
+			}
+
+			{
+				std::scoped_lock lock{ m_mutex };
+				m_bytesInFlight -= request->fileView.size();
+			}
+
+			request->fileView = {};
+			request->mappedFile.Close();
+			m_ioCondition.notify_one();
+		}
+
+		Complete(*request);
+		return true;
+	}
+
+	void AssetStreamingScheduler::Wait(AssetHandle handle)
+	{
+		Ref<Request> request;
+
+		{
+			std::scoped_lock lock{ m_mutex };
+
+			auto it = m_activeRequests.find(handle);
+			if (it == m_activeRequests.end())
+			{
+				return;
+			}
+
+			request = it->second;
+		}
+
+		// Do the work on this thread whenever nobody has picked it up yet, instead of blocking behind lower priority requests.
+		// The deserialization job of a request read by the I/O thread might be queued behind the calling thread, so it is not waited for either.
+		while (true)
+		{
+			TryReadFile(*request);
+			TryDeserialize(request);
+
+			std::unique_lock lock{ m_mutex };
+			m_progressCondition.wait(lock, [&request]()
+			{
+				return request->isCompleted.load(std::memory_order_acquire) || request->state.load(std::memory_order_acquire) == RequestState::Read;
+			});
+
+			if (request->isCompleted.load(std::memory_order_acquire))
+			{
+				return;
+			}
+		}
+	}
+
+	bool AssetStreamingScheduler::IsPending(AssetHandle handle) const
+	{
+		std::scoped_lock lock{ m_mutex };
+		return m_activeRequests.contains(handle);
+	}
+
+	void AssetStreamingScheduler::IOThreadLoop()
+	{
+		VT_PROFILE_THREAD("AssetIO");
+
+		while (true)
+		{
+			Ref<Request> request;
+
+			{
+				std::unique_lock lock{ m_mutex };
+				m_ioCondition.wait(lock, [this]()
+				{
+					return !m_isRunning || (!m_ioQueue.empty() && m_bytesInFlight < MAX_BYTES_IN_FLIGHT);
+				});
+
+				if (!m_isRunning)
+				{
+					return;
+				}
+
+				std::pop_heap(m_ioQueue.begin(), m_ioQueue.end());
+				QueueEntry entry = std::move(m_ioQueue.back());
+				m_ioQueue.pop_back();
+
+				// Entries left behind by a priority change are skipped, the request is read through its newest entry.
+				if (entry.priority != entry.request->priority.load(std::memory_order_relaxed))
+				{
+					continue;
+				}
+
+				request = std::move(entry.request);
+			}
+
+			if (!TryReadFile(*request))
+			{
+				continue;
+			}
+
+			m_outstandingJobCount.fetch_add(1, std::memory_order_relaxed);
+			JobSystem::CreateAndRunJob([this, request]()
+			{
+				TryDeserialize(request);
+
+				if (m_outstandingJobCount.fetch_sub(1, std::memory_order_release) == 1)
+				{
+					m_outstandingJobCount.notify_all();
+				}
+			});
+		}
+	}
+
+	bool AssetStreamingScheduler::TryReadFile(Request& request)
+	{
+		RequestState expected = RequestState::Queued;
+		if (!request.state.compare_exchange_strong(expected, RequestState::Reading, std::memory_order_acq_rel))
+		{
+			return false;
+		}
+
+		VT_PROFILE_FUNCTION();
+
+		if (!request.archivedFileData.empty())
+		{
+			request.fileView = request.archivedFileData;
+		}
+		else
+		{
+			// Missing files are left to the serializer, which flags the asset.
+			request.mappedFile = MappedFile{ request.filesystemPath };
+			if (request.mappedFile.IsValid())
+			{
+				request.fileView = { request.mappedFile.GetData(), request.mappedFile.GetSize() };
+			}
+		}
+
+		// The disk is only read here, the deserialization reads the pages that are already in memory.
+		MappedFile::PageIn(request.fileView);
+
+		// Changed under the lock, so that waiting threads can't miss it.
+		{
+			std::scoped_lock lock{ m_mutex };
+			m_bytesInFlight += request.fileView.size();
+			request.state.store(RequestState::Read, std::memory_order_release);
+		}
+
+		m_progressCondition.notify_all();
+		return true;
+	}
+
+	bool AssetStreamingScheduler::TryDeserialize(const Ref<Request>& request)
+	{
+		RequestState expected = RequestState::Read;
+		if (!request->state.compare_exchange_strong(expected, RequestState::Deserializing, std::memory_order_acq_rel))
+		{
+			return false;
+		}
+
+		VT_PROFILE_FUNCTION();
+
+		const size_t fileSize = request->fileView.size();
+		if (fileSize > 0)
+		{
+			PrefetchedFileScope prefetchedFile{ request->filesystemPath, request->fileView };
+			m_deserializeFunction(request->metadata, request->asset);
+		}
+		else
+		{
+			m_deserializeFunction(request->metadata, request->asset);
+		}
+
+		request->fileView = {};
+		request->mappedFile.Close();
+
+		{
+			std::scoped_lock lock{ m_mutex };
+			m_bytesInFlight -= fileSize;
+		}
+
+		m_ioCondition.notify_one();
+
+		request->state.store(RequestState::Finished, std::memory_order_release);
+		Complete(*request);
+
+		return true;
+	}
+
+	void AssetStreamingScheduler::PushQueueEntry(const Ref<Request>& request, AssetLoadPriority priority)
+	{
+		m_ioQueue.emplace_back(QueueEntry{ priority, m_nextSequence++, request });
+		std::push_heap(m_ioQueue.begin(), m_ioQueue.end());
+	}
+
+	void AssetStreamingScheduler::Complete(Request& request)
+	{
+		{
+			std::scoped_lock lock{ m_mutex };
+
+			auto it = m_activeRequests.find(request.metadata.handle);
+			if (it != m_activeRequests.end() && it->second.get() == &request)
+			{
+				m_activeRequests.erase(it);
+			}
+
+			request.isCompleted.store(true, std::memory_order_release);
+		}
+
+		m_progressCondition.notify_all();
+	}
+}
@@ -53,12 +53,16 @@ namespace Volt
 			return {};
 		}
 
+		auto jobData = CreateRef<ImportJobData>();
+		jobData->extension = extension;
+		jobData->importFunc = std::move(importFunc);
+
 		auto resultPromise = CreateRef<JobPromise<Vector<Ref<Asset>>>>();
-		JobID importJobId = JobSystem::CreateJob([this, extension, importFunc, resultPromise]()
+		JobID importJobId = JobSystem::CreateJob([this, jobData, resultPromise]()
 		{
 			VT_PROFILE_SCOPE("Import Asset Job");
 
-			auto result = importFunc();
+			auto result = jobData->importFunc();
 
 			for (const auto asset : result)
 			{
@@ -71,7 +75,7 @@ namespace Volt
 
 			resultPromise->SetValue(result);
 
-			*m_isImporterInUseMap[extension] = false;
+			*m_isImporterInUseMap[jobData->extension] = false;
 			m_wakeCondition.notify_one();
 		});
 
@@ -100,11 +104,16 @@ namespace Volt
 			return;
 		}
 
-		JobID importJobId = JobSystem::CreateJob([this, extension, importFunc, importedCallback]()
+		auto jobData = CreateRef<ImportJobData>();
+		jobData->extension = extension;
+		jobData->importFunc = std::move(importFunc);
+		jobData->importedCallback = importedCallback;
+
+		JobID importJobId = JobSystem::CreateJob([this, jobData]()
 		{
 			VT_PROFILE_SCOPE("Import Asset Job");
 
-			auto result = importFunc();
+			auto result = jobData->importFunc();
 
 			for (const auto asset : result)
 			{
@@ -115,12 +124,12 @@ namespace Volt
 				VT_LOGC(Trace, LogSourceAssetManager, "Asset {} was imported and saved to {}", asset->assetName, filePath);
 			}
 
-			*m_isImporterInUseMap[extension] = false;
+			*m_isImporterInUseMap[jobData->extension] = false;
 			m_wakeCondition.notify_one();
 
-			JobSystem::CreateAndRunJob(ExecutionPolicy::MainThread, [importedCallback, result]()
+			JobSystem::CreateAndRunJob(ExecutionPolicy::MainThread, [jobData, result]()
 			{
-				importedCallback(result);
+				jobData->importedCallback(result);
 			});
 		});
 
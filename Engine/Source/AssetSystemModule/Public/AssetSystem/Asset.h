@@ -34,6 +34,9 @@ namespace Volt
 		bool isQueued = false;
 		bool isMemoryAsset = false;
 
+		// Read from a mounted asset archive instead of the loose file
+		bool isArchived = false;
+
 		std::filesystem::path filePath;
 	};
 
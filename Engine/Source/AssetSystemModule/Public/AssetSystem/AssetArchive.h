@@ -0,0 +1,101 @@
+#pragma once
+
+#include "AssetSystem/Config.h"
+#include "AssetSystem/Asset.h"
+
+#include <CoreUtilities/Core.h>
+#include <CoreUtilities/VoltGUID.h>
+#include <CoreUtilities/Containers/Vector.h>
+#include <CoreUtilities/FileIO/MappedFile.h>
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace Volt
+{
+	struct AssetArchiveHeader
+	{
+		inline static constexpr uint32_t Magic = 0x4B505456; // VTPK
+		inline static constexpr uint32_t CurrentVersion = 1;
+
+		uint32_t magic;
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t padding;
+
+		uint64_t pathTableOffset;
+		uint64_t pathTableSize;
+	};
+
+	struct AssetArchiveEntry
+	{
+		uint64_t handle;
+		VoltGUID typeGuid;
+
+		// Relative to the start of the archive. The data is the asset file exactly as it is written to disk.
+		uint64_t dataOffset;
+		uint64_t dataSize;
+
+		// The clean relative file path, stored in the path table.
+		uint64_t pathHash;
+		uint32_t pathOffset;
+		uint32_t pathLength;
+	};
+
+	static_assert(sizeof(AssetArchiveHeader) == 32);
+	static_assert(sizeof(AssetArchiveEntry) == 56);
+
+	struct AssetArchiveSourceFile
+	{
+		AssetHandle handle;
+		AssetType type;
+
+		// Stored in the archive, and used as the asset's file path when the archive is mounted.
+		std::filesystem::path filePath;
+		std::filesystem::path filesystemPath;
+	};
+
+	// A cooked pack of asset files. The file is laid out as
+	// AssetArchiveHeader | AssetArchiveEntry[entryCount], sorted on handle | path table | asset data.
+	// The whole archive is mapped, so mounting it only touches the table, and asset data is paged in when it is read.
+	class VTAS_API AssetArchive
+	{
+	public:
+		inline static constexpr std::string_view Extension = ".vtpak";
+
+		AssetArchive(const std::filesystem::path& archivePath);
+		~AssetArchive() = default;
+
+		VT_DELETE_COPY_MOVE(AssetArchive);
+
+		VT_NODISCARD VT_INLINE bool IsValid() const { return m_isValid; }
+		VT_NODISCARD VT_INLINE const std::filesystem::path& GetPath() const { return m_archivePath; }
+		VT_NODISCARD VT_INLINE std::filesystem::file_time_type GetWriteTime() const { return m_writeTime; }
+		VT_NODISCARD VT_INLINE const Vector<AssetArchiveEntry>& GetEntries() const { return m_entries; }
+
+		VT_NODISCARD const AssetArchiveEntry* FindEntry(AssetHandle handle) const;
+		VT_NODISCARD const AssetArchiveEntry* FindEntry(std::string_view filePath) const;
+
+		// The view is valid for as long as the archive is alive.
+		VT_NODISCARD std::span<const uint8_t> GetAssetData(const AssetArchiveEntry& entry) const;
+		VT_NODISCARD std::string_view GetAssetFilePath(const AssetArchiveEntry& entry) const;
+
+		// The file paths are expected to be clean relative paths, as stored in the asset registry.
+		static bool Write(const std::filesystem::path& archivePath, const Vector<AssetArchiveSourceFile>& sourceFiles);
+		static uint64_t GetPathHash(std::string_view filePath);
+
+	private:
+		std::filesystem::path m_archivePath;
+		std::filesystem::file_time_type m_writeTime;
+		MappedFile m_mappedFile;
+
+		Vector<AssetArchiveEntry> m_entries;
+		std::string_view m_pathTable;
+
+		// Indices into m_entries, sorted on path hash
+		Vector<uint32_t> m_pathHashOrder;
+
+		bool m_isValid = false;
+	};
+}
@@ -36,7 +36,6 @@ namespace Volt
 
 		void OnAssetChanged(AssetHandle handle, AssetChangedState state);
 
-		const Vector<AssetHandle> GetAssetDependencyChain(AssetHandle handle) const;
 		const Vector<AssetHandle> GetAssetsDependentOn(AssetHandle handle) const;
 
 		inline const bool DoAssetExistInGraph(AssetHandle handle) const { return m_assetNodeIds.contains(handle); }
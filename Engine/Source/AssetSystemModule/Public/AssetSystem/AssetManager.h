@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AssetSystem/Asset.h"
+#include "AssetSystem/AssetStreamingScheduler.h"
 
 #include <LogModule/Log.h>
 
@@ -21,6 +22,7 @@ namespace Volt
 	class AssetFactory;
 	class AssetSerializer;
 	class AssetDependencyGraph;
+	class AssetArchive;
 
 	class VTAS_API AssetManager
 	{
@@ -63,7 +65,7 @@ namespace Volt
 		void ReloadAsset(const std::filesystem::path& path);
 
 		Ref<Asset> GetAssetRaw(AssetHandle assetHandle);
-		Ref<Asset> QueueAssetRaw(AssetHandle assetHandle);
+		Ref<Asset> QueueAssetRaw(AssetHandle assetHandle, AssetLoadPriority priority = AssetLoadPriority::Normal);
 
 		static void Update();
 
@@ -83,6 +85,9 @@ namespace Volt
 		static void SaveAsset(Ref<Asset> asset);
 		static void SaveAssetAs(Ref<Asset> asset, const std::filesystem::path& targetFilePath);
 
+		// Packs the loose files of the assets into an archive, which is mounted instead of crawling the directory when placed in the project or engine directory.
+		static bool CookAssetArchive(const std::filesystem::path& archivePath, const Vector<AssetHandle>& handles);
+
 		static const std::filesystem::path GetFilesystemPath(AssetHandle handle);
 		static const std::filesystem::path GetFilesystemPath(const std::filesystem::path& path);
 		static const std::filesystem::path GetRelativePath(const std::filesystem::path& path);
@@ -116,8 +121,13 @@ namespace Volt
 		template<typename T>
 		static Ref<T> GetAssetLocking(const std::filesystem::path& path);
 
+		// Queuing an asset which is already streaming raises its priority.
 		template<typename T>
-		static Ref<T> QueueAsset(AssetHandle handle);
+		static Ref<T> QueueAsset(AssetHandle handle, AssetLoadPriority priority = AssetLoadPriority::Normal);
+
+		// Drops a queued asset that is no longer needed, unless its deserialization has already started.
+		// The queued asset is flagged as invalid. Returns true if the asset was cancelled.
+		static bool CancelQueuedAsset(AssetHandle handle);
 
 		template<typename T, typename... Args>
 		static Ref<T> CreateAsset(const std::filesystem::path& targetDir, const std::string& name, Args&&... args);
@@ -159,16 +169,30 @@ namespace Volt
 		void LoadAllAssetMetadata();
 		void DeserializeAssetMetadata(std::filesystem::path assetPath);
 
+		// Archives are mounted in path order, later archives take precedence over earlier ones
+		void MountAssetArchives(const std::filesystem::path& directory);
+		const AssetArchive* GetArchiveForAsset(AssetHandle handle) const;
+		const AssetArchive* GetArchiveForFilePath(const std::filesystem::path& filePath) const;
+		std::span<const uint8_t> GetArchivedAssetData(AssetHandle handle) const;
+
 		void OnAssetChanged(AssetHandle assetHandle, AssetChangedState state);
 		void QueueAssetChanged(AssetHandle assetHandle, AssetChangedState state);
 
-		void QueueAssetInternal(AssetHandle assetHandle, Ref<Asset>& asset);
+		void QueueAssetInternal(AssetHandle assetHandle, Ref<Asset>& asset, AssetLoadPriority priority);
+		void DeserializeQueuedAsset(const AssetMetadata& metadata, Ref<Asset> asset);
 
 		static bool ValidateAssetType(AssetHandle handle, Ref<Asset> asset);
 		static AssetMetadata& GetMetadataFromHandleMutable(AssetHandle handle);
 		static AssetMetadata& GetMetadataFromFilePathMutable(const std::filesystem::path filePath);
 
 		static const std::filesystem::path GetCleanAssetFilePath(const std::filesystem::path& path);
+
+		// The path indices must only be modified while holding the registry write lock
+		static std::string GetPathIndexKey(const std::filesystem::path& path);
+		void AddToPathIndex(const AssetMetadata& metadata);
+		void RemoveFromPathIndex(const AssetMetadata& metadata);
+		void SetAssetFilePath(AssetMetadata& metadata, const std::filesystem::path& filePath);
+		AssetMetadata* FindMetadataFromPathIndex(const std::filesystem::path& filePath);
 		
 		Vector<std::filesystem::path> GetEngineAssetFiles();
 		Vector<std::filesystem::path> GetProjectAssetFiles();
@@ -177,6 +201,10 @@ namespace Volt
 		AssetCache m_memoryAssets;
 		AssetRegistry m_assetRegistry;
 
+		// Secondary indices into the registry, keyed by the clean file path and by the file stem
+		vt::map<std::string, AssetHandle> m_pathIndex;
+		vt::map<std::string, Vector<AssetHandle>> m_stemIndex;
+
 		std::filesystem::path m_projectDirectory;
 		std::filesystem::path m_assetsDirectory;
 		std::filesystem::path m_engineDirectory;
@@ -185,6 +213,10 @@ namespace Volt
 		Vector<AssetChangedQueueInfo> m_assetChangedQueue;
 		std::mutex m_assetChangedQueueMutex;
 		Scope<AssetDependencyGraph> m_dependencyGraph;
+		Scope<AssetStreamingScheduler> m_streamingScheduler;
+
+		// Later archives take precedence over earlier ones
+		Vector<Scope<AssetArchive>> m_archives;
 
 		std::mutex m_assetCallbackMutex;
 		mutable std::shared_mutex m_assetRegistryMutex;
@@ -244,15 +276,14 @@ namespace Volt
 			}
 		}
 
-		Ref<Asset> asset = QueueAsset<T>(assetHandle);
+		Ref<Asset> asset = QueueAsset<T>(assetHandle, AssetLoadPriority::Critical);
 
 		if (!asset)
 		{
 			return nullptr;
 		}
 
-		while (!asset->IsValid())
-		{}
+		Get().m_streamingScheduler->Wait(assetHandle);
 		return std::reinterpret_pointer_cast<T>(asset);
 	}
 
@@ -263,7 +294,7 @@ namespace Volt
 	}
 
 	template<typename T>
-	inline Ref<T> AssetManager::QueueAsset(AssetHandle handle)
+	inline Ref<T> AssetManager::QueueAsset(AssetHandle handle, AssetLoadPriority priority)
 	{
 		if (handle == Asset::Null())
 		{
@@ -286,10 +317,11 @@ namespace Volt
 			return std::reinterpret_pointer_cast<T>(Get().m_memoryAssets.at(handle));
 		}
 
-		// If it's already loaded, return it
+		// If it's already loaded or queued, return it
 		{
 			if (IsLoaded(handle))
 			{
+				Get().m_streamingScheduler->RaisePriority(handle, priority);
 				return GetAsset<T>(handle);
 			}
 		}
@@ -302,7 +334,7 @@ namespace Volt
 		}
 
 		asset->SetFlag(AssetFlag::Queued, true);
-		Get().QueueAssetInternal(handle, asset);
+		Get().QueueAssetInternal(handle, asset, priority);
 
 		return std::reinterpret_pointer_cast<T>(asset);
 	}
@@ -331,6 +363,7 @@ namespace Volt
 		asset->assetName = cleanName;
 
 		AssetManager::Get().m_assetRegistry.emplace(asset->handle, metadata);
+		AssetManager::Get().AddToPathIndex(metadata);
 		AssetManager::Get().m_assetCache.emplace(asset->handle, asset);
 
 		return asset;
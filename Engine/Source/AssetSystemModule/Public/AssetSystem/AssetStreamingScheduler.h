@@ -0,0 +1,126 @@
+#pragma once
+
+#include "AssetSystem/Config.h"
+#include "AssetSystem/Asset.h"
+
+#include <CoreUtilities/Core.h>
+#include <CoreUtilities/Containers/Vector.h>
+#include <CoreUtilities/Containers/Map.h>
+#include <CoreUtilities/FileIO/MappedFile.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+
+namespace Volt
+{
+	enum class AssetLoadPriority : uint8_t
+	{
+		Low = 0,
+		Normal,
+		High,
+		Critical
+	};
+
+	// Streams queued assets in two stages. A dedicated I/O thread maps the files in priority order and reads their pages into memory,
+	// and the decompression and deserialization straight from the mapping happens in jobs on the job system.
+	// The amount of read but not yet deserialized file data is bounded, so the I/O thread can't run away from the workers.
+	class VTAS_API AssetStreamingScheduler
+	{
+	public:
+		using DeserializeFunction = std::function<void(const AssetMetadata& metadata, Ref<Asset> asset)>;
+
+		AssetStreamingScheduler(const DeserializeFunction& deserializeFunction);
+		~AssetStreamingScheduler();
+
+		VT_DELETE_COPY_MOVE(AssetStreamingScheduler);
+
+		// Archived assets are read from archivedFileData instead of from the file, which has to stay alive until the request is finished.
+		void Enqueue(const AssetMetadata& metadata, const std::filesystem::path& filesystemPath, Ref<Asset> asset, AssetLoadPriority priority, std::span<const uint8_t> archivedFileData = {});
+
+		// Only raises the priority of requests that have not been read yet.
+		void RaisePriority(AssetHandle handle, AssetLoadPriority priority);
+
+		// Requests can be cancelled until their deserialization has started. Returns true if the request was cancelled.
+		bool Cancel(AssetHandle handle);
+
+		// Blocks until the request is finished or cancelled. Work that has not been picked up yet is done on the calling thread instead of waiting for it.
+		void Wait(AssetHandle handle);
+
+		VT_NODISCARD bool IsPending(AssetHandle handle) const;
+
+	private:
+		inline static constexpr size_t MAX_BYTES_IN_FLIGHT = 256ull * 1024ull * 1024ull;
+
+		enum class RequestState : uint8_t
+		{
+			Queued,
+			Reading,
+			Read,
+			Deserializing,
+			Finished,
+			Cancelled
+		};
+
+		struct Request
+		{
+			AssetMetadata metadata;
+			std::filesystem::path filesystemPath;
+			Ref<Asset> asset;
+
+			// Points into either the archive or the mapped file, and is handed to the serializer without being copied.
+			MappedFile mappedFile;
+			std::span<const uint8_t> fileView;
+			std::span<const uint8_t> archivedFileData;
+
+			std::atomic<RequestState> state = RequestState::Queued;
+			std::atomic<AssetLoadPriority> priority = AssetLoadPriority::Normal;
+			std::atomic_bool isCompleted = false;
+		};
+
+		struct QueueEntry
+		{
+			AssetLoadPriority priority;
+			uint64_t sequence;
+			Ref<Request> request;
+
+			VT_INLINE bool operator<(const QueueEntry& other) const
+			{
+				// Older requests first within the same priority.
+				return priority < other.priority || (priority == other.priority && sequence > other.sequence);
+			}
+		};
+
+		void IOThreadLoop();
+
+		// Both return false if another thread has already claimed the stage.
+		bool TryReadFile(Request& request);
+		bool TryDeserialize(const Ref<Request>& request);
+
+		void PushQueueEntry(const Ref<Request>& request, AssetLoadPriority priority);
+		void Complete(Request& request);
+
+		DeserializeFunction m_deserializeFunction;
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_ioCondition;
+
+		// Notified when a request has been read or completed, which is when waiting threads can pick up the next stage.
+		std::condition_variable m_progressCondition;
+
+		// Max heap on priority, then on the order of requests. Raising the priority of a request pushes another entry, the stale one is skipped.
+		Vector<QueueEntry> m_ioQueue;
+		vt::map<AssetHandle, Ref<Request>> m_activeRequests;
+
+		uint64_t m_nextSequence = 0;
+		size_t m_bytesInFlight = 0;
+		bool m_isRunning = true;
+
+		std::atomic_uint32_t m_outstandingJobCount = 0;
+
+		std::thread m_ioThread;
+	};
+}
@@ -61,6 +61,14 @@ namespace Volt
 	private:
 		using ImportJobFunc = std::function<Vector<Ref<Asset>>()>;
 
+		// Shared between the import job and its continuation, keeps the job captures within the inline job storage.
+		struct ImportJobData
+		{
+			std::string extension;
+			ImportJobFunc importFunc;
+			ImportedCallbackFunc importedCallback;
+		};
+
 		struct ImportJob
 		{
 			JobID jobId;
@@ -1,5 +1,6 @@
 #include "cupch.h"
 #include "FileIO/BinaryStreamReader.h"
+#include "FileIO/BlockCompression.h"
 
 #include "zlib.h"
 
@@ -11,43 +12,115 @@ constexpr size_t COMPRESSION_ENCODING_HEADER_SIZE = sizeof(uint32_t) + sizeof(ui
 constexpr uint32_t COMPRESSED_CHUNK_SIZE = 16384;
 constexpr uint32_t MAGIC = 5121;
 
+namespace Utility
+{
+	static thread_local PrefetchedFileScope* s_currentPrefetchedFileScope = nullptr;
+}
+
+PrefetchedFileScope::PrefetchedFileScope(const std::filesystem::path& filePath, Vector<uint8_t>&& fileData)
+	: m_filePath(filePath), m_fileData(std::move(fileData)), m_previousScope(Utility::s_currentPrefetchedFileScope)
+{
+	Utility::s_currentPrefetchedFileScope = this;
+}
+
+PrefetchedFileScope::PrefetchedFileScope(const std::filesystem::path& filePath, std::span<const uint8_t> fileView)
+	: m_filePath(filePath), m_fileView(fileView), m_previousScope(Utility::s_currentPrefetchedFileScope)
+{
+	Utility::s_currentPrefetchedFileScope = this;
+}
+
+PrefetchedFileScope::~PrefetchedFileScope()
+{
+	Utility::s_currentPrefetchedFileScope = m_previousScope;
+}
+
+bool PrefetchedFileScope::TryTakeFileData(const std::filesystem::path& filePath, Vector<uint8_t>& outData, std::span<const uint8_t>& outView)
+{
+	for (PrefetchedFileScope* scope = Utility::s_currentPrefetchedFileScope; scope; scope = scope->m_previousScope)
+	{
+		if (scope->m_hasData && scope->m_filePath == filePath)
+		{
+			if (scope->m_fileView.empty())
+			{
+				outData = std::move(scope->m_fileData);
+			}
+			else
+			{
+				outView = scope->m_fileView;
+			}
+
+			scope->m_hasData = false;
+			return true;
+		}
+	}
+
+	return false;
+}
+
 BinaryStreamReader::BinaryStreamReader(const std::filesystem::path& filePath)
+	: BinaryStreamReader(filePath, StreamReadMode::Buffered)
 {
-	std::ifstream stream(filePath, std::ios::in | std::ios::binary);
-	if (stream)
+}
+
+BinaryStreamReader::BinaryStreamReader(const std::filesystem::path& filePath, StreamReadMode readMode)
+{
+	std::span<const uint8_t> prefetchedView{};
+	if (PrefetchedFileScope::TryTakeFileData(filePath, m_data, prefetchedView))
+	{
+		if (prefetchedView.empty())
+		{
+			SetDataFromBuffer();
+		}
+		else
+		{
+			m_dataPtr = prefetchedView.data();
+			m_dataSize = prefetchedView.size();
+		}
+	}
+	else if (readMode == StreamReadMode::MemoryMapped && (m_mappedFile = MappedFile{ filePath }).IsValid())
+	{
+		m_dataPtr = m_mappedFile.GetData();
+		m_dataSize = m_mappedFile.GetSize();
+	}
+	else
 	{
+		std::ifstream stream(filePath, std::ios::in | std::ios::binary);
+		if (!stream)
+		{
+			return;
+		}
+
 		stream.seekg(0, std::ios::end);
 		m_data.resize_uninitialized(stream.tellg());
 		stream.seekg(0, std::ios::beg);
 		stream.read(reinterpret_cast<char*>(m_data.data()), m_data.size());
 
-		m_streamValid = true;
-	}
-	else
-	{
-		return;
+		SetDataFromBuffer();
 	}
 
-	if (m_data.size() < COMPRESSION_ENCODING_HEADER_SIZE)
+	m_streamValid = true;
+
+	if (m_dataSize < COMPRESSION_ENCODING_HEADER_SIZE)
 	{
 		m_streamValid = false;
 		return;
 	}
 
 	// Read compression encoding
-	const uint32_t magic = *(uint32_t*)m_data.data();
+	const uint32_t magic = *reinterpret_cast<const uint32_t*>(m_dataPtr);
 	if (magic != MAGIC)
 	{
 		m_streamValid = false;
 		return;
 	}
 
-	const uint8_t isCompressed = m_data[sizeof(uint32_t)];
-	const size_t compressedDataOffset = *reinterpret_cast<size_t*>(&m_data[sizeof(uint32_t) + sizeof(uint8_t)]) + COMPRESSION_ENCODING_HEADER_SIZE;
+	const StreamCompressionEncoding encoding = static_cast<StreamCompressionEncoding>(m_dataPtr[sizeof(uint32_t)]);
+	const size_t compressedDataOffset = *reinterpret_cast<const size_t*>(&m_dataPtr[sizeof(uint32_t) + sizeof(uint8_t)]) + COMPRESSION_ENCODING_HEADER_SIZE;
 
+	const bool isCompressed = encoding != StreamCompressionEncoding::None;
 	if (isCompressed)
 	{
-		if (!Decompress(compressedDataOffset))
+		if (!Decompress(compressedDataOffset, encoding))
 		{
 			m_streamValid = false;
 		}
@@ -76,6 +149,7 @@ BinaryStreamReader::BinaryStreamReader(const std::filesystem::path& filePath, co
 		m_data.resize_uninitialized(bytesToLoadCount);
 		stream.read(reinterpret_cast<char*>(m_data.data()), m_data.size());
 
+		SetDataFromBuffer();
 		m_streamValid = true;
 	}
 	else
@@ -83,26 +157,27 @@ BinaryStreamReader::BinaryStreamReader(const std::filesystem::path& filePath, co
 		return;
 	}
 
-	if (m_data.size() < COMPRESSION_ENCODING_HEADER_SIZE)
+	if (m_dataSize < COMPRESSION_ENCODING_HEADER_SIZE)
 	{
 		m_streamValid = false;
 		return;
 	}
 
 	// Read compression encoding
-	const uint32_t magic = *(uint32_t*)m_data.data();
+	const uint32_t magic = *reinterpret_cast<const uint32_t*>(m_dataPtr);
 	if (magic != MAGIC)
 	{
 		m_streamValid = false;
 		return;
 	}
 
-	const size_t compressedDataOffset = *reinterpret_cast<size_t*>(&m_data[sizeof(uint32_t) + sizeof(uint8_t)]) + COMPRESSION_ENCODING_HEADER_SIZE;
-	const bool isCompressed = bool(m_data[sizeof(uint32_t)]) && m_data.size() > compressedDataOffset;
+	const StreamCompressionEncoding encoding = static_cast<StreamCompressionEncoding>(m_dataPtr[sizeof(uint32_t)]);
+	const size_t compressedDataOffset = *reinterpret_cast<const size_t*>(&m_dataPtr[sizeof(uint32_t) + sizeof(uint8_t)]) + COMPRESSION_ENCODING_HEADER_SIZE;
+	const bool isCompressed = encoding != StreamCompressionEncoding::None && m_dataSize > compressedDataOffset;
 
 	if (isCompressed)
 	{
-		if (!Decompress(compressedDataOffset))
+		if (!Decompress(compressedDataOffset, encoding))
 		{
 			m_streamValid = false;
 		}
@@ -120,11 +195,64 @@ void BinaryStreamReader::ReadData(void* outData, const TypeHeader& serializedTyp
 {
 	VT_UNUSED(constructedTypeHeader);
 
-	memcpy_s(outData, serializedTypeHeader.totalTypeSize, &m_data[m_currentOffset], serializedTypeHeader.totalTypeSize);
+	memcpy_s(outData, serializedTypeHeader.totalTypeSize, &m_dataPtr[m_currentOffset], serializedTypeHeader.totalTypeSize);
 	m_currentOffset += serializedTypeHeader.totalTypeSize;
 }
 
-bool BinaryStreamReader::Decompress(size_t compressedDataOffset)
+void BinaryStreamReader::SetDataFromBuffer()
+{
+	m_dataPtr = m_data.data();
+	m_dataSize = m_data.size();
+}
+
+bool BinaryStreamReader::Decompress(size_t compressedDataOffset, StreamCompressionEncoding encoding)
+{
+	if (compressedDataOffset > m_dataSize)
+	{
+		return false;
+	}
+
+	if (encoding == StreamCompressionEncoding::Blocks)
+	{
+		return DecompressBlocks(compressedDataOffset);
+	}
+
+	return DecompressDeflateStream(compressedDataOffset);
+}
+
+bool BinaryStreamReader::DecompressBlocks(size_t compressedDataOffset)
+{
+	const uint8_t* payload = &m_dataPtr[compressedDataOffset];
+	const size_t payloadSize = m_dataSize - compressedDataOffset;
+
+	BlockCompression::BlockTableHeader blockTableHeader{};
+	if (!BlockCompression::ReadBlockTable(payload, payloadSize, blockTableHeader))
+	{
+		return false;
+	}
+
+	// The uncompressed data in front of the compressed data is kept, without the compression encoding header.
+	const size_t uncompressedPrefixSize = compressedDataOffset - COMPRESSION_ENCODING_HEADER_SIZE;
+
+	Vector<uint8_t> result{};
+	result.resize_uninitialized(uncompressedPrefixSize + blockTableHeader.uncompressedSize);
+	memcpy_s(result.data(), uncompressedPrefixSize, &m_dataPtr[COMPRESSION_ENCODING_HEADER_SIZE], uncompressedPrefixSize);
+
+	if (!BlockCompression::Decompress(payload, payloadSize, result.data() + uncompressedPrefixSize))
+	{
+		return false;
+	}
+
+	m_data = std::move(result);
+	SetDataFromBuffer();
+
+	// The mapping is not needed once everything has been decompressed.
+	m_mappedFile.Close();
+
+	return true;
+}
+
+bool BinaryStreamReader::DecompressDeflateStream(size_t compressedDataOffset)
 {
 	z_stream stream;
 	stream.zalloc = Z_NULL;
@@ -141,27 +269,32 @@ bool BinaryStreamReader::Decompress(size_t compressedDataOffset)
 
 	uint32_t srcOffset = static_cast<uint32_t>(compressedDataOffset);
 
-	Vector<uint8_t> tempResult{};
+	// The uncompressed data in front of the compressed data is kept, without the compression encoding header.
+	// Inflating straight into the result means the source can be the mapped file, which is never copied.
+	const size_t uncompressedPrefixSize = compressedDataOffset - COMPRESSION_ENCODING_HEADER_SIZE;
+
+	Vector<uint8_t> result{};
+	result.resize_uninitialized(uncompressedPrefixSize);
+	memcpy_s(result.data(), uncompressedPrefixSize, &m_dataPtr[COMPRESSION_ENCODING_HEADER_SIZE], uncompressedPrefixSize);
 
 	do
 	{
-		stream.avail_in = std::min(COMPRESSED_CHUNK_SIZE, static_cast<uint32_t>(m_data.size()) - srcOffset);
+		stream.avail_in = std::min(COMPRESSED_CHUNK_SIZE, static_cast<uint32_t>(m_dataSize) - srcOffset);
 		if (stream.avail_in == 0)
 		{
 			break;
 		}
 
-		uint8_t* bytePtr = &m_data[srcOffset];
+		stream.next_in = const_cast<Bytef*>(&m_dataPtr[srcOffset]);
 		srcOffset += stream.avail_in;
-		stream.next_in = bytePtr;
 
 		do
 		{
-			size_t dstOffset = tempResult.size();
-			tempResult.resize_uninitialized(tempResult.size() + COMPRESSED_CHUNK_SIZE);
+			size_t dstOffset = result.size();
+			result.resize_uninitialized(result.size() + COMPRESSED_CHUNK_SIZE);
 
 			stream.avail_out = COMPRESSED_CHUNK_SIZE;
-			stream.next_out = &tempResult[dstOffset];
+			stream.next_out = &result[dstOffset];
 
 			zLibResult = inflate(&stream, Z_NO_FLUSH);
 			assert(zLibResult != Z_STREAM_ERROR);
@@ -181,7 +314,7 @@ bool BinaryStreamReader::Decompress(size_t compressedDataOffset)
 			}
 
 			uint32_t actualOutSize = COMPRESSED_CHUNK_SIZE - stream.avail_out;
-			tempResult.resize_uninitialized(dstOffset + actualOutSize);
+			result.resize_uninitialized(dstOffset + actualOutSize);
 
 		}
 		while (stream.avail_out == 0);
@@ -193,10 +326,11 @@ bool BinaryStreamReader::Decompress(size_t compressedDataOffset)
 
 	if (zLibResult == Z_STREAM_END)
 	{
-		m_data.erase(m_data.begin(), m_data.begin() + COMPRESSION_ENCODING_HEADER_SIZE);
+		m_data = std::move(result);
+		SetDataFromBuffer();
 
-		m_data.resize_uninitialized(compressedDataOffset + tempResult.size() - COMPRESSION_ENCODING_HEADER_SIZE);
-		memcpy_s(&m_data[compressedDataOffset - COMPRESSION_ENCODING_HEADER_SIZE], tempResult.size(), tempResult.data(), tempResult.size());
+		// The mapping is not needed once everything has been inflated.
+		m_mappedFile.Close();
 	}
 
 	return zLibResult == Z_STREAM_END;
@@ -223,7 +357,7 @@ TypeHeader BinaryStreamReader::ReadTypeHeader()
 {
 	constexpr size_t typeHeaderSize = sizeof(TypeHeader);
 
-	TypeHeader result = *reinterpret_cast<TypeHeader*>(&m_data[m_currentOffset]);
+	TypeHeader result = *reinterpret_cast<const TypeHeader*>(&m_dataPtr[m_currentOffset]);
 	m_currentOffset += typeHeaderSize;
 	return result;
 }
@@ -1,111 +1,57 @@
 #include "cupch.h"
 #include "FileIO/BinaryStreamWriter.h"
 
-#include "zlib.h"
-
-void BinaryStreamWriter::WriteToDisk(const std::filesystem::path& targetFilepath, bool compress, size_t compressedDataOffset)
+namespace Utility
 {
-	constexpr size_t compressionEncodingHeaderSize = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(size_t);
+	constexpr size_t COMPRESSION_ENCODING_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(size_t);
 	constexpr uint32_t MAGIC = 5121;
+}
 
-	std::ofstream stream(targetFilepath, std::ios::out | std::ios::binary);
-
-	const uint8_t* writePtr = m_data.data();
-	size_t size = m_data.size();
-
-	Vector<uint8_t> compressedData;
+void BinaryStreamWriter::WriteToDisk(const std::filesystem::path& targetFilepath, bool compress, size_t compressedDataOffset)
+{
 	if (compress)
 	{
-		compressedData.resize_uninitialized(compressionEncodingHeaderSize);
-
-		*(uint32_t*)(compressedData.data()) = MAGIC; // First we set a magic value
-		compressedData[sizeof(uint32_t)] = 1; // First byte tells if file is compressed
-
-		// Next 8 bytes tells the offset to where the compressed data starts
-		memcpy_s(&compressedData[sizeof(uint32_t) + sizeof(uint8_t)], sizeof(size_t), &compressedDataOffset, sizeof(size_t));
-
-		compressedDataOffset += compressionEncodingHeaderSize;
-
-		compressedData.resize_uninitialized(compressedDataOffset);
-		if (GetCompressed(compressedData, compressedDataOffset))
-		{
-			memcpy_s(&compressedData[compressionEncodingHeaderSize], compressedDataOffset - compressionEncodingHeaderSize, m_data.data(), compressedDataOffset - compressionEncodingHeaderSize);
-
-			writePtr = compressedData.data();
-			size = compressedData.size();
-		}
+		WriteToDisk(targetFilepath, CompressionCodec::DeflateDefault, compressedDataOffset);
+		return;
 	}
 
-	if (writePtr == m_data.data())
-	{
-		// Insert 0 at beginning to flag that file is uncompressed
-		// We also insert the magic value
-		std::array<uint8_t, compressionEncodingHeaderSize> emptyEncodingHeader;
-		emptyEncodingHeader.fill(0);
+	std::ofstream stream(targetFilepath, std::ios::out | std::ios::binary);
 
-		*(uint32_t*)(emptyEncodingHeader.data()) = MAGIC;
+	// Insert 0 at beginning to flag that file is uncompressed
+	// We also insert the magic value
+	std::array<uint8_t, Utility::COMPRESSION_ENCODING_HEADER_SIZE> emptyEncodingHeader;
+	emptyEncodingHeader.fill(0);
 
-		m_data.insert(m_data.begin(), emptyEncodingHeader.begin(), emptyEncodingHeader.end());
-		writePtr = m_data.data();
-		size = m_data.size();
-	}
+	*(uint32_t*)(emptyEncodingHeader.data()) = Utility::MAGIC;
+
+	m_data.insert(m_data.begin(), emptyEncodingHeader.begin(), emptyEncodingHeader.end());
 
-	stream.write(reinterpret_cast<const char*>(writePtr), size);
+	stream.write(reinterpret_cast<const char*>(m_data.data()), m_data.size());
 	stream.close();
 }
 
-bool BinaryStreamWriter::GetCompressed(Vector<uint8_t>& result, size_t compressedDataOffset)
+void BinaryStreamWriter::WriteToDisk(const std::filesystem::path& targetFilepath, CompressionCodec codec, size_t compressedDataOffset)
 {
-	constexpr uint32_t CHUNK_SIZE = 16384;
-	constexpr size_t compressionEncodingHeaderSize = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(size_t);
+	std::ofstream stream(targetFilepath, std::ios::out | std::ios::binary);
 
-	z_stream stream;
-	stream.zalloc = Z_NULL;
-	stream.zfree = Z_NULL;
-	stream.opaque = Z_NULL;
+	Vector<uint8_t> compressedData;
+	compressedData.resize_uninitialized(Utility::COMPRESSION_ENCODING_HEADER_SIZE + compressedDataOffset);
 
-	int32_t zLibResult = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
-	if (zLibResult != Z_OK)
-	{
-		return false;
-	}
+	*(uint32_t*)(compressedData.data()) = Utility::MAGIC; // First we set a magic value
+	compressedData[sizeof(uint32_t)] = static_cast<uint8_t>(StreamCompressionEncoding::Blocks); // First byte tells how the file is compressed
 
-	int32_t shouldFlush;
-	uint32_t srcOffset = static_cast<uint32_t>(compressedDataOffset - compressionEncodingHeaderSize);
+	// Next 8 bytes tells the offset to where the compressed data starts
+	memcpy_s(&compressedData[sizeof(uint32_t) + sizeof(uint8_t)], sizeof(size_t), &compressedDataOffset, sizeof(size_t));
 
-	do
+	if (compressedDataOffset > 0)
 	{
-		stream.avail_in = std::min(CHUNK_SIZE, static_cast<uint32_t>(m_data.size()) - srcOffset);
-		uint8_t* bytePtr = &m_data[srcOffset];
-		srcOffset += stream.avail_in;
-
-		shouldFlush = srcOffset == m_data.size() ? Z_FINISH : Z_NO_FLUSH;
-		stream.next_in = bytePtr;
-
-		do
-		{
-			size_t dstOffset = result.size();
-			result.resize_uninitialized(result.size() + CHUNK_SIZE);
-
-			stream.avail_out = CHUNK_SIZE;
-			stream.next_out = &result[dstOffset];
-
-			zLibResult = deflate(&stream, shouldFlush);
-			assert(zLibResult != Z_STREAM_ERROR);
-
-			uint32_t actualOutSize = CHUNK_SIZE - stream.avail_out;
-			result.resize_uninitialized(dstOffset + actualOutSize);
-
-		}
-		while (stream.avail_out == 0);
-		assert(stream.avail_in == 0);
-
+		memcpy_s(&compressedData[Utility::COMPRESSION_ENCODING_HEADER_SIZE], compressedDataOffset, m_data.data(), compressedDataOffset);
 	}
-	while (shouldFlush != Z_FINISH);
-	assert(zLibResult == Z_STREAM_END);
 
-	deflateEnd(&stream);
-	return true;
+	BlockCompression::Compress(m_data.data() + compressedDataOffset, m_data.size() - compressedDataOffset, codec, compressedData);
+
+	stream.write(reinterpret_cast<const char*>(compressedData.data()), compressedData.size());
+	stream.close();
 }
 
 void BinaryStreamWriter::WriteTypeHeader(const TypeHeader& typeHeader)
@@ -0,0 +1,200 @@
+#include "cupch.h"
+#include "FileIO/BlockCompression.h"
+
+#include "CoreUtilities/ThreadUtilities.h"
+
+#include "zlib.h"
+
+namespace BlockCompression
+{
+	namespace Utility
+	{
+		VT_INLINE int32_t GetCompressionLevel(CompressionCodec codec)
+		{
+			switch (codec)
+			{
+				case CompressionCodec::DeflateFast: return Z_BEST_SPEED;
+				case CompressionCodec::DeflateHigh: return Z_BEST_COMPRESSION;
+				case CompressionCodec::DeflateDefault: return Z_DEFAULT_COMPRESSION;
+			}
+
+			return Z_DEFAULT_COMPRESSION;
+		}
+
+		VT_INLINE bool IsValidCodec(CompressionCodec codec)
+		{
+			switch (codec)
+			{
+				case CompressionCodec::DeflateFast:
+				case CompressionCodec::DeflateHigh:
+				case CompressionCodec::DeflateDefault:
+					return true;
+			}
+
+			return false;
+		}
+
+		VT_INLINE BlockEntry GetBlockEntry(const uint8_t* payload, uint32_t blockIndex)
+		{
+			// The payload has no alignment guarantees.
+			BlockEntry entry{};
+			memcpy_s(&entry, sizeof(BlockEntry), payload + sizeof(BlockTableHeader) + sizeof(BlockEntry) * blockIndex, sizeof(BlockEntry));
+
+			return entry;
+		}
+
+		VT_INLINE size_t GetBlockDataOffset(const BlockTableHeader& header)
+		{
+			return sizeof(BlockTableHeader) + sizeof(BlockEntry) * header.blockCount;
+		}
+
+		bool DecompressBlock(const uint8_t* payload, size_t payloadSize, const BlockTableHeader& header, uint32_t blockIndex, uint8_t* output)
+		{
+			const BlockEntry entry = GetBlockEntry(payload, blockIndex);
+			const size_t dataOffset = GetBlockDataOffset(header) + entry.dataOffset;
+
+			const uint64_t blockEnd = static_cast<uint64_t>(blockIndex) * header.blockSize + entry.uncompressedSize;
+			if (entry.uncompressedSize > header.blockSize || blockEnd > header.uncompressedSize || dataOffset + entry.compressedSize > payloadSize)
+			{
+				return false;
+			}
+
+			const uint8_t* blockData = payload + dataOffset;
+
+			if (entry.compressedSize == entry.uncompressedSize)
+			{
+				memcpy_s(output, entry.uncompressedSize, blockData, entry.compressedSize);
+				return true;
+			}
+
+			uLongf uncompressedSize = entry.uncompressedSize;
+			const int32_t result = uncompress(output, &uncompressedSize, blockData, entry.compressedSize);
+
+			return result == Z_OK && uncompressedSize == entry.uncompressedSize;
+		}
+	}
+
+	void Compress(const uint8_t* data, size_t size, CompressionCodec codec, Vector<uint8_t>& result, uint32_t blockSize)
+	{
+		VT_PROFILE_FUNCTION();
+
+		const uint32_t blockCount = static_cast<uint32_t>((size + blockSize - 1) / blockSize);
+		const int32_t compressionLevel = Utility::GetCompressionLevel(codec);
+
+		Vector<Vector<uint8_t>> compressedBlocks(blockCount);
+
+		Thread::ParallelFor(blockCount, [&](size_t blockIndex)
+		{
+			const size_t blockOffset = blockIndex * blockSize;
+			const uint32_t uncompressedSize = static_cast<uint32_t>(std::min(static_cast<size_t>(blockSize), size - blockOffset));
+
+			auto& compressedBlock = compressedBlocks[blockIndex];
+			compressedBlock.resize_uninitialized(compressBound(uncompressedSize));
+
+			uLongf compressedSize = static_cast<uLongf>(compressedBlock.size());
+			const int32_t compressResult = compress2(compressedBlock.data(), &compressedSize, data + blockOffset, uncompressedSize, compressionLevel);
+
+			// Store the block as is if it doesn't get any smaller.
+			if (compressResult != Z_OK || compressedSize >= uncompressedSize)
+			{
+				compressedBlock.resize_uninitialized(uncompressedSize);
+				memcpy_s(compressedBlock.data(), uncompressedSize, data + blockOffset, uncompressedSize);
+			}
+			else
+			{
+				compressedBlock.resize_uninitialized(compressedSize);
+			}
+		});
+
+		BlockTableHeader header{};
+		header.blockCount = blockCount;
+		header.blockSize = blockSize;
+		header.uncompressedSize = size;
+		header.codec = codec;
+
+		const size_t payloadOffset = result.size();
+		const size_t blockDataOffset = payloadOffset + Utility::GetBlockDataOffset(header);
+
+		size_t totalCompressedSize = 0;
+		for (const auto& compressedBlock : compressedBlocks)
+		{
+			totalCompressedSize += compressedBlock.size();
+		}
+
+		result.resize_uninitialized(blockDataOffset + totalCompressedSize);
+		memcpy_s(&result[payloadOffset], sizeof(BlockTableHeader), &header, sizeof(BlockTableHeader));
+
+		const size_t entriesOffset = payloadOffset + sizeof(BlockTableHeader);
+
+		size_t currentDataOffset = 0;
+		for (uint32_t blockIndex = 0; blockIndex < blockCount; blockIndex++)
+		{
+			const auto& compressedBlock = compressedBlocks[blockIndex];
+
+			BlockEntry entry{};
+			entry.dataOffset = currentDataOffset;
+			entry.compressedSize = static_cast<uint32_t>(compressedBlock.size());
+			entry.uncompressedSize = static_cast<uint32_t>(std::min(static_cast<size_t>(blockSize), size - static_cast<size_t>(blockIndex) * blockSize));
+
+			memcpy_s(&result[entriesOffset + sizeof(BlockEntry) * blockIndex], sizeof(BlockEntry), &entry, sizeof(BlockEntry));
+
+			if (!compressedBlock.empty())
+			{
+				memcpy_s(&result[blockDataOffset + currentDataOffset], compressedBlock.size(), compressedBlock.data(), compressedBlock.size());
+			}
+
+			currentDataOffset += compressedBlock.size();
+		}
+	}
+
+	bool ReadBlockTable(const uint8_t* payload, size_t payloadSize, BlockTableHeader& outHeader)
+	{
+		if (payloadSize < sizeof(BlockTableHeader))
+		{
+			return false;
+		}
+
+		memcpy_s(&outHeader, sizeof(BlockTableHeader), payload, sizeof(BlockTableHeader));
+
+		if (outHeader.blockSize == 0 || !Utility::IsValidCodec(outHeader.codec) || Utility::GetBlockDataOffset(outHeader) > payloadSize)
+		{
+			return false;
+		}
+
+		return outHeader.blockCount == (outHeader.uncompressedSize + outHeader.blockSize - 1) / outHeader.blockSize;
+	}
+
+	bool Decompress(const uint8_t* payload, size_t payloadSize, uint8_t* output)
+	{
+		VT_PROFILE_FUNCTION();
+
+		BlockTableHeader header{};
+		if (!ReadBlockTable(payload, payloadSize, header))
+		{
+			return false;
+		}
+
+		std::atomic_bool succeeded = true;
+
+		Thread::ParallelFor(header.blockCount, [&](size_t blockIndex)
+		{
+			if (!Utility::DecompressBlock(payload, payloadSize, header, static_cast<uint32_t>(blockIndex), output + blockIndex * header.blockSize))
+			{
+				succeeded.store(false, std::memory_order_relaxed);
+			}
+		});
+
+		return succeeded.load(std::memory_order_relaxed);
+	}
+
+	bool DecompressBlock(const uint8_t* payload, size_t payloadSize, uint32_t blockIndex, uint8_t* output)
+	{
+		BlockTableHeader header{};
+		if (!ReadBlockTable(payload, payloadSize, header) || blockIndex >= header.blockCount)
+		{
+			return false;
+		}
+
+		return Utility::DecompressBlock(payload, payloadSize, header, blockIndex, output);
+	}
+}
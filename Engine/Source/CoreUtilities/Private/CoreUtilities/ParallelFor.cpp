@@ -0,0 +1,32 @@
+#include "cupch.h"
+#include "CoreUtilities/ThreadUtilities.h"
+
+#include <atomic>
+
+namespace Thread
+{
+	namespace Utility
+	{
+		static std::atomic<ParallelForFunction> s_parallelForFunction = nullptr;
+	}
+
+	void SetParallelForFunction(ParallelForFunction function)
+	{
+		Utility::s_parallelForFunction.store(function, std::memory_order_release);
+	}
+
+	void ParallelFor(size_t count, const std::function<void(size_t)>& func)
+	{
+		ParallelForFunction parallelForFunction = Utility::s_parallelForFunction.load(std::memory_order_acquire);
+		if (parallelForFunction && count > 1)
+		{
+			parallelForFunction(count, func);
+			return;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			func(i);
+		}
+	}
+}
@@ -0,0 +1,107 @@
+#include "cupch.h"
+
+#ifndef VT_PLATFORM_WINDOWS
+
+#include "CoreUtilities/FileIO/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+{
+	const int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return;
+	}
+
+	struct stat fileStat{};
+	if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		// Empty files can't be mapped.
+		close(fileDescriptor);
+		return;
+	}
+
+	void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+	// The mapping keeps its own reference to the file.
+	close(fileDescriptor);
+
+	if (data == MAP_FAILED)
+	{
+		return;
+	}
+
+	madvise(data, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+	m_data = static_cast<const uint8_t*>(data);
+	m_size = static_cast<size_t>(fileStat.st_size);
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this == &other)
+	{
+		return *this;
+	}
+
+	Close();
+
+	m_data = std::exchange(other.m_data, nullptr);
+	m_size = std::exchange(other.m_size, 0);
+	m_fileHandle = std::exchange(other.m_fileHandle, nullptr);
+	m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+
+	return *this;
+}
+
+void MappedFile::PageIn(std::span<const uint8_t> mappedData)
+{
+	if (mappedData.empty())
+	{
+		return;
+	}
+
+	const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+	// madvise wants a page aligned start.
+	const uintptr_t rangeBegin = reinterpret_cast<uintptr_t>(mappedData.data()) & ~(pageSize - 1);
+	const uintptr_t rangeEnd = reinterpret_cast<uintptr_t>(mappedData.data()) + mappedData.size();
+	madvise(reinterpret_cast<void*>(rangeBegin), rangeEnd - rangeBegin, MADV_WILLNEED);
+
+	uint8_t checksum = 0;
+	for (size_t offset = 0; offset < mappedData.size(); offset += pageSize)
+	{
+		checksum ^= *reinterpret_cast<const volatile uint8_t*>(mappedData.data() + offset);
+	}
+
+	VT_UNUSED(checksum);
+}
+
+void MappedFile::Close()
+{
+	if (m_data)
+	{
+		munmap(const_cast<uint8_t*>(m_data), m_size);
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_fileHandle = nullptr;
+	m_mappingHandle = nullptr;
+}
+
+#endif
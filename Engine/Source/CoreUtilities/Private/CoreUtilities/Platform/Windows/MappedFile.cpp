@@ -0,0 +1,119 @@
+#include "cupch.h"
+
+#ifdef VT_PLATFORM_WINDOWS
+
+#include "CoreUtilities/FileIO/MappedFile.h"
+#include "CoreUtilities/Platform/Windows/VoltWindows.h"
+
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+{
+	HANDLE fileHandle = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	m_fileHandle = fileHandle;
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+	{
+		// Empty files can't be mapped.
+		Close();
+		return;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mappingHandle)
+	{
+		Close();
+		return;
+	}
+
+	m_mappingHandle = mappingHandle;
+
+	const void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (!data)
+	{
+		Close();
+		return;
+	}
+
+	m_data = static_cast<const uint8_t*>(data);
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this == &other)
+	{
+		return *this;
+	}
+
+	Close();
+
+	m_data = std::exchange(other.m_data, nullptr);
+	m_size = std::exchange(other.m_size, 0);
+	m_fileHandle = std::exchange(other.m_fileHandle, nullptr);
+	m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+
+	return *this;
+}
+
+void MappedFile::PageIn(std::span<const uint8_t> mappedData)
+{
+	if (mappedData.empty())
+	{
+		return;
+	}
+
+	// Lets the OS read the whole range in large requests, touching the pages afterwards makes sure it has finished.
+	WIN32_MEMORY_RANGE_ENTRY rangeEntry{ const_cast<uint8_t*>(mappedData.data()), mappedData.size() };
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &rangeEntry, 0);
+
+	SYSTEM_INFO systemInfo{};
+	GetSystemInfo(&systemInfo);
+
+	uint8_t checksum = 0;
+	for (size_t offset = 0; offset < mappedData.size(); offset += systemInfo.dwPageSize)
+	{
+		checksum ^= *reinterpret_cast<const volatile uint8_t*>(mappedData.data() + offset);
+	}
+
+	VT_UNUSED(checksum);
+}
+
+void MappedFile::Close()
+{
+	if (m_data)
+	{
+		UnmapViewOfFile(m_data);
+	}
+
+	if (m_mappingHandle)
+	{
+		CloseHandle(m_mappingHandle);
+	}
+
+	if (m_fileHandle)
+	{
+		CloseHandle(m_fileHandle);
+	}
+
+	m_data = nullptr;
+	m_size = 0;
+	m_fileHandle = nullptr;
+	m_mappingHandle = nullptr;
+}
+
+#endif
@@ -2,12 +2,10 @@
 
 #include "CoreUtilities/UUID.h"
 #include "CoreUtilities/Containers/Vector.h"
+#include "CoreUtilities/Containers/SlotMap.h"
+#include "CoreUtilities/Containers/Map.h"
 
-#include <unordered_map>
-#include <ranges>
-
-template<typename NodeDataType, typename EdgeMetadataType>
-class Graph;
+#include <algorithm>
 
 template<typename MetaDataType>
 struct GraphEdge
@@ -24,36 +22,39 @@ struct GraphEdge
 template<typename NodeDataType, typename EdgeMetadataType>
 struct GraphNode
 {
-	GraphNode(UUID64 id, NodeDataType data, Graph<NodeDataType, EdgeMetadataType>* graph)
-		: id(id), nodeData(data), m_graph(graph)
+	GraphNode(UUID64 id, NodeDataType data)
+		: id(id), nodeData(data)
 	{}
 
 	UUID64 id = 0;
 	NodeDataType nodeData{};
 
-	Vector<UUID64> edges;
-
-	const Vector<UUID64> GetInputEdges() const;
-	const Vector<UUID64> GetOutputEdges() const;
+	// Edges ending at this node
+	Vector<UUID64> inputEdges;
+	// Edges starting at this node
+	Vector<UUID64> outputEdges;
 
-	const GraphEdge<EdgeMetadataType>& GetEdgeFromID(const UUID64 edgeId) const;
-	const GraphNode<NodeDataType, EdgeMetadataType>& GetNodeFromID(const UUID64 nodeId) const;
+	inline const Vector<UUID64>& GetInputEdges() const { return inputEdges; }
+	inline const Vector<UUID64>& GetOutputEdges() const { return outputEdges; }
 
 	void RemoveEdge(const UUID64 edgeId);
 
 	inline const bool IsValid() const { return id != 0; }
-
-private:
-	Graph<NodeDataType, EdgeMetadataType>* m_graph = nullptr;
 };
 
+// Nodes and edges are stored packed in slot maps, with an index from ID to slot, so lookups by ID are constant time.
+// Every node keeps its incoming and outgoing edges, so walking the graph scales with the edges visited.
 template<typename NodeDataType, typename EdgeMetadataType>
 class Graph
 {
 public:
+	using NodeType = GraphNode<NodeDataType, EdgeMetadataType>;
+	using EdgeType = GraphEdge<EdgeMetadataType>;
+
 	Graph() {}
 	~Graph() {}
 
+	// Returns 0 if a node with the ID already exists.
 	const UUID64 AddNode(const UUID64 nodeId, const NodeDataType& data);
 	const UUID64 AddNode(const NodeDataType& data);
 
@@ -64,218 +65,304 @@ public:
 	void RemoveEdge(const UUID64 edgeId);
 
 	const bool DoNodeExist(const UUID64 nodeId) const;
+	const bool DoEdgeExist(const UUID64 edgeId) const;
+
+	// Returns the first edge from startNode to endNode, or 0 if they aren't linked.
+	const UUID64 FindEdge(const UUID64 startNode, const UUID64 endNode) const;
+
+	const EdgeType& GetEdgeFromID(const UUID64 edgeId) const;
+	const NodeType& GetNodeFromID(const UUID64 nodeId) const;
+
+	EdgeType& GetEdgeFromID(const UUID64 edgeId);
+	NodeType& GetNodeFromID(const UUID64 nodeId);
+
+	// Handles stay valid until the node or edge is removed, and skip the ID lookup.
+	const SlotHandle GetNodeHandle(const UUID64 nodeId) const;
+	const SlotHandle GetEdgeHandle(const UUID64 edgeId) const;
 
-	const GraphEdge<EdgeMetadataType>& GetEdgeFromID(const UUID64 edgeId) const;
-	const GraphNode<NodeDataType, EdgeMetadataType>& GetNodeFromID(const UUID64 nodeId) const;
+	inline NodeType* TryGetNode(const SlotHandle handle) { return m_nodes.TryGet(handle); }
+	inline const NodeType* TryGetNode(const SlotHandle handle) const { return m_nodes.TryGet(handle); }
+	inline EdgeType* TryGetEdge(const SlotHandle handle) { return m_edges.TryGet(handle); }
+	inline const EdgeType* TryGetEdge(const SlotHandle handle) const { return m_edges.TryGet(handle); }
 
-	GraphEdge<EdgeMetadataType>& GetEdgeFromID(const UUID64 edgeId);
-	GraphNode<NodeDataType, EdgeMetadataType>& GetNodeFromID(const UUID64 nodeId);
+	// Every node ordered so that edges always go from an earlier node to a later one.
+	// Nodes that are part of a cycle, or depend on one, are left out. Callers detect cycles by comparing the size against the node count.
+	// Cached until the graph changes, so it isn't safe to call from several threads.
+	const Vector<UUID64>& GetTopologicalOrder() const;
 
-	inline auto& GetNodes() { return m_nodes; }
-	inline const auto& GetNodes() const { return m_nodes; }
+	// The nodes and edges are packed, but their order changes when nodes or edges are removed.
+	inline auto& GetNodes() { return m_nodes.GetValues(); }
+	inline const auto& GetNodes() const { return m_nodes.GetValues(); }
 
-	inline auto& GetEdges() { return m_edges; }
-	inline const auto& GetEdges() const { return m_edges; }
+	inline auto& GetEdges() { return m_edges.GetValues(); }
+	inline const auto& GetEdges() const { return m_edges.GetValues(); }
 
 private:
-	Vector<GraphNode<NodeDataType, EdgeMetadataType>> m_nodes;
-	Vector<GraphEdge<EdgeMetadataType>> m_edges;
+	SlotMap<NodeType> m_nodes;
+	SlotMap<EdgeType> m_edges;
+
+	vt::map<UUID64, SlotHandle> m_nodeHandleFromID;
+	vt::map<UUID64, SlotHandle> m_edgeHandleFromID;
+
+	mutable Vector<UUID64> m_topologicalOrder;
+	mutable bool m_isTopologicalOrderDirty = true;
 };
 
 template<typename NodeDataType, typename EdgeMetadataType>
 inline const UUID64 Graph<NodeDataType, EdgeMetadataType>::AddNode(const UUID64 nodeId, const NodeDataType& data)
 {
-	auto& newNode = m_nodes.emplace_back(nodeId, data, this);
-	return newNode.id;
+	if (m_nodeHandleFromID.contains(nodeId))
+	{
+		return 0;
+	}
+
+	m_nodeHandleFromID[nodeId] = m_nodes.Emplace(nodeId, data);
+	m_isTopologicalOrderDirty = true;
+
+	return nodeId;
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
 inline const UUID64 Graph<NodeDataType, EdgeMetadataType>::AddNode(const NodeDataType& data)
 {
-	auto& newNode = m_nodes.emplace_back(UUID64{}, data, this);
-	return newNode.id;
+	return AddNode(UUID64{}, data);
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
 inline const UUID64 Graph<NodeDataType, EdgeMetadataType>::LinkNodes(const UUID64 startNodeId, const UUID64 endNodeId, const EdgeMetadataType& metadata)
 {
-	if (!DoNodeExist(startNodeId) || !DoNodeExist(endNodeId))
-	{
-		return 0;
-	}
-
-	auto& newEdge = m_edges.emplace_back(UUID64{}, startNodeId, endNodeId, metadata);
-	
-	auto& startNode = GetNodeFromID(startNodeId);
-	startNode.edges.emplace_back(newEdge.id);
-	
-	auto& endNode = GetNodeFromID(endNodeId);
-	endNode.edges.emplace_back(newEdge.id);
-
-	return newEdge.id;
+	return LinkNodes(UUID64{}, startNodeId, endNodeId, metadata);
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
 inline const UUID64 Graph<NodeDataType, EdgeMetadataType>::LinkNodes(const UUID64 id, const UUID64 startNodeId, const UUID64 endNodeId, const EdgeMetadataType& metadata)
 {
-	if (!DoNodeExist(startNodeId) || !DoNodeExist(endNodeId))
+	NodeType* startNode = TryGetNode(GetNodeHandle(startNodeId));
+	NodeType* endNode = TryGetNode(GetNodeHandle(endNodeId));
+
+	if (!startNode || !endNode || m_edgeHandleFromID.contains(id))
 	{
 		return 0;
 	}
 
-	auto& newEdge = m_edges.emplace_back(id, startNodeId, endNodeId, metadata);
+	m_edgeHandleFromID[id] = m_edges.Emplace(id, startNodeId, endNodeId, metadata);
 
-	auto& startNode = GetNodeFromID(startNodeId);
-	startNode.edges.emplace_back(newEdge.id);
+	startNode->outputEdges.emplace_back(id);
+	endNode->inputEdges.emplace_back(id);
 
-	auto& endNode = GetNodeFromID(endNodeId);
-	endNode.edges.emplace_back(newEdge.id);
+	m_isTopologicalOrderDirty = true;
 
-	return newEdge.id;
+	return id;
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
 void Graph<NodeDataType, EdgeMetadataType>::RemoveNode(const UUID64 nodeId)
 {
-	auto it = std::find_if(m_nodes.begin(), m_nodes.end(), [&](const auto& node) { return node.id == nodeId; });
-	if (it == m_nodes.end())
+	const SlotHandle handle = GetNodeHandle(nodeId);
+	NodeType* node = TryGetNode(handle);
+
+	if (!node)
 	{
 		return;
 	}
 
-	auto node = *it;
+	// Removing edges only moves edges around, so the node stays in place
+	while (!node->inputEdges.empty())
+	{
+		RemoveEdge(node->inputEdges.back());
+	}
 
-	for (int32_t i = static_cast<int32_t>(node.edges.size()) - 1; i >= 0; --i)
+	while (!node->outputEdges.empty())
 	{
-		RemoveEdge(node.edges.at(i));
+		RemoveEdge(node->outputEdges.back());
 	}
 
-	m_nodes.erase(it);
+	m_nodes.Remove(handle);
+	m_nodeHandleFromID.erase(nodeId);
+
+	m_isTopologicalOrderDirty = true;
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
 void Graph<NodeDataType, EdgeMetadataType>::RemoveEdge(const UUID64 edgeId)
 {
-	auto it = std::find_if(m_edges.begin(), m_edges.end(), [&](const auto& edge) { return edge.id == edgeId; });
-	if (it == m_edges.end())
+	const SlotHandle handle = GetEdgeHandle(edgeId);
+	const EdgeType* edge = TryGetEdge(handle);
+
+	if (!edge)
 	{
 		return;
 	}
 
-	auto edge = *it;
+	if (NodeType* startNode = TryGetNode(GetNodeHandle(edge->startNode)))
+	{
+		startNode->RemoveEdge(edgeId);
+	}
 
-	auto startNode = GetNodeFromID(edge.startNode);
-	auto endNode = GetNodeFromID(edge.endNode);
+	if (NodeType* endNode = TryGetNode(GetNodeHandle(edge->endNode)))
+	{
+		endNode->RemoveEdge(edgeId);
+	}
 
-	startNode.RemoveEdge(edgeId);
-	endNode.RemoveEdge(edgeId);
+	m_edges.Remove(handle);
+	m_edgeHandleFromID.erase(edgeId);
 
-	m_edges.erase(it);
+	m_isTopologicalOrderDirty = true;
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
 inline const bool Graph<NodeDataType, EdgeMetadataType>::DoNodeExist(const UUID64 nodeId) const
 {
-	auto it = std::find_if(m_nodes.begin(), m_nodes.end(), [&](const auto& node) { return node.id == nodeId; });
-	return it != m_nodes.end();
+	return m_nodeHandleFromID.contains(nodeId);
+}
+
+template<typename NodeDataType, typename EdgeMetadataType>
+inline const bool Graph<NodeDataType, EdgeMetadataType>::DoEdgeExist(const UUID64 edgeId) const
+{
+	return m_edgeHandleFromID.contains(edgeId);
+}
+
+template<typename NodeDataType, typename EdgeMetadataType>
+inline const UUID64 Graph<NodeDataType, EdgeMetadataType>::FindEdge(const UUID64 startNodeId, const UUID64 endNodeId) const
+{
+	const NodeType* startNode = TryGetNode(GetNodeHandle(startNodeId));
+	if (!startNode)
+	{
+		return 0;
+	}
+
+	for (const auto& edgeId : startNode->outputEdges)
+	{
+		if (GetEdgeFromID(edgeId).endNode == endNodeId)
+		{
+			return edgeId;
+		}
+	}
+
+	return 0;
+}
+
+template<typename NodeDataType, typename EdgeMetadataType>
+inline const SlotHandle Graph<NodeDataType, EdgeMetadataType>::GetNodeHandle(const UUID64 nodeId) const
+{
+	auto it = m_nodeHandleFromID.find(nodeId);
+	return it != m_nodeHandleFromID.end() ? it->second : SlotHandle{};
+}
+
+template<typename NodeDataType, typename EdgeMetadataType>
+inline const SlotHandle Graph<NodeDataType, EdgeMetadataType>::GetEdgeHandle(const UUID64 edgeId) const
+{
+	auto it = m_edgeHandleFromID.find(edgeId);
+	return it != m_edgeHandleFromID.end() ? it->second : SlotHandle{};
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
 inline const GraphEdge<EdgeMetadataType>& Graph<NodeDataType, EdgeMetadataType>::GetEdgeFromID(const UUID64 edgeId) const
 {
-	auto it = std::find_if(m_edges.begin(), m_edges.end(), [&](const auto& edge) { return edge.id == edgeId; });
-	if (it == m_edges.end())
+	const EdgeType* edge = TryGetEdge(GetEdgeHandle(edgeId));
+	if (!edge)
 	{
 		static GraphEdge<EdgeMetadataType> nullEdge;
 		return nullEdge;
 	}
 
-	return *it;
+	return *edge;
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
 inline const GraphNode<NodeDataType, EdgeMetadataType>& Graph<NodeDataType, EdgeMetadataType>::GetNodeFromID(const UUID64 nodeId) const
 {
-	auto it = std::find_if(m_nodes.begin(), m_nodes.end(), [&](const auto& node) { return node.id == nodeId; });
-	if (it == m_nodes.end())
+	const NodeType* node = TryGetNode(GetNodeHandle(nodeId));
+	if (!node)
 	{
-		static GraphNode<NodeDataType, EdgeMetadataType> nullNode{ 0, NodeDataType{}, nullptr };
+		static GraphNode<NodeDataType, EdgeMetadataType> nullNode{ 0, NodeDataType{} };
 		return nullNode;
 	}
 
-	return *it;
+	return *node;
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
 inline GraphEdge<EdgeMetadataType>& Graph<NodeDataType, EdgeMetadataType>::GetEdgeFromID(const UUID64 edgeId)
 {
-	auto it = std::find_if(m_edges.begin(), m_edges.end(), [&](const auto& edge) { return edge.id == edgeId; });
-	if (it == m_edges.end())
+	EdgeType* edge = TryGetEdge(GetEdgeHandle(edgeId));
+	if (!edge)
 	{
 		static GraphEdge<EdgeMetadataType> nullEdge;
 		return nullEdge;
 	}
 
-	return *it;
+	return *edge;
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
 inline GraphNode<NodeDataType, EdgeMetadataType>& Graph<NodeDataType, EdgeMetadataType>::GetNodeFromID(const UUID64 nodeId)
 {
-	auto it = std::find_if(m_nodes.begin(), m_nodes.end(), [&](const auto& node) { return node.id == nodeId; });
-	if (it == m_nodes.end())
+	NodeType* node = TryGetNode(GetNodeHandle(nodeId));
+	if (!node)
 	{
-		static GraphNode<NodeDataType, EdgeMetadataType> nullNode{ 0, NodeDataType{}, nullptr };
+		static GraphNode<NodeDataType, EdgeMetadataType> nullNode{ 0, NodeDataType{} };
 		return nullNode;
 	}
 
-	return *it;
+	return *node;
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
-inline const Vector<UUID64> GraphNode<NodeDataType, EdgeMetadataType>::GetInputEdges() const
+inline const Vector<UUID64>& Graph<NodeDataType, EdgeMetadataType>::GetTopologicalOrder() const
 {
-	auto view = edges | std::views::filter([&](UUID64 edgeId)
+	if (!m_isTopologicalOrderDirty)
 	{
-		const auto& edge = m_graph->GetEdgeFromID(edgeId);
-		return edge.endNode == id;
-	});
+		return m_topologicalOrder;
+	}
 
-	return Vector<UUID64>{ view.begin(), view.end() };
-}
+	const auto& nodes = m_nodes.GetValues();
 
-template<typename NodeDataType, typename EdgeMetadataType>
-inline const GraphEdge<EdgeMetadataType>& GraphNode<NodeDataType, EdgeMetadataType>::GetEdgeFromID(const UUID64 edgeId) const
-{
-	return m_graph->GetEdgeFromID(edgeId);
-}
+	// Kahn's algorithm, the order itself doubles as the queue of nodes with no unvisited inputs
+	Vector<uint32_t> remainingInputCounts(nodes.size());
 
-template<typename NodeDataType, typename EdgeMetadataType>
-inline const GraphNode<NodeDataType, EdgeMetadataType>& GraphNode<NodeDataType, EdgeMetadataType>::GetNodeFromID(const UUID64 nodeId) const
-{
-	return m_graph->GetNodeFromID(nodeId);
-}
+	m_topologicalOrder.clear();
+	m_topologicalOrder.reserve(nodes.size());
 
-template<typename NodeDataType, typename EdgeMetadataType>
-inline void GraphNode<NodeDataType, EdgeMetadataType>::RemoveEdge(const UUID64 edgeId)
-{
-	auto it = std::find_if(edges.begin(), edges.end(), [&](const auto& edge) { return edge == edgeId; });
-	if (it == edges.end())
+	for (size_t i = 0; i < nodes.size(); i++)
 	{
-		return;
+		remainingInputCounts[i] = static_cast<uint32_t>(nodes[i].inputEdges.size());
+		if (remainingInputCounts[i] == 0)
+		{
+			m_topologicalOrder.emplace_back(nodes[i].id);
+		}
+	}
+
+	for (size_t orderIndex = 0; orderIndex < m_topologicalOrder.size(); orderIndex++)
+	{
+		const NodeType& node = GetNodeFromID(m_topologicalOrder[orderIndex]);
+
+		for (const auto& edgeId : node.outputEdges)
+		{
+			const uint32_t endNodeIndex = m_nodes.GetDenseIndex(GetNodeHandle(GetEdgeFromID(edgeId).endNode));
+			if (--remainingInputCounts[endNodeIndex] == 0)
+			{
+				m_topologicalOrder.emplace_back(nodes[endNodeIndex].id);
+			}
+		}
 	}
 
-	edges.erase(it);
+	m_isTopologicalOrderDirty = false;
+	return m_topologicalOrder;
 }
 
 template<typename NodeDataType, typename EdgeMetadataType>
-inline const Vector<UUID64> GraphNode<NodeDataType, EdgeMetadataType>::GetOutputEdges() const
+inline void GraphNode<NodeDataType, EdgeMetadataType>::RemoveEdge(const UUID64 edgeId)
 {
-	auto view = edges | std::views::filter([&](UUID64 edgeId)
+	auto inputIt = std::find(inputEdges.begin(), inputEdges.end(), edgeId);
+	if (inputIt != inputEdges.end())
 	{
-		const auto& edge = m_graph->GetEdgeFromID(edgeId);
-		return edge.startNode == id;
-	});
+		inputEdges.erase(inputIt);
+	}
 
-	return Vector<UUID64>{ view.begin(), view.end() };
+	auto outputIt = std::find(outputEdges.begin(), outputEdges.end(), edgeId);
+	if (outputIt != outputEdges.end())
+	{
+		outputEdges.erase(outputIt);
+	}
 }
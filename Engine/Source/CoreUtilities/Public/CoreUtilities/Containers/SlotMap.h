@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoreUtilities/VoltAssert.h"
+#include "CoreUtilities/Containers/Vector.h"
+
+#include <limits>
+
+struct SlotHandle
+{
+	inline static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+	uint32_t index = INVALID_INDEX;
+	uint32_t generation = 0;
+
+	VT_NODISCARD VT_INLINE constexpr bool IsValid() const { return index != INVALID_INDEX; }
+	VT_NODISCARD VT_INLINE constexpr bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+};
+
+// Values are kept packed in a dense array, and reached through handles that stay valid until the value is removed.
+// Removing moves the last value into the hole, and bumps the slot generation so stale handles are rejected.
+template<typename T>
+class SlotMap
+{
+public:
+	SlotMap() = default;
+	~SlotMap() = default;
+
+	template<typename... Args>
+	SlotHandle Emplace(Args&&... args);
+
+	// Returns false if the handle is stale.
+	bool Remove(const SlotHandle handle);
+	void Clear();
+	void Reserve(const size_t count);
+
+	VT_NODISCARD VT_INLINE bool Contains(const SlotHandle handle) const
+	{
+		return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+	}
+
+	// Returns nullptr if the handle is stale.
+	VT_NODISCARD VT_INLINE T* TryGet(const SlotHandle handle) { return Contains(handle) ? &m_values[m_slots[handle.index].denseIndex] : nullptr; }
+	VT_NODISCARD VT_INLINE const T* TryGet(const SlotHandle handle) const { return Contains(handle) ? &m_values[m_slots[handle.index].denseIndex] : nullptr; }
+
+	VT_NODISCARD VT_INLINE T& Get(const SlotHandle handle) { VT_ENSURE(Contains(handle)); return m_values[m_slots[handle.index].denseIndex]; }
+	VT_NODISCARD VT_INLINE const T& Get(const SlotHandle handle) const { VT_ENSURE(Contains(handle)); return m_values[m_slots[handle.index].denseIndex]; }
+
+	// The position of the value in the dense array, valid until the next removal.
+	VT_NODISCARD VT_INLINE uint32_t GetDenseIndex(const SlotHandle handle) const { VT_ENSURE(Contains(handle)); return m_slots[handle.index].denseIndex; }
+
+	// The handle of the value at a position in the dense array.
+	VT_NODISCARD VT_INLINE SlotHandle GetHandleFromDenseIndex(const size_t denseIndex) const
+	{
+		const uint32_t slotIndex = m_slotFromDenseIndex.at(denseIndex);
+		return { slotIndex, m_slots[slotIndex].generation };
+	}
+
+	VT_NODISCARD VT_INLINE size_t Size() const { return m_values.size(); }
+	VT_NODISCARD VT_INLINE bool Empty() const { return m_values.empty(); }
+
+	// The values are packed, but their order changes when values are removed.
+	VT_NODISCARD VT_INLINE Vector<T>& GetValues() { return m_values; }
+	VT_NODISCARD VT_INLINE const Vector<T>& GetValues() const { return m_values; }
+
+private:
+	struct Slot
+	{
+		uint32_t denseIndex = 0;
+		uint32_t generation = 0;
+	};
+
+	Vector<T> m_values;
+	Vector<uint32_t> m_slotFromDenseIndex;
+
+	Vector<Slot> m_slots;
+	Vector<uint32_t> m_freeSlots;
+};
+
+template<typename T>
+template<typename... Args>
+inline SlotHandle SlotMap<T>::Emplace(Args&&... args)
+{
+	uint32_t slotIndex;
+	if (!m_freeSlots.empty())
+	{
+		slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		slotIndex = static_cast<uint32_t>(m_slots.size());
+		m_slots.emplace_back();
+	}
+
+	Slot& slot = m_slots[slotIndex];
+	slot.denseIndex = static_cast<uint32_t>(m_values.size());
+
+	m_values.emplace_back(std::forward<Args>(args)...);
+	m_slotFromDenseIndex.emplace_back(slotIndex);
+
+	return { slotIndex, slot.generation };
+}
+
+template<typename T>
+inline bool SlotMap<T>::Remove(const SlotHandle handle)
+{
+	if (!Contains(handle))
+	{
+		return false;
+	}
+
+	Slot& slot = m_slots[handle.index];
+	const uint32_t denseIndex = slot.denseIndex;
+	const uint32_t lastDenseIndex = static_cast<uint32_t>(m_values.size() - 1);
+
+	if (denseIndex != lastDenseIndex)
+	{
+		m_values[denseIndex] = std::move(m_values[lastDenseIndex]);
+		m_slotFromDenseIndex[denseIndex] = m_slotFromDenseIndex[lastDenseIndex];
+		m_slots[m_slotFromDenseIndex[denseIndex]].denseIndex = denseIndex;
+	}
+
+	m_values.pop_back();
+	m_slotFromDenseIndex.pop_back();
+
+	slot.generation++;
+	m_freeSlots.emplace_back(handle.index);
+
+	return true;
+}
+
+template<typename T>
+inline void SlotMap<T>::Clear()
+{
+	// Every live slot is retired, so handles from before the clear stay invalid
+	for (const uint32_t slotIndex : m_slotFromDenseIndex)
+	{
+		m_slots[slotIndex].generation++;
+		m_freeSlots.emplace_back(slotIndex);
+	}
+
+	m_values.clear();
+	m_slotFromDenseIndex.clear();
+}
+
+template<typename T>
+inline void SlotMap<T>::Reserve(const size_t count)
+{
+	m_values.reserve(count);
+	m_slotFromDenseIndex.reserve(count);
+	m_slots.reserve(count);
+}
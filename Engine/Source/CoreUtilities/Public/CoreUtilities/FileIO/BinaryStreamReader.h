@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreUtilities/FileIO/StreamCommon.h"
+#include "CoreUtilities/FileIO/MappedFile.h"
 #include "CoreUtilities/Buffer/Buffer.h"
 #include "CoreUtilities/Containers/Vector.h"
 #include "CoreUtilities/Containers/Map.h"
@@ -8,14 +9,26 @@
 #include <fstream>
 
 #include <array>
+#include <span>
 #include <string>
 #include <map>
 #include <unordered_map>
 
+enum class StreamReadMode : uint8_t
+{
+	// The whole file is read into memory.
+	Buffered,
+
+	// The file is mapped, and uncompressed data is read straight from the mapping.
+	// Compressed data is inflated from the mapping, so the compressed bytes are never copied.
+	MemoryMapped
+};
+
 class VTCOREUTIL_API BinaryStreamReader
 {
 public:
 	BinaryStreamReader(const std::filesystem::path& filePath);
+	BinaryStreamReader(const std::filesystem::path& filePath, StreamReadMode readMode);
 	BinaryStreamReader(const std::filesystem::path& filePath, const size_t maxLoadSize);
 
 	bool IsStreamValid() const;
@@ -38,6 +51,11 @@ public:
 	template<typename F>
 	void ReadRaw(Vector<F>& data);
 
+	// Reads an array written with WriteRaw without copying it out of the stream. The view is only valid while the reader is alive.
+	// If the data is not aligned for F, it is copied into fallbackStorage, and the view points there instead.
+	template<typename F>
+	std::span<const F> ReadRawView(Vector<F>& fallbackStorage);
+
 	template<typename F, size_t COUNT>
 	void Read(std::array<F, COUNT>& data);
 
@@ -58,14 +76,50 @@ public:
 private:
 	void ReadData(void* outData, const TypeHeader& serializedTypeHeader, const TypeHeader& constructedTypeHeader);
 
-	bool Decompress(size_t compressedDataOffset);
+	void SetDataFromBuffer();
+
+	bool Decompress(size_t compressedDataOffset, StreamCompressionEncoding encoding);
+	bool DecompressBlocks(size_t compressedDataOffset);
+	bool DecompressDeflateStream(size_t compressedDataOffset);
 
+	// Owned data, unless the stream is reading straight from the mapped file or a prefetched view.
 	Vector<uint8_t> m_data;
+	MappedFile m_mappedFile;
+
+	const uint8_t* m_dataPtr = nullptr;
+	size_t m_dataSize = 0;
+
 	size_t m_currentOffset = 0;
 	bool m_streamValid = false;
 	bool m_compressed = false;
 };
 
+// Hands already loaded file data to the next BinaryStreamReader that is constructed with the same path on the calling thread.
+// Lets the file read happen on a different thread than the deserialization, without the serializers knowing about it.
+class VTCOREUTIL_API PrefetchedFileScope
+{
+public:
+	PrefetchedFileScope(const std::filesystem::path& filePath, Vector<uint8_t>&& fileData);
+
+	// The data is not copied, it has to stay alive for as long as the scope does.
+	PrefetchedFileScope(const std::filesystem::path& filePath, std::span<const uint8_t> fileView);
+	~PrefetchedFileScope();
+
+	PrefetchedFileScope(const PrefetchedFileScope&) = delete;
+	PrefetchedFileScope& operator=(const PrefetchedFileScope&) = delete;
+
+	// The data can only be taken once. Scopes created from a view return it through outView, and leave outData untouched.
+	static bool TryTakeFileData(const std::filesystem::path& filePath, Vector<uint8_t>& outData, std::span<const uint8_t>& outView);
+
+private:
+	std::filesystem::path m_filePath;
+	Vector<uint8_t> m_fileData;
+	std::span<const uint8_t> m_fileView;
+	bool m_hasData = true;
+
+	PrefetchedFileScope* m_previousScope = nullptr;
+};
+
 template<typename T>
 inline void BinaryStreamReader::Read(T& outData)
 {
@@ -173,6 +227,30 @@ inline void BinaryStreamReader::ReadRaw(Vector<F>& data)
 	ReadData(data.data(), serializedTypeHeader, typeHeader);
 }
 
+template<typename F>
+inline std::span<const F> BinaryStreamReader::ReadRawView(Vector<F>& fallbackStorage)
+{
+	static_assert(std::is_trivially_copyable_v<F>);
+
+	TypeHeader serializedTypeHeader = ReadTypeHeader();
+
+	const size_t elementCount = serializedTypeHeader.totalTypeSize;
+	const size_t byteSize = elementCount * sizeof(F);
+
+	const uint8_t* elementData = &m_dataPtr[m_currentOffset];
+	m_currentOffset += byteSize;
+
+	if (reinterpret_cast<uintptr_t>(elementData) % alignof(F) == 0)
+	{
+		return { reinterpret_cast<const F*>(elementData), elementCount };
+	}
+
+	fallbackStorage.resize_uninitialized(elementCount);
+	memcpy_s(fallbackStorage.data(), byteSize, elementData, byteSize);
+
+	return { fallbackStorage.data(), elementCount };
+}
+
 template<typename F, size_t COUNT>
 inline void BinaryStreamReader::Read(std::array<F, COUNT>& data)
 {
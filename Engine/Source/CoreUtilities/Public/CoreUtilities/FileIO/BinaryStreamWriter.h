@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreUtilities/FileIO/StreamCommon.h"
+#include "CoreUtilities/FileIO/BlockCompression.h"
 #include "CoreUtilities/Buffer/Buffer.h"
 #include "CoreUtilities/Containers/Vector.h"
 
@@ -14,7 +15,11 @@
 class VTCOREUTIL_API BinaryStreamWriter
 {
 public:
+	// Compressed files use the zlib default level.
 	void WriteToDisk(const std::filesystem::path& targetFilepath, bool compress, size_t compressedDataOffset);
+
+	// Everything after compressedDataOffset is block compressed with the given codec, the data in front of it stays readable without decompression.
+	void WriteToDisk(const std::filesystem::path& targetFilepath, CompressionCodec codec, size_t compressedDataOffset);
 	[[nodiscard]] const size_t GetSize() const { return m_data.size(); }
 
 	template<typename T>
@@ -56,8 +61,6 @@ public:
 	size_t Write(const void* data, const size_t size);
 
 private:
-	bool GetCompressed(Vector<uint8_t>& result, size_t compressedDataOffset = 0);
-
 	void WriteTypeHeader(const TypeHeader& typeHeader);
 	void WriteData(const void* data, const size_t size);
 
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreUtilities/Config.h"
+#include "CoreUtilities/Containers/Vector.h"
+
+#include <cstdint>
+
+enum class CompressionCodec : uint8_t
+{
+	// Fast to compress and decompress, used for runtime assets.
+	DeflateFast = 0,
+
+	// Smallest output, slow to compress, used for distribution.
+	DeflateHigh = 1,
+
+	// The zlib default level, used by editor saves.
+	DeflateDefault = 2
+};
+
+// Payload split into independently compressed blocks, with a block table in front:
+// BlockTableHeader | BlockEntry[blockCount] | block data.
+// Blocks are compressed and decompressed in parallel, and any block can be decompressed on its own.
+namespace BlockCompression
+{
+	inline static constexpr uint32_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+	struct BlockTableHeader
+	{
+		uint32_t blockCount;
+		uint32_t blockSize;
+		uint64_t uncompressedSize;
+		CompressionCodec codec;
+		uint8_t padding[7];
+	};
+
+	struct BlockEntry
+	{
+		// Relative to the start of the block data.
+		uint64_t dataOffset;
+		uint32_t compressedSize;
+
+		// Blocks which don't compress are stored as is, with both sizes being equal.
+		uint32_t uncompressedSize;
+	};
+
+	static_assert(sizeof(BlockTableHeader) == 24);
+	static_assert(sizeof(BlockEntry) == 16);
+
+	// Appends the compressed payload to result.
+	extern VTCOREUTIL_API void Compress(const uint8_t* data, size_t size, CompressionCodec codec, Vector<uint8_t>& result, uint32_t blockSize = DEFAULT_BLOCK_SIZE);
+
+	// Returns false if the payload is truncated, the block table is invalid or the codec is unknown.
+	extern VTCOREUTIL_API bool ReadBlockTable(const uint8_t* payload, size_t payloadSize, BlockTableHeader& outHeader);
+
+	// Decompresses all blocks in parallel. The output must be BlockTableHeader::uncompressedSize bytes.
+	extern VTCOREUTIL_API bool Decompress(const uint8_t* payload, size_t payloadSize, uint8_t* output);
+
+	// The output must be at least the block's uncompressed size, which is blockSize for all but the last block.
+	extern VTCOREUTIL_API bool DecompressBlock(const uint8_t* payload, size_t payloadSize, uint32_t blockIndex, uint8_t* output);
+}
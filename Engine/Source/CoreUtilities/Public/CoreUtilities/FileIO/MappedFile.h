@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreUtilities/Config.h"
+#include "CoreUtilities/CompilerTraits.h"
+
+#include <filesystem>
+#include <span>
+
+// Read only mapping of a whole file.
+// Pages are loaded by the OS when they are first touched, and they stay shared with the file cache.
+class VTCOREUTIL_API MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const std::filesystem::path& filePath);
+	~MappedFile();
+
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	void Close();
+
+	VT_NODISCARD VT_INLINE bool IsValid() const { return m_data != nullptr; }
+	VT_NODISCARD VT_INLINE const uint8_t* GetData() const { return m_data; }
+	VT_NODISCARD VT_INLINE size_t GetSize() const { return m_size; }
+
+	// Reads the pages of a part of a mapping into memory on the calling thread, so that later reads from other threads don't wait on the disk.
+	static void PageIn(std::span<const uint8_t> mappedData);
+
+private:
+	const uint8_t* m_data = nullptr;
+	size_t m_size = 0;
+
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+};
@@ -1,5 +1,17 @@
 #pragma once
 
+// Stored in the compression encoding header in front of every binary stream file.
+enum class StreamCompressionEncoding : uint8_t
+{
+	None = 0,
+
+	// A single zlib stream, only written by older versions.
+	Deflate = 1,
+
+	// Independently compressed blocks, see BlockCompression.
+	Blocks = 2
+};
+
 struct TypeHeader
 {
 	uint32_t totalTypeSize;
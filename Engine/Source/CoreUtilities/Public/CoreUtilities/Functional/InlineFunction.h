@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreUtilities/CompilerTraits.h"
+#include "CoreUtilities/VoltAssert.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename Signature, size_t Capacity>
+class InlineFunction;
+
+// Move only callable which stores the callable inside of a fixed size buffer, it never allocates.
+// Callables larger than the capacity are rejected at compile time.
+template<typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity>
+{
+public:
+	InlineFunction() = default;
+	InlineFunction(std::nullptr_t) {}
+
+	template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineFunction> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+	InlineFunction(F&& func)
+	{
+		Construct(std::forward<F>(func));
+	}
+
+	InlineFunction(InlineFunction&& other) noexcept
+	{
+		MoveFrom(other);
+	}
+
+	~InlineFunction()
+	{
+		Reset();
+	}
+
+	InlineFunction(const InlineFunction&) = delete;
+	InlineFunction& operator=(const InlineFunction&) = delete;
+
+	InlineFunction& operator=(InlineFunction&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Reset();
+			MoveFrom(other);
+		}
+
+		return *this;
+	}
+
+	InlineFunction& operator=(std::nullptr_t)
+	{
+		Reset();
+		return *this;
+	}
+
+	template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineFunction> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+	InlineFunction& operator=(F&& func)
+	{
+		Reset();
+		Construct(std::forward<F>(func));
+		return *this;
+	}
+
+	R operator()(Args... args)
+	{
+		VT_ENSURE(m_operations);
+		return m_operations->invoke(m_storage, std::forward<Args>(args)...);
+	}
+
+	void Reset()
+	{
+		if (m_operations)
+		{
+			m_operations->destroy(m_storage);
+			m_operations = nullptr;
+		}
+	}
+
+	inline explicit operator bool() const { return m_operations != nullptr; }
+
+	inline static constexpr size_t GetCapacity() { return Capacity; }
+
+private:
+	struct Operations
+	{
+		R(*invoke)(void* storage, Args&&... args);
+		void(*move)(void* destination, void* source);
+		void(*destroy)(void* storage);
+	};
+
+	template<typename F>
+	struct OperationsFor
+	{
+		static R Invoke(void* storage, Args&&... args)
+		{
+			return (*static_cast<F*>(storage))(std::forward<Args>(args)...);
+		}
+
+		static void Move(void* destination, void* source)
+		{
+			new (destination) F(std::move(*static_cast<F*>(source)));
+			static_cast<F*>(source)->~F();
+		}
+
+		static void Destroy(void* storage)
+		{
+			static_cast<F*>(storage)->~F();
+		}
+
+		inline static constexpr Operations s_operations{ &Invoke, &Move, &Destroy };
+	};
+
+	template<typename F>
+	void Construct(F&& func)
+	{
+		using FuncType = std::decay_t<F>;
+
+		static_assert(sizeof(FuncType) <= Capacity, "Callable is too large for the inline storage, capture less or capture a pointer to the data instead!");
+		static_assert(alignof(FuncType) <= MIN_PLATFORM_ALIGNMENT, "Callable is over aligned for the inline storage!");
+		static_assert(std::is_move_constructible_v<FuncType>, "Callable must be move constructible!");
+
+		new (m_storage) FuncType(std::forward<F>(func));
+		m_operations = &OperationsFor<FuncType>::s_operations;
+	}
+
+	void MoveFrom(InlineFunction& other)
+	{
+		if (other.m_operations)
+		{
+			other.m_operations->move(m_storage, other.m_storage);
+			m_operations = other.m_operations;
+			other.m_operations = nullptr;
+		}
+	}
+
+	alignas(MIN_PLATFORM_ALIGNMENT) std::byte m_storage[Capacity];
+	const Operations* m_operations = nullptr;
+};
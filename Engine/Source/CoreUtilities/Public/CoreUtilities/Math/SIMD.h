@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreUtilities/CompilerTraits.h"
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+// The instruction set is picked from the compiler target, AVX2 when building with /arch:AVX2.
+// Define VT_SIMD_FORCE_SCALAR to fall back to plain floats.
+#if defined(VT_SIMD_FORCE_SCALAR)
+	#define VT_SIMD_SCALAR
+#elif defined(__AVX2__)
+	#define VT_SIMD_AVX2
+	#include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__)
+	#define VT_SIMD_SSE
+	#include <emmintrin.h>
+#elif defined(_M_ARM64) || defined(__ARM_NEON)
+	#define VT_SIMD_NEON
+	#include <arm_neon.h>
+#else
+	#define VT_SIMD_SCALAR
+#endif
+
+// Thin wrappers over a float register, so kernels can be written once for every instruction set.
+// Loads and stores are unaligned.
+namespace SIMD
+{
+#if defined(VT_SIMD_AVX2)
+	using FloatV = __m256;
+	inline static constexpr uint32_t Width = 8;
+
+	VT_INLINE FloatV Load(const float* data) { return _mm256_loadu_ps(data); }
+	VT_INLINE void Store(float* data, FloatV value) { _mm256_storeu_ps(data, value); }
+	VT_INLINE FloatV Set(float value) { return _mm256_set1_ps(value); }
+
+	VT_INLINE FloatV Add(FloatV lhs, FloatV rhs) { return _mm256_add_ps(lhs, rhs); }
+	VT_INLINE FloatV Sub(FloatV lhs, FloatV rhs) { return _mm256_sub_ps(lhs, rhs); }
+	VT_INLINE FloatV Mul(FloatV lhs, FloatV rhs) { return _mm256_mul_ps(lhs, rhs); }
+	VT_INLINE FloatV Div(FloatV lhs, FloatV rhs) { return _mm256_div_ps(lhs, rhs); }
+	VT_INLINE FloatV Min(FloatV lhs, FloatV rhs) { return _mm256_min_ps(lhs, rhs); }
+	VT_INLINE FloatV Max(FloatV lhs, FloatV rhs) { return _mm256_max_ps(lhs, rhs); }
+	VT_INLINE FloatV Sqrt(FloatV value) { return _mm256_sqrt_ps(value); }
+#elif defined(VT_SIMD_SSE)
+	using FloatV = __m128;
+	inline static constexpr uint32_t Width = 4;
+
+	VT_INLINE FloatV Load(const float* data) { return _mm_loadu_ps(data); }
+	VT_INLINE void Store(float* data, FloatV value) { _mm_storeu_ps(data, value); }
+	VT_INLINE FloatV Set(float value) { return _mm_set1_ps(value); }
+
+	VT_INLINE FloatV Add(FloatV lhs, FloatV rhs) { return _mm_add_ps(lhs, rhs); }
+	VT_INLINE FloatV Sub(FloatV lhs, FloatV rhs) { return _mm_sub_ps(lhs, rhs); }
+	VT_INLINE FloatV Mul(FloatV lhs, FloatV rhs) { return _mm_mul_ps(lhs, rhs); }
+	VT_INLINE FloatV Div(FloatV lhs, FloatV rhs) { return _mm_div_ps(lhs, rhs); }
+	VT_INLINE FloatV Min(FloatV lhs, FloatV rhs) { return _mm_min_ps(lhs, rhs); }
+	VT_INLINE FloatV Max(FloatV lhs, FloatV rhs) { return _mm_max_ps(lhs, rhs); }
+	VT_INLINE FloatV Sqrt(FloatV value) { return _mm_sqrt_ps(value); }
+#elif defined(VT_SIMD_NEON)
+	using FloatV = float32x4_t;
+	inline static constexpr uint32_t Width = 4;
+
+	VT_INLINE FloatV Load(const float* data) { return vld1q_f32(data); }
+	VT_INLINE void Store(float* data, FloatV value) { vst1q_f32(data, value); }
+	VT_INLINE FloatV Set(float value) { return vdupq_n_f32(value); }
+
+	VT_INLINE FloatV Add(FloatV lhs, FloatV rhs) { return vaddq_f32(lhs, rhs); }
+	VT_INLINE FloatV Sub(FloatV lhs, FloatV rhs) { return vsubq_f32(lhs, rhs); }
+	VT_INLINE FloatV Mul(FloatV lhs, FloatV rhs) { return vmulq_f32(lhs, rhs); }
+	VT_INLINE FloatV Div(FloatV lhs, FloatV rhs) { return vdivq_f32(lhs, rhs); }
+	VT_INLINE FloatV Min(FloatV lhs, FloatV rhs) { return vminq_f32(lhs, rhs); }
+	VT_INLINE FloatV Max(FloatV lhs, FloatV rhs) { return vmaxq_f32(lhs, rhs); }
+	VT_INLINE FloatV Sqrt(FloatV value) { return vsqrtq_f32(value); }
+#else
+	using FloatV = float;
+	inline static constexpr uint32_t Width = 1;
+
+	VT_INLINE FloatV Load(const float* data) { return *data; }
+	VT_INLINE void Store(float* data, FloatV value) { *data = value; }
+	VT_INLINE FloatV Set(float value) { return value; }
+
+	VT_INLINE FloatV Add(FloatV lhs, FloatV rhs) { return lhs + rhs; }
+	VT_INLINE FloatV Sub(FloatV lhs, FloatV rhs) { return lhs - rhs; }
+	VT_INLINE FloatV Mul(FloatV lhs, FloatV rhs) { return lhs * rhs; }
+	VT_INLINE FloatV Div(FloatV lhs, FloatV rhs) { return lhs / rhs; }
+	VT_INLINE FloatV Min(FloatV lhs, FloatV rhs) { return std::min(lhs, rhs); }
+	VT_INLINE FloatV Max(FloatV lhs, FloatV rhs) { return std::max(lhs, rhs); }
+	VT_INLINE FloatV Sqrt(FloatV value) { return std::sqrt(value); }
+#endif
+
+	// lhs * rhs + addend
+	VT_INLINE FloatV MulAdd(FloatV lhs, FloatV rhs, FloatV addend) { return Add(Mul(lhs, rhs), addend); }
+
+	VT_INLINE FloatV Clamp(FloatV value, FloatV min, FloatV max) { return Min(Max(value, min), max); }
+
+	// Rounds a count up to a whole number of registers.
+	VT_NODISCARD VT_INLINE constexpr uint32_t AlignToWidth(uint32_t count)
+	{
+		return (count + Width - 1) / Width * Width;
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreUtilities/Core.h"
+#include "CoreUtilities/Containers/Vector.h"
+
+#include <span>
+#include <type_traits>
+
+// Bump allocator for short lived scratch memory, meant to be owned by a single thread.
+// Allocations are valid until Reset. The arena grows to fit the largest use between resets,
+// after which it settles into a single block and stops allocating.
+class ScratchArena
+{
+public:
+	inline static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+	ScratchArena() = default;
+	~ScratchArena() = default;
+
+	VT_DELETE_COPY_MOVE(ScratchArena);
+
+	// The memory is left uninitialized.
+	template<typename T>
+	VT_NODISCARD std::span<T> Allocate(size_t count);
+
+	void Reset()
+	{
+		// Several blocks means the arena ran out of space, so they are merged into one large enough for all of them.
+		if (m_blocks.size() > 1)
+		{
+			size_t totalSize = 0;
+			for (const auto& block : m_blocks)
+			{
+				totalSize += block.size;
+			}
+
+			m_blocks.clear();
+			AddBlock(totalSize);
+		}
+
+		m_offset = 0;
+	}
+
+private:
+	struct Block
+	{
+		Scope<std::byte[]> memory;
+		size_t size;
+	};
+
+	void AddBlock(size_t size)
+	{
+		auto& block = m_blocks.emplace_back();
+		block.memory = Scope<std::byte[]>{ new std::byte[size] };
+		block.size = size;
+
+		m_offset = 0;
+	}
+
+	Vector<Block> m_blocks;
+	size_t m_offset = 0;
+};
+
+template<typename T>
+inline std::span<T> ScratchArena::Allocate(size_t count)
+{
+	static_assert(std::is_trivially_destructible_v<T>, "Scratch allocations are never destroyed!");
+
+	const size_t size = sizeof(T) * count;
+
+	if (!m_blocks.empty())
+	{
+		const Block& block = m_blocks.back();
+		const uintptr_t blockAddress = reinterpret_cast<uintptr_t>(block.memory.get());
+		const size_t alignedOffset = ((blockAddress + m_offset + alignof(T) - 1) & ~(alignof(T) - 1)) - blockAddress;
+
+		if (alignedOffset + size <= block.size)
+		{
+			m_offset = alignedOffset + size;
+			return { reinterpret_cast<T*>(block.memory.get() + alignedOffset), count };
+		}
+	}
+
+	// New blocks come from operator new, which is aligned enough for anything but over-aligned types.
+	static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+	AddBlock(std::max(size, DEFAULT_BLOCK_SIZE));
+	m_offset = size;
+
+	return { reinterpret_cast<T*>(m_blocks.back().memory.get()), count };
+}
@@ -3,6 +3,7 @@
 #include "CoreUtilities/Config.h"
 
 #include <thread>
+#include <functional>
 
 enum class ThreadPriority : uint8_t
 {
@@ -17,4 +18,11 @@ namespace Thread
 	extern VTCOREUTIL_API void SetThreadPriority(std::thread::native_handle_type threadHandle, ThreadPriority priority);
 	extern VTCOREUTIL_API void AssignThreadToCore(std::thread::native_handle_type threadHandle, uint64_t affinityMask);
 	extern VTCOREUTIL_API std::thread::native_handle_type GetCurrentThreadHandle();
+
+	using ParallelForFunction = void(*)(size_t count, const std::function<void(size_t)>& func);
+
+	// Lets code below the job system run work in parallel, the job system registers itself here.
+	// Runs func(index) for every index in [0, count) serially until a function has been registered.
+	extern VTCOREUTIL_API void SetParallelForFunction(ParallelForFunction function);
+	extern VTCOREUTIL_API void ParallelFor(size_t count, const std::function<void(size_t)>& func);
 }
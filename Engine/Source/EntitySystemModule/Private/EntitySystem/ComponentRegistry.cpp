@@ -71,6 +71,21 @@ namespace Volt
 		return componentRegistry.m_componentHelperFunctions.at(guid).getComponent(registry, entity);
 	}
 
+	void ComponentRegistry::Helpers::GetOrAddComponentsWithGUID(const VoltGUID& guid, entt::registry& registry, std::span<const entt::entity> entities, std::span<void*> outComponents)
+	{
+		ComponentRegistry& componentRegistry = GetComponentRegistry();
+		VT_ENSURE(componentRegistry.m_componentHelperFunctions.contains(guid));
+		VT_ENSURE(outComponents.size() >= entities.size());
+		componentRegistry.m_componentHelperFunctions.at(guid).getOrAddComponents(registry, entities, outComponents);
+	}
+
+	void ComponentRegistry::Helpers::InsertComponentsWithGUID(const VoltGUID& guid, entt::registry& registry, std::span<const entt::entity> entities, const void* components)
+	{
+		ComponentRegistry& componentRegistry = GetComponentRegistry();
+		VT_ENSURE(componentRegistry.m_componentHelperFunctions.contains(guid));
+		componentRegistry.m_componentHelperFunctions.at(guid).insertComponents(registry, entities, components);
+	}
+
 	void ComponentRegistry::Helpers::SetupComponentCallbacks(entt::registry& registry)
 	{
 		ComponentRegistry& componentRegistry = GetComponentRegistry();
@@ -0,0 +1,204 @@
+#include "espch.h"
+
+#include "EntitySystem/EntityCommandBuffer.h"
+#include "EntitySystem/EntityScene.h"
+#include "EntitySystem/EntityHelper.h"
+
+namespace Volt
+{
+	namespace Utility
+	{
+		static thread_local EntityCommandBufferScope* s_currentCommandBufferScope = nullptr;
+	}
+
+	DeferredEntity EntityCommandBuffer::CreateEntity(const std::string& tag)
+	{
+		const uint32_t pendingIndex = static_cast<uint32_t>(m_pendingEntityTags.size());
+		m_pendingEntityTags.emplace_back(tag);
+
+		return DeferredEntity(pendingIndex, true);
+	}
+
+	void EntityCommandBuffer::DestroyEntity(const DeferredEntity& entity)
+	{
+		m_commands.emplace_back(Command{ CommandType::Destroy, entity, nullptr });
+	}
+
+	void EntityCommandBuffer::Playback(EntityScene& scene)
+	{
+		VT_PROFILE_FUNCTION();
+
+		const EntityCommandPlaybackCallbacks& callbacks = scene.GetCommandPlaybackCallbacks();
+
+		// All entities created by this buffer are created up front. They are new, so no other command can depend on them not existing yet.
+		Vector<EntityHelper> pendingEntities;
+		if (!m_pendingEntityTags.empty())
+		{
+			pendingEntities = callbacks.createEntities ? callbacks.createEntities(m_pendingEntityTags.size()) : scene.CreateEntities(m_pendingEntityTags.size());
+			VT_ENSURE(pendingEntities.size() == m_pendingEntityTags.size());
+		}
+
+		for (size_t i = 0; i < pendingEntities.size(); i++)
+		{
+			if (!m_pendingEntityTags.at(i).empty())
+			{
+				pendingEntities.at(i).SetTag(m_pendingEntityTags.at(i));
+			}
+		}
+
+		// Consecutive destroys are made in one go, but always before the next component command, which keeps the recording order.
+		Vector<EntityID> entitiesToDestroy;
+		auto destroyEntities = [&]()
+		{
+			if (entitiesToDestroy.empty())
+			{
+				return;
+			}
+
+			if (callbacks.destroyEntities)
+			{
+				callbacks.destroyEntities(entitiesToDestroy);
+			}
+			else
+			{
+				scene.DestroyEntities(entitiesToDestroy);
+			}
+
+			entitiesToDestroy.clear();
+		};
+
+		for (auto& command : m_commands)
+		{
+			const EntityHelper entity = command.entity.IsPending() ? pendingEntities.at(command.entity.m_pendingIndex) : scene.GetEntityHelperFromEntityID(command.entity.GetID());
+
+			switch (command.type)
+			{
+				case CommandType::Destroy:
+					if (entity.IsValid())
+					{
+						entitiesToDestroy.emplace_back(entity.GetID());
+					}
+					break;
+
+				case CommandType::Component:
+					destroyEntities();
+
+					// The entity might have been destroyed by an earlier command.
+					if (entity.IsValid())
+					{
+						command.componentFunc(scene.GetRegistry(), entity.GetHandle());
+					}
+					break;
+			}
+		}
+
+		destroyEntities();
+		Clear();
+	}
+
+	void EntityCommandBuffer::Clear()
+	{
+		m_commands.clear();
+		m_pendingEntityTags.clear();
+	}
+
+	EntityCommandBuffer& EntityCommandBufferPool::Acquire(uint64_t sortKey)
+	{
+		std::scoped_lock lock{ m_mutex };
+		return AcquireInternal(sortKey);
+	}
+
+	EntityCommandBuffer& EntityCommandBufferPool::AcquireForCurrentThread()
+	{
+		std::scoped_lock lock{ m_mutex };
+
+		const std::thread::id threadId = std::this_thread::get_id();
+		if (auto it = m_threadBuffers.find(threadId); it != m_threadBuffers.end())
+		{
+			return *it->second;
+		}
+
+		EntityCommandBuffer& buffer = AcquireInternal(UNSCOPED_SORT_KEY);
+		m_threadBuffers[threadId] = &buffer;
+
+		return buffer;
+	}
+
+	void EntityCommandBufferPool::Playback(EntityScene& scene)
+	{
+		VT_PROFILE_FUNCTION();
+
+		// The buffers are played back without holding the lock, as playback might record new commands.
+		Vector<PooledBuffer> buffersToPlayback;
+		{
+			std::scoped_lock lock{ m_mutex };
+			buffersToPlayback.swap(m_activeBuffers);
+			m_threadBuffers.clear();
+		}
+
+		if (buffersToPlayback.empty())
+		{
+			return;
+		}
+
+		std::stable_sort(buffersToPlayback.begin(), buffersToPlayback.end(), [](const PooledBuffer& lhs, const PooledBuffer& rhs)
+		{
+			return lhs.sortKey < rhs.sortKey;
+		});
+
+		for (auto& pooledBuffer : buffersToPlayback)
+		{
+			pooledBuffer.buffer->Playback(scene);
+		}
+
+		std::scoped_lock lock{ m_mutex };
+		for (auto& pooledBuffer : buffersToPlayback)
+		{
+			m_freeBuffers.emplace_back(std::move(pooledBuffer.buffer));
+		}
+	}
+
+	EntityCommandBuffer& EntityCommandBufferPool::AcquireInternal(uint64_t sortKey)
+	{
+		Scope<EntityCommandBuffer> buffer;
+		if (m_freeBuffers.empty())
+		{
+			buffer = CreateScope<EntityCommandBuffer>();
+		}
+		else
+		{
+			buffer = std::move(m_freeBuffers.back());
+			m_freeBuffers.pop_back();
+		}
+
+		return *m_activeBuffers.emplace_back(PooledBuffer{ std::move(buffer), sortKey }).buffer;
+	}
+
+	EntityCommandBufferScope::EntityCommandBufferScope(EntityScene& scene, uint64_t sortKey)
+		: m_scene(scene), m_sortKey(sortKey), m_previousScope(Utility::s_currentCommandBufferScope)
+	{
+		Utility::s_currentCommandBufferScope = this;
+	}
+
+	EntityCommandBufferScope::~EntityCommandBufferScope()
+	{
+		VT_ENSURE(Utility::s_currentCommandBufferScope == this);
+		Utility::s_currentCommandBufferScope = m_previousScope;
+	}
+
+	EntityCommandBuffer* EntityCommandBufferScope::GetBoundBuffer(EntityScene& scene)
+	{
+		EntityCommandBufferScope* scope = Utility::s_currentCommandBufferScope;
+		if (!scope || &scope->m_scene != &scene)
+		{
+			return nullptr;
+		}
+
+		if (!scope->m_buffer)
+		{
+			scope->m_buffer = &scene.m_commandBufferPool.Acquire(scope->m_sortKey);
+		}
+
+		return scope->m_buffer;
+	}
+}
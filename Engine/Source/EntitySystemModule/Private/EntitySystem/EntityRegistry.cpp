@@ -27,6 +27,12 @@ namespace Volt
 		m_handleMap.emplace(entity.GetHandle(), entity.GetID());
 	}
 
+	void EntityRegistry::Reserve(size_t entityCount)
+	{
+		m_entityMap.reserve(entityCount);
+		m_handleMap.reserve(entityCount);
+	}
+
 	void EntityRegistry::RemoveEntity(const EntityID& entityId, entt::entity entityHandle)
 	{
 		if (m_entityMap.contains(entityId))
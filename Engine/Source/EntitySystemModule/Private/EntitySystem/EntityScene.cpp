@@ -15,6 +15,7 @@
 #include <CoreUtilities/Time/TimeUtility.h>
 
 #include <ranges>
+#include <unordered_set>
 
 namespace Volt
 {
@@ -54,13 +55,27 @@ namespace Volt
 	void EntityScene::Update(float deltaTime)
 	{
 		VT_PROFILE_FUNCTION();
+		SortSceneIfDirty();
+		UpdateTransformCache();
+
 		m_ecsBuilder->GetGameLoop(GameLoop::Variable).Execute(*this, deltaTime);
+		PlaybackCommandBuffers();
+
+		// Entities moved by the systems are reported before the frame is rendered or simulated.
+		UpdateTransformCache();
 	}
 
 	void EntityScene::FixedUpdate(float deltaTime)
 	{
 		VT_PROFILE_FUNCTION();
+		SortSceneIfDirty();
+		UpdateTransformCache();
+
 		m_ecsBuilder->GetGameLoop(GameLoop::Fixed).Execute(*this, deltaTime);
+		PlaybackCommandBuffers();
+
+		// Entities moved by the systems are reported before the frame is rendered or simulated.
+		UpdateTransformCache();
 	}
 
 	void EntityScene::SortScene()
@@ -72,15 +87,27 @@ namespace Volt
 
 			return lhsComp.timeCreatedID < rhsComp.timeCreatedID;
 		});
+
+		m_isSceneSorted = true;
 	}
 
 	void EntityScene::ClearScene()
 	{
 		m_registry.clear();
+		m_isSceneSorted = true;
+	}
+
+	void EntityScene::SortSceneIfDirty()
+	{
+		if (!m_isSceneSorted)
+		{
+			SortScene();
+		}
 	}
 
 	EntityHelper EntityScene::CreateEntity(const std::string& tag)
 	{
+		const size_t firstNewEntityIndex = m_registry.storage<CommonComponent>().size();
 		entt::entity entityHandle = m_registry.create();
 
 		EntityHelper newHelper(entityHandle, this);
@@ -118,7 +145,7 @@ namespace Volt
 		m_entityRegistry.MarkEntityAsEdited(newHelper);
 		
 		InvalidateEntityTransform(newHelper.GetID());
-		SortScene();
+		SortSceneIfNeeded(firstNewEntityIndex);
 		return newHelper;
 	}
 
@@ -126,6 +153,7 @@ namespace Volt
 	{
 		VT_ENSURE(!m_entityRegistry.Contains(id));
 
+		const size_t firstNewEntityIndex = m_registry.storage<CommonComponent>().size();
 		entt::entity entityHandle = m_registry.create();
 
 		EntityHelper newHelper(entityHandle, this);
@@ -159,10 +187,20 @@ namespace Volt
 		m_entityRegistry.AddEntity(newHelper);
 
 		InvalidateEntityTransform(newHelper.GetID());
-		SortScene();
+		SortSceneIfNeeded(firstNewEntityIndex);
 		return newHelper;
 	}
 
+	Vector<EntityHelper> EntityScene::CreateEntities(size_t count, const std::string& tag)
+	{
+		return CreateEntitiesInternal(count, nullptr, tag);
+	}
+
+	Vector<EntityHelper> EntityScene::CreateEntitiesWithIDs(const Vector<EntityID>& ids, const std::string& tag)
+	{
+		return CreateEntitiesInternal(ids.size(), ids.data(), tag);
+	}
+
 	void EntityScene::DestroyEntity(EntityID id, bool isDestroyingChildFromParent)
 	{
 		if (!IsEntityValid(id))
@@ -203,74 +241,116 @@ namespace Volt
 
 		m_registry.destroy(helper.GetHandle());
 		m_entityRegistry.RemoveEntity(id, helper.GetHandle());
-	}
-
-	void EntityScene::MarkEntityAsEdited(const EntityHelper& entityHelper)
-	{
-		m_entityRegistry.MarkEntityAsEdited(entityHelper);
-	}
+		m_transformCache.InvalidateHierarchy();
 
-	void EntityScene::ClearEditedEntities()
-	{
-		m_entityRegistry.ClearEditedEntities();
+		// Destroying swaps the last entity into the hole, which breaks the creation order.
+		m_isSceneSorted = false;
 	}
 
-	Vector<EntityID> EntityScene::InvalidateEntityTransform(EntityID entityId)
+	void EntityScene::DestroyEntities(const Vector<EntityID>& ids)
 	{
-		Vector<EntityID> invalidatedEntities;
-		invalidatedEntities.reserve(10);
+		VT_PROFILE_FUNCTION();
 
+		std::unordered_set<EntityID> destroyedIds;
+		Vector<EntityID> idsToDestroy;
+		Vector<entt::entity> handlesToDestroy;
 		Vector<EntityID> entityStack;
-		entityStack.reserve(10);
-		entityStack.push_back(entityId);
 
-		while (!entityStack.empty())
+		for (const auto& id : ids)
 		{
-			const EntityID currentId = entityStack.back();
-			entityStack.pop_back();
-
-			EntityHelper entityHelper(m_entityRegistry.GetHandleFromID(currentId), this);
-
-			VT_ENSURE(entityHelper.HasComponent<RelationshipComponent>());
-		
-			auto& relationshipComponent = entityHelper.GetComponent<RelationshipComponent>();
+			if (destroyedIds.contains(id) || !IsEntityValid(id))
+			{
+				continue;
+			}
 
-			m_transformCache.InvalidateTransform(currentId);
+			entityStack.emplace_back(id);
 
-			// Call on transform changed on all components on entity
-			for (auto&& curr : m_registry.storage())
+			while (!entityStack.empty())
 			{
-				auto& storage = curr.second;
-				std::string_view typeName = storage.type().name();
+				const EntityID currentId = entityStack.back();
+				entityStack.pop_back();
 
-				const ICommonTypeDesc* typeDesc = GetComponentRegistry().GetTypeDescFromName(typeName);
-				if (!typeDesc)
+				if (!destroyedIds.insert(currentId).second)
 				{
 					continue;
 				}
 
-				if (typeDesc->GetValueType() != ValueType::Component)
-				{
-					continue;
-				}
-
-				const IComponentTypeDesc* compTypeDesc = reinterpret_cast<const IComponentTypeDesc*>(typeDesc);
+				const entt::entity handle = m_entityRegistry.GetHandleFromID(currentId);
+				VT_ENSURE(m_registry.all_of<RelationshipComponent>(handle));
 
-				if (storage.contains(entityHelper.GetHandle()))
+				for (const auto& child : m_registry.get<RelationshipComponent>(handle).children)
 				{
-					compTypeDesc->OnTransformChanged(entityHelper);
+					entityStack.emplace_back(child);
 				}
+
+				idsToDestroy.emplace_back(currentId);
+				handlesToDestroy.emplace_back(handle);
 			}
+		}
+
+		if (handlesToDestroy.empty())
+		{
+			return;
+		}
 
-			for (const auto& child : relationshipComponent.children)
+		// Only parents that are left alive have to forget about their children.
+		for (size_t i = 0; i < handlesToDestroy.size(); i++)
+		{
+			const EntityID parentId = m_registry.get<RelationshipComponent>(handlesToDestroy[i]).parent;
+			if (parentId == EntityID::Null() || destroyedIds.contains(parentId) || !IsEntityValid(parentId))
 			{
-				entityStack.push_back(child);
+				continue;
 			}
 
-			invalidatedEntities.emplace_back(currentId);
+			const EntityID id = idsToDestroy[i];
+			m_registry.get<RelationshipComponent>(m_entityRegistry.GetHandleFromID(parentId)).children.erase_with_predicate([id](EntityID childId)
+			{
+				return childId == id;
+			});
 		}
 
-		return invalidatedEntities;
+		m_registry.destroy(handlesToDestroy.begin(), handlesToDestroy.end());
+
+		for (size_t i = 0; i < handlesToDestroy.size(); i++)
+		{
+			m_entityRegistry.RemoveEntity(idsToDestroy[i], handlesToDestroy[i]);
+		}
+
+		m_transformCache.InvalidateHierarchy();
+		m_isSceneSorted = false;
+	}
+
+	EntityCommandBuffer& EntityScene::GetCommandBuffer()
+	{
+		if (EntityCommandBuffer* boundBuffer = EntityCommandBufferScope::GetBoundBuffer(*this))
+		{
+			return *boundBuffer;
+		}
+
+		// Without a sort key the playback order would depend on which thread recorded first.
+		VT_ENSURE_MSG(false, "Command buffers must be recorded inside an EntityCommandBufferScope!");
+		return m_commandBufferPool.AcquireForCurrentThread();
+	}
+
+	void EntityScene::PlaybackCommandBuffers()
+	{
+		m_commandBufferPool.Playback(*this);
+	}
+
+	void EntityScene::MarkEntityAsEdited(const EntityHelper& entityHelper)
+	{
+		m_entityRegistry.MarkEntityAsEdited(entityHelper);
+	}
+
+	void EntityScene::ClearEditedEntities()
+	{
+		m_entityRegistry.ClearEditedEntities();
+	}
+
+	void EntityScene::InvalidateEntityTransform(EntityID entityId)
+	{
+		// Children are marked as dirty through their parent when the cache is read or updated.
+		m_transformCache.InvalidateTransform(m_entityRegistry.GetHandleFromID(entityId));
 	}
 
 	bool EntityScene::IsEntityValid(EntityID entityId) const
@@ -278,35 +358,87 @@ namespace Volt
 		return m_registry.valid(m_entityRegistry.GetHandleFromID(entityId));
 	}
 
+	void EntityScene::UpdateTransformCache()
+	{
+		VT_PROFILE_FUNCTION();
+
+		m_transformCache.Update(m_registry, m_entityRegistry);
+
+		const auto& movedEntities = m_transformCache.GetMovedEntities();
+		if (movedEntities.empty())
+		{
+			return;
+		}
+
+		// Call on transform changed on all components of the moved entities, looking up every storage once
+		for (auto&& curr : m_registry.storage())
+		{
+			auto& storage = curr.second;
+
+			const ICommonTypeDesc* typeDesc = GetComponentRegistry().GetTypeDescFromName(storage.type().name());
+			if (!typeDesc || typeDesc->GetValueType() != ValueType::Component)
+			{
+				continue;
+			}
+
+			const IComponentTypeDesc* compTypeDesc = reinterpret_cast<const IComponentTypeDesc*>(typeDesc);
+
+			for (const auto& entity : movedEntities)
+			{
+				if (storage.contains(entity))
+				{
+					compTypeDesc->OnTransformChanged(EntityHelper(entity, this));
+				}
+			}
+		}
+
+		if (m_transformsChangedCallback)
+		{
+			m_transformsChangedCallback(movedEntities);
+		}
+	}
+
 	TQS EntityScene::GetEntityWorldTQS(const EntityHelper& entityHelper) const
 	{
-		if (m_transformCache.HasCachedTransform(entityHelper.GetID()))
+		TQS cachedTransform{};
+		if (m_transformCache.TryGetWorldTransform(m_registry, entityHelper.GetHandle(), cachedTransform))
 		{
-			return m_transformCache.GetCachedTransform(entityHelper.GetID());
+			return cachedTransform;
 		}
 
-		Vector<EntityHelper> hierarchy{};
-		hierarchy.emplace_back(entityHelper);
+		return CalculateEntityWorldTQS(entityHelper);
+	}
+
+	TQS EntityScene::CalculateEntityWorldTQS(const EntityHelper& entityHelper) const
+	{
+		// Only entities that are new since the last cache update get here, so the walk stops at the first parent the cache knows.
+		const auto& transformComp = m_registry.get<TransformComponent>(entityHelper.GetHandle());
+		TQS resultTransform{ transformComp.position, transformComp.rotation, transformComp.scale };
 
 		EntityHelper currentEntity = entityHelper;
 		while (currentEntity.HasParent())
 		{
-			auto parent = currentEntity.GetParent();
-			hierarchy.emplace_back(parent);
-			currentEntity = parent;
-		}
+			currentEntity = currentEntity.GetParent();
 
-		TQS resultTransform{};
-		for (const auto& ent : std::ranges::reverse_view(hierarchy))
-		{
-			const auto& transformComp = m_registry.get<TransformComponent>(ent.GetHandle());
+			TQS parentTransform{};
+			const bool isParentCached = m_transformCache.TryGetWorldTransform(m_registry, currentEntity.GetHandle(), parentTransform);
 
-			resultTransform.translation = resultTransform.translation + resultTransform.rotation * transformComp.position;
-			resultTransform.rotation = resultTransform.rotation * transformComp.rotation;
-			resultTransform.scale = resultTransform.scale * transformComp.scale;
+			if (!isParentCached)
+			{
+				const auto& parentTransformComp = m_registry.get<TransformComponent>(currentEntity.GetHandle());
+				parentTransform = { parentTransformComp.position, parentTransformComp.rotation, parentTransformComp.scale };
+			}
+
+			resultTransform.translation = parentTransform.translation + parentTransform.rotation * resultTransform.translation;
+			resultTransform.rotation = parentTransform.rotation * resultTransform.rotation;
+			resultTransform.scale = parentTransform.scale * resultTransform.scale;
+
+			if (isParentCached)
+			{
+				break;
+			}
 		}
 
-		m_transformCache.CacheTransform(entityHelper.GetID(), resultTransform);
 		return resultTransform;
 	}
 
@@ -346,6 +478,100 @@ namespace Volt
 		m_ecsBuilder->Compile();
 	}
 
+	Vector<EntityHelper> EntityScene::CreateEntitiesInternal(size_t count, const EntityID* ids, const std::string& tag)
+	{
+		VT_PROFILE_FUNCTION();
+
+		Vector<EntityHelper> result;
+		if (count == 0)
+		{
+			return result;
+		}
+
+		auto& commonStorage = m_registry.storage<CommonComponent>();
+		const size_t firstNewEntityIndex = commonStorage.size();
+
+		Vector<entt::entity> entityHandles(count);
+		m_registry.create(entityHandles.begin(), entityHandles.end());
+
+		m_registry.storage<TransformComponent>().reserve(m_registry.storage<TransformComponent>().size() + count);
+		m_registry.storage<TagComponent>().reserve(m_registry.storage<TagComponent>().size() + count);
+		m_registry.storage<IDComponent>().reserve(m_registry.storage<IDComponent>().size() + count);
+		m_registry.storage<RelationshipComponent>().reserve(m_registry.storage<RelationshipComponent>().size() + count);
+		commonStorage.reserve(firstNewEntityIndex + count);
+		m_entityRegistry.Reserve(m_registry.storage<IDComponent>().size() + count);
+
+		// Setup default components
+		{
+			m_registry.insert<TransformComponent>(entityHandles.begin(), entityHandles.end(), TransformComponent{});
+
+			TagComponent tagComponent{};
+			tagComponent.tag = tag.empty() ? "New Entity" : tag;
+			m_registry.insert<TagComponent>(entityHandles.begin(), entityHandles.end(), tagComponent);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				auto& idComponent = m_registry.emplace<IDComponent>(entityHandles[i]);
+				if (ids)
+				{
+					VT_ENSURE(!m_entityRegistry.Contains(ids[i]));
+					idComponent.id = ids[i];
+				}
+				else
+				{
+					while (m_entityRegistry.Contains(idComponent.id))
+					{
+						idComponent.id = {};
+					}
+				}
+
+				// Registering the entity right away also catches duplicate IDs within the batch.
+				m_entityRegistry.AddEntity(EntityHelper(entityHandles[i], this));
+			}
+
+			// All entities of the batch share the creation time, so the batch is in order by construction.
+			CommonComponent commonComponent{};
+			commonComponent.timeCreatedID = TimeUtility::GetTimeSinceEpoch();
+			m_registry.insert<CommonComponent>(entityHandles.begin(), entityHandles.end(), commonComponent);
+
+			m_registry.insert<RelationshipComponent>(entityHandles.begin(), entityHandles.end());
+		}
+
+		result.reserve(count);
+		for (const auto& entityHandle : entityHandles)
+		{
+			EntityHelper& newHelper = result.emplace_back(entityHandle, this);
+
+			if (!ids)
+			{
+				m_entityRegistry.MarkEntityAsEdited(newHelper);
+			}
+
+		}
+
+		// New entities have no children and only the default components, so only the cache needs to know about them.
+		m_transformCache.InvalidateHierarchy();
+
+		SortSceneIfNeeded(firstNewEntityIndex);
+		return result;
+	}
+
+	void EntityScene::SortSceneIfNeeded(size_t firstNewEntityIndex)
+	{
+		// New entities are appended to the common storage, so the scene is still sorted as long as
+		// the first new entity was not created before the last existing one.
+		if (m_isSceneSorted && firstNewEntityIndex > 0)
+		{
+			const auto& commonStorage = m_registry.storage<CommonComponent>();
+			const auto& lastExisting = commonStorage.get(commonStorage.data()[firstNewEntityIndex - 1]);
+			const auto& firstNew = commonStorage.get(commonStorage.data()[firstNewEntityIndex]);
+
+			m_isSceneSorted = lastExisting.timeCreatedID <= firstNew.timeCreatedID;
+		}
+
+		SortSceneIfDirty();
+	}
+
 	void EntityScene::ComponentOnStart()
 	{
 		VT_PROFILE_FUNCTION();
@@ -1,29 +1,424 @@
 #include "espch.h"
 
 #include "EntitySystem/EntityTransformCache.h"
+#include "EntitySystem/EntityRegistry.h"
+
+#include "EntitySystem/Scripting/CoreComponents.h"
+
+#include <JobSystem/JobSystem.h>
 
 namespace Volt
 {
-	void EntityTransformCache::CacheTransform(EntityID entityId, const TQS& transform)
+	namespace Utility
 	{
-		WriteLock lock{ m_mutex };
-		m_transformCache[entityId] = transform;
+		VT_INLINE TQS CombineTransforms(const TQS& parentTransform, const TQS& localTransform)
+		{
+			TQS result{};
+			result.translation = parentTransform.translation + parentTransform.rotation * localTransform.translation;
+			result.rotation = parentTransform.rotation * localTransform.rotation;
+			result.scale = parentTransform.scale * localTransform.scale;
+
+			return result;
+		}
+
+		VT_INLINE TQS GetLocalTransform(const TransformComponent& transformComponent)
+		{
+			return { transformComponent.position, transformComponent.rotation, transformComponent.scale };
+		}
 	}
 
-	void EntityTransformCache::InvalidateTransform(EntityID entityId)
+	void EntityTransformCache::Update(const entt::registry& registry, const EntityRegistry& entityRegistry)
 	{
-		WriteLock lock{ m_mutex };
-		if (m_transformCache.contains(entityId))
+		VT_PROFILE_FUNCTION();
+
+		m_movedEntities.clear();
+
+		const bool isHierarchyDirty = m_isHierarchyDirty.exchange(false, std::memory_order_acq_rel);
+		const bool hasDirtyNodes = m_hasDirtyNodes.exchange(false, std::memory_order_acq_rel);
+
+		if (!isHierarchyDirty && !hasDirtyNodes)
 		{
-			m_transformCache.erase(entityId);
+			return;
+		}
+
+		if (isHierarchyDirty)
+		{
+			RebuildHierarchy(registry, entityRegistry);
+		}
+
+		const uint32_t nodeCount = static_cast<uint32_t>(m_nodeHandles.size());
+		const uint32_t rootCount = static_cast<uint32_t>(m_rootNodes.size());
+
+		std::atomic_bool hierarchyChanged = false;
+
+		auto updateRoots = [&](size_t beginRoot, size_t endRoot, Vector<entt::entity>& outMovedEntities)
+		{
+			const uint32_t beginNode = m_rootNodes.at(beginRoot);
+			const uint32_t endNode = endRoot < rootCount ? m_rootNodes.at(endRoot) : nodeCount;
+
+			if (!UpdateNodeRange(registry, beginNode, endNode, outMovedEntities))
+			{
+				hierarchyChanged.store(true, std::memory_order_relaxed);
+			}
+		};
+
+		// Every root subtree is stored contiguously, so the subtrees can be processed independently of each other.
+		if (nodeCount >= MIN_PARALLEL_NODE_COUNT && rootCount > 1)
+		{
+			const size_t grainSize = JobSystem::GetDefaultGrainSize(rootCount);
+			const size_t chunkCount = (rootCount + grainSize - 1) / grainSize;
+
+			Vector<Vector<entt::entity>> chunkMovedEntities(chunkCount);
+
+			JobSystem::ParallelFor(chunkCount, 1, [&](size_t chunkIndex)
+			{
+				const size_t beginRoot = chunkIndex * grainSize;
+				updateRoots(beginRoot, std::min(beginRoot + grainSize, static_cast<size_t>(rootCount)), chunkMovedEntities[chunkIndex]);
+			});
+
+			// Chunks are appended in root order, so the result doesn't depend on scheduling.
+			for (const auto& movedEntities : chunkMovedEntities)
+			{
+				m_movedEntities.insert(m_movedEntities.end(), movedEntities.begin(), movedEntities.end());
+			}
+		}
+		else if (rootCount > 0)
+		{
+			updateRoots(0, rootCount, m_movedEntities);
+		}
+
+		// An entity was parented somewhere else since the last rebuild, its new position in the hierarchy is not known.
+		// The moved flags are carried over by the rebuild, so the moved entities are collected again in the new order.
+		if (hierarchyChanged.load(std::memory_order_relaxed))
+		{
+			RebuildHierarchy(registry, entityRegistry);
+
+			m_movedEntities.clear();
+			UpdateNodeRange(registry, 0, static_cast<uint32_t>(m_nodeHandles.size()), m_movedEntities);
+		}
+
+		if (!m_movedEntities.empty())
+		{
+			for (auto& movedFlag : m_movedFlags)
+			{
+				movedFlag.store(0, std::memory_order_relaxed);
+			}
 		}
 	}
 
-	const TQS& EntityTransformCache::GetCachedTransform(EntityID entityId) const
+	void EntityTransformCache::InvalidateTransform(entt::entity entityHandle)
 	{
-		ReadLock lock{ m_mutex };
+		const uint32_t nodeIndex = GetNodeIndex(entityHandle);
+		if (nodeIndex == INVALID_NODE_INDEX)
+		{
+			// Unknown entities are added by the next rebuild.
+			{
+				std::scoped_lock lock{ m_pendingMovedMutex };
+				m_pendingMovedEntities.emplace_back(entityHandle);
+			}
+
+			InvalidateHierarchy();
+			return;
+		}
+
+		m_movedFlags[nodeIndex].store(1, std::memory_order_relaxed);
+		m_nodeStates[nodeIndex].store(NodeState::Dirty, std::memory_order_release);
+		m_hasDirtyNodes.store(true, std::memory_order_release);
+	}
+
+	bool EntityTransformCache::TryGetWorldTransform(const entt::registry& registry, entt::entity entityHandle, TQS& outTransform) const
+	{
+		const uint32_t nodeIndex = GetNodeIndex(entityHandle);
+		if (nodeIndex == INVALID_NODE_INDEX)
+		{
+			return false;
+		}
+
+		bool wasRecalculated = false;
+		return ResolveNode(registry, nodeIndex, outTransform, wasRecalculated);
+	}
+
+	void EntityTransformCache::RebuildHierarchy(const entt::registry& registry, const EntityRegistry& entityRegistry)
+	{
+		VT_PROFILE_FUNCTION();
+
+		auto view = registry.view<const TransformComponent, const RelationshipComponent>();
+
+		// The moved flags are carried over to the new node order.
+		Vector<uint32_t> previousEntityToNode;
+		Vector<entt::entity> previousNodeHandles;
+		Vector<std::atomic_uint8_t> previousMovedFlags;
+
+		previousEntityToNode.swap(m_entityToNode);
+		previousNodeHandles.swap(m_nodeHandles);
+		previousMovedFlags.swap(m_movedFlags);
+
+		Vector<entt::entity> entities;
+		entities.reserve(view.size_hint());
+
+		size_t maxEntityIndex = 0;
+		for (const auto entity : view)
+		{
+			entities.emplace_back(entity);
+			maxEntityIndex = std::max(maxEntityIndex, static_cast<size_t>(entt::to_entity(entity)));
+		}
+
+		const uint32_t entityCount = static_cast<uint32_t>(entities.size());
+
+		// Temporarily map entities to their index in the unsorted list.
+		m_entityToNode.clear();
+		m_entityToNode.resize(entities.empty() ? 0 : maxEntityIndex + 1, INVALID_NODE_INDEX);
+
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			m_entityToNode[static_cast<size_t>(entt::to_entity(entities[i]))] = i;
+		}
+
+		// The parent ID is the source of truth, children lists are rebuilt from it.
+		Vector<uint32_t> unsortedParents(entityCount, INVALID_NODE_INDEX);
+		Vector<uint32_t> childOffsets(entityCount + 1, 0);
+
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			const EntityID parentId = view.get<const RelationshipComponent>(entities[i]).parent;
+			if (parentId == EntityID::Null())
+			{
+				continue;
+			}
+
+			const entt::entity parentHandle = entityRegistry.GetHandleFromID(parentId);
+			if (parentHandle == entt::null || !view.contains(parentHandle))
+			{
+				continue;
+			}
+
+			unsortedParents[i] = m_entityToNode[static_cast<size_t>(entt::to_entity(parentHandle))];
+			childOffsets[unsortedParents[i] + 1]++;
+		}
+
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			childOffsets[i + 1] += childOffsets[i];
+		}
+
+		Vector<uint32_t> children(childOffsets[entityCount]);
+		{
+			Vector<uint32_t> writeOffsets = childOffsets;
+			for (uint32_t i = 0; i < entityCount; i++)
+			{
+				if (unsortedParents[i] != INVALID_NODE_INDEX)
+				{
+					children[writeOffsets[unsortedParents[i]]++] = i;
+				}
+			}
+		}
+
+		m_nodeHandles.clear();
+		m_parentNodes.clear();
+		m_parentIds.clear();
+		m_rootNodes.clear();
+
+		m_nodeHandles.reserve(entityCount);
+		m_parentNodes.reserve(entityCount);
+		m_parentIds.reserve(entityCount);
+
+		// Depth first from every root, which keeps every subtree contiguous and parents in front of their children.
+		Vector<uint32_t> sortedIndices(entityCount, INVALID_NODE_INDEX);
+		Vector<uint32_t> stack;
+
+		for (uint32_t root = 0; root < entityCount; root++)
+		{
+			if (unsortedParents[root] != INVALID_NODE_INDEX)
+			{
+				continue;
+			}
+
+			m_rootNodes.emplace_back(static_cast<uint32_t>(m_nodeHandles.size()));
+			stack.emplace_back(root);
+
+			while (!stack.empty())
+			{
+				const uint32_t current = stack.back();
+				stack.pop_back();
+
+				const uint32_t parent = unsortedParents[current];
+
+				sortedIndices[current] = static_cast<uint32_t>(m_nodeHandles.size());
+				m_nodeHandles.emplace_back(entities[current]);
+				m_parentNodes.emplace_back(parent == INVALID_NODE_INDEX ? INVALID_NODE_INDEX : sortedIndices[parent]);
+				m_parentIds.emplace_back(view.get<const RelationshipComponent>(entities[current]).parent);
+
+				for (uint32_t child = childOffsets[current]; child < childOffsets[current + 1]; child++)
+				{
+					stack.emplace_back(children[child]);
+				}
+			}
+		}
+
+		// Entities in a parent cycle are never reached, they are left out of the cache.
+		const uint32_t nodeCount = static_cast<uint32_t>(m_nodeHandles.size());
+
+		std::fill(m_entityToNode.begin(), m_entityToNode.end(), INVALID_NODE_INDEX);
+		for (uint32_t i = 0; i < nodeCount; i++)
+		{
+			m_entityToNode[static_cast<size_t>(entt::to_entity(m_nodeHandles[i]))] = i;
+		}
+
+		// Children come after their parents, so walking backwards finishes every subtree before its parent is reached.
+		m_subtreeEnds.resize(nodeCount);
+		for (uint32_t i = 0; i < nodeCount; i++)
+		{
+			m_subtreeEnds[i] = i + 1;
+		}
+
+		for (uint32_t i = nodeCount; i > 0; i--)
+		{
+			const uint32_t node = i - 1;
+			if (m_parentNodes[node] != INVALID_NODE_INDEX)
+			{
+				m_subtreeEnds[m_parentNodes[node]] = std::max(m_subtreeEnds[m_parentNodes[node]], m_subtreeEnds[node]);
+			}
+		}
+
+		m_localTransforms.resize(nodeCount);
+		m_worldTransforms.resize(nodeCount);
+
+		// Atomics can't be copied, so the states are recreated instead of resized.
+		m_nodeStates = Vector<std::atomic<NodeState>>(nodeCount);
+		for (auto& state : m_nodeStates)
+		{
+			state.store(NodeState::Dirty, std::memory_order_relaxed);
+		}
+
+		m_movedFlags = Vector<std::atomic_uint8_t>(nodeCount);
+		for (uint32_t i = 0; i < nodeCount; i++)
+		{
+			const size_t entityIndex = static_cast<size_t>(entt::to_entity(m_nodeHandles[i]));
+			const uint32_t previousNode = entityIndex < previousEntityToNode.size() ? previousEntityToNode[entityIndex] : INVALID_NODE_INDEX;
+
+			if (previousNode != INVALID_NODE_INDEX && previousNodeHandles[previousNode] == m_nodeHandles[i])
+			{
+				m_movedFlags[i].store(previousMovedFlags[previousNode].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+
+		std::scoped_lock lock{ m_pendingMovedMutex };
+		for (const auto& entity : m_pendingMovedEntities)
+		{
+			const uint32_t nodeIndex = GetNodeIndex(entity);
+			if (nodeIndex != INVALID_NODE_INDEX)
+			{
+				m_movedFlags[nodeIndex].store(1, std::memory_order_relaxed);
+			}
+		}
+
+		m_pendingMovedEntities.clear();
+	}
+
+	bool EntityTransformCache::UpdateNodeRange(const entt::registry& registry, uint32_t beginNode, uint32_t endNode, Vector<entt::entity>& outMovedEntities)
+	{
+		const auto& transformStorage = registry.storage<TransformComponent>();
+		const auto& relationshipStorage = registry.storage<RelationshipComponent>();
+
+		bool isHierarchyValid = true;
+
+		for (uint32_t node = beginNode; node < endNode; node++)
+		{
+			const uint32_t parentNode = m_parentNodes[node];
+			const bool isParentDirty = parentNode != INVALID_NODE_INDEX && m_nodeStates[parentNode].load(std::memory_order_relaxed) != NodeState::Clean;
+			const bool isParentMoved = parentNode != INVALID_NODE_INDEX && m_movedFlags[parentNode].load(std::memory_order_relaxed);
+
+			// Reads may already have recalculated the node, so whether it moved is tracked on its own.
+			if (isParentMoved || m_movedFlags[node].load(std::memory_order_relaxed))
+			{
+				m_movedFlags[node].store(1, std::memory_order_relaxed);
+				outMovedEntities.emplace_back(m_nodeHandles[node]);
+			}
+
+			if (m_nodeStates[node].load(std::memory_order_relaxed) == NodeState::Clean && !isParentDirty)
+			{
+				continue;
+			}
+
+			const entt::entity entity = m_nodeHandles[node];
+
+			if (relationshipStorage.get(entity).parent != m_parentIds[node])
+			{
+				isHierarchyValid = false;
+			}
+
+			m_localTransforms[node] = Utility::GetLocalTransform(transformStorage.get(entity));
+			m_worldTransforms[node] = parentNode == INVALID_NODE_INDEX ? m_localTransforms[node] : Utility::CombineTransforms(m_worldTransforms[parentNode], m_localTransforms[node]);
+
+			// Stays set until the whole range is done, so that the children see it.
+			m_nodeStates[node].store(NodeState::Dirty, std::memory_order_relaxed);
+		}
+
+		for (uint32_t node = beginNode; node < endNode; node++)
+		{
+			m_nodeStates[node].store(NodeState::Clean, std::memory_order_relaxed);
+		}
+
+		return isHierarchyValid;
+	}
+
+	bool EntityTransformCache::ResolveNode(const entt::registry& registry, uint32_t nodeIndex, TQS& outTransform, bool& outWasRecalculated) const
+	{
+		// Parents are resolved first, so a clean parent is only seen after it has marked its children.
+		const uint32_t parentNode = m_parentNodes[nodeIndex];
+
+		TQS parentTransform{};
+		bool wasParentRecalculated = false;
+
+		if (parentNode != INVALID_NODE_INDEX && !ResolveNode(registry, parentNode, parentTransform, wasParentRecalculated))
+		{
+			return false;
+		}
+
+		auto& nodeState = m_nodeStates[nodeIndex];
+
+		NodeState state = nodeState.load(std::memory_order_acquire);
+		if (state == NodeState::Clean && !wasParentRecalculated)
+		{
+			outTransform = m_worldTransforms[nodeIndex];
+			outWasRecalculated = false;
+			return true;
+		}
+
+		const entt::entity entity = m_nodeHandles[nodeIndex];
+
+		// The node has been moved in the hierarchy, it is placed correctly by the next update.
+		if (registry.storage<RelationshipComponent>().get(entity).parent != m_parentIds[nodeIndex])
+		{
+			return false;
+		}
+
+		const TQS localTransform = Utility::GetLocalTransform(registry.storage<TransformComponent>().get(entity));
+		outTransform = parentNode == INVALID_NODE_INDEX ? localTransform : Utility::CombineTransforms(parentTransform, localTransform);
+		outWasRecalculated = true;
+
+		// Only the read that claims the node writes it back. Reads that find it claimed use their own result instead of waiting.
+		if (state != NodeState::Dirty || !nodeState.compare_exchange_strong(state, NodeState::Resolving, std::memory_order_acquire))
+		{
+			return true;
+		}
+
+		m_localTransforms[nodeIndex] = localTransform;
+		m_worldTransforms[nodeIndex] = outTransform;
+
+		// The children depend on the new transform, they are recalculated when read or by the next update.
+		for (uint32_t child = nodeIndex + 1; child < m_subtreeEnds[nodeIndex]; child++)
+		{
+			if (m_parentNodes[child] == nodeIndex)
+			{
+				m_nodeStates[child].store(NodeState::Dirty, std::memory_order_relaxed);
+			}
+		}
+
+		// An invalidation that happened while resolving leaves the node dirty.
+		NodeState expectedState = NodeState::Resolving;
+		nodeState.compare_exchange_strong(expectedState, NodeState::Clean, std::memory_order_release);
 
-		VT_ENSURE(m_transformCache.contains(entityId));
-		return m_transformCache.at(entityId);
+		return true;
 	}
 }
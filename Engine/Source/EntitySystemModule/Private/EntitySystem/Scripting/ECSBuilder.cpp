@@ -91,6 +91,61 @@ void ECSGameLoopContainer::Compile()
 #endif
 
 	m_executionBuckets = executionBuckets;
+
+	BuildTaskGraph();
+}
+
+void ECSGameLoopContainer::BuildTaskGraph()
+{
+	Vector<ECSSystem*> orderedSystems;
+	for (const auto& ids : m_executionBuckets)
+	{
+		for (const auto& id : ids)
+		{
+			orderedSystems.emplace_back(&m_registeredSystems.at(id));
+		}
+	}
+
+	for (size_t i = 0; i < orderedSystems.size(); i++)
+	{
+		orderedSystems.at(i)->m_executionIndex = static_cast<uint32_t>(i);
+	}
+
+	m_taskGraph = CreateScope<Volt::TaskGraph>(orderedSystems.size());
+
+	Vector<Volt::TaskID> taskIds;
+	taskIds.reserve(orderedSystems.size());
+
+	for (ECSSystem* system : orderedSystems)
+	{
+		taskIds.emplace_back(m_taskGraph->AddTask([this, system]()
+		{
+			system->Execute(*m_executingScene, m_executingDeltaTime);
+		}));
+	}
+
+	// The buckets are topologically sorted, so edges only ever go from an earlier system to a later one.
+	// A later system has to wait for an earlier one if it was ordered explicitly, if either of them is exclusive,
+	// or if they touch the same component and one of them writes to it.
+	for (size_t i = 0; i < orderedSystems.size(); i++)
+	{
+		const ECSSystem& first = *orderedSystems.at(i);
+
+		for (size_t j = i + 1; j < orderedSystems.size(); j++)
+		{
+			const ECSSystem& second = *orderedSystems.at(j);
+
+			const bool explicitOrder = std::find(second.Order().m_executeAfter.begin(), second.Order().m_executeAfter.end(), first.GetID()) != second.Order().m_executeAfter.end() ||
+				std::find(first.Order().m_executeBefore.begin(), first.Order().m_executeBefore.end(), second.GetID()) != first.Order().m_executeBefore.end();
+
+			if (explicitOrder || first.IsExclusive() || second.IsExclusive() || first.ConflictsWith(second))
+			{
+				m_taskGraph->AddDependency(taskIds.at(i), taskIds.at(j));
+			}
+		}
+	}
+
+	m_taskGraph->Compile();
 }
 
 ECSGameLoopContainer& ECSBuilder::GetGameLoop(GameLoop gameLoopType)
@@ -102,6 +157,28 @@ void ECSGameLoopContainer::Execute(Volt::EntityScene& scene, float deltaTime)
 {
 	VT_PROFILE_FUNCTION();
 
+	if (!m_parallelExecutionEnabled || !m_taskGraph)
+	{
+		ExecuteSerial(scene, deltaTime);
+		return;
+	}
+
+	// Storages can't be created safely from the workers, so make sure they all exist up front.
+	for (auto& [id, system] : m_registeredSystems)
+	{
+		system.PrepareStorages(scene);
+	}
+
+	m_executingScene = &scene;
+	m_executingDeltaTime = deltaTime;
+
+	m_taskGraph->ExecuteAndWait();
+
+	m_executingScene = nullptr;
+}
+
+void ECSGameLoopContainer::ExecuteSerial(Volt::EntityScene& scene, float deltaTime)
+{
 	for (const auto& ids : m_executionBuckets)
 	{
 		for (const auto& id : ids)
@@ -1,6 +1,9 @@
 #include "espch.h"
 
 #include "EntitySystem/Scripting/ECSSystem.h"
+#include "EntitySystem/EntityScene.h"
+
+#include <JobSystem/JobSystem.h>
 
 ECSSystem::ECSSystem(UUID64 id, ECSSystemFunc&& func)
 	: m_systemFunc(std::move(func)), m_id(id)
@@ -13,7 +16,56 @@ ECSSystem::~ECSSystem()
 
 void ECSSystem::Execute(Volt::EntityScene& scene, float deltaTime)
 {
-	m_systemFunc(scene, deltaTime);
+	if (!m_isParallelSafe || !m_systemRangeFunc)
+	{
+		Volt::EntityCommandBufferScope commandBufferScope{ scene, GetCommandSortKey(0) };
+		m_systemFunc(scene, deltaTime);
+		return;
+	}
+
+	const size_t entityCount = m_entityCountFunc(scene);
+	if (entityCount < MIN_PARALLEL_ENTITY_COUNT)
+	{
+		Volt::EntityCommandBufferScope commandBufferScope{ scene, GetCommandSortKey(0) };
+		m_systemFunc(scene, deltaTime);
+		return;
+	}
+
+	const size_t chunkSize = Volt::JobSystem::GetDefaultGrainSize(entityCount);
+	const size_t chunkCount = (entityCount + chunkSize - 1) / chunkSize;
+
+	Volt::JobSystem::ParallelFor(chunkCount, 1, [&](size_t chunkIndex)
+	{
+		const size_t begin = chunkIndex * chunkSize;
+		const size_t end = std::min(begin + chunkSize, entityCount);
+
+		Volt::EntityCommandBufferScope commandBufferScope{ scene, GetCommandSortKey(chunkIndex) };
+		m_systemRangeFunc(scene, deltaTime, begin, end);
+	});
+}
+
+void ECSSystem::PrepareStorages(Volt::EntityScene& scene)
+{
+	if (m_prepareFunc)
+	{
+		m_prepareFunc(scene);
+	}
+}
+
+bool ECSSystem::ConflictsWith(const ECSSystem& other) const
+{
+	for (const auto& access : m_componentAccesses)
+	{
+		for (const auto& otherAccess : other.m_componentAccesses)
+		{
+			if (access.componentGUID == otherAccess.componentGUID && (access.write || otherAccess.write))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
 }
 
 void ECSExecutionOrder::ExecuteAfter(ECSSystem& otherSystem)
@@ -123,6 +123,9 @@ namespace Volt
 
 		std::function<void(void* lhs, const void* rhs)> copyFunction;
 
+		size_t size = 0;
+		bool isTriviallyCopyable = false;
+
 		VT_INLINE AssetType GetAssetType() const
 		{
 			return g_assetTypeRegistry.GetTypeFromGUID(assetTypeGuid);
@@ -143,6 +146,8 @@ namespace Volt
 
 		[[nodiscard]] virtual const Vector<ComponentMember>& GetMembers() const = 0;
 		[[nodiscard]] virtual const bool IsHidden() const = 0;
+		[[nodiscard]] virtual const size_t GetSize() const = 0;
+		[[nodiscard]] virtual const bool IsTriviallyCopyable() const = 0;
 		[[nodiscard]] virtual ComponentMember* FindMemberByOffset(const ptrdiff_t offset) = 0;
 		[[nodiscard]] virtual ComponentMember* FindMemberByName(std::string_view name) = 0;
 		[[nodiscard]] virtual const ComponentMember* FindMemberByName(std::string_view name) const = 0;
@@ -172,6 +177,7 @@ namespace Volt
 		[[nodiscard]] virtual const ICommonTypeDesc* GetElementTypeDesc() const = 0;
 		[[nodiscard]] virtual const TypeTraits::TypeIndex& GetElementTypeIndex() const = 0;
 		[[nodiscard]] virtual const size_t GetElementTypeSize() const = 0;
+		[[nodiscard]] virtual const bool IsElementTriviallyCopyable() const = 0;
 
 		// NOTE: This function heap allocates an object that MUST be manually deleted!
 		virtual void DefaultConstructElement(void*& value) const = 0;
@@ -274,6 +280,7 @@ namespace Volt
 		[[nodiscard]] inline const std::string_view GetLabel() const override { return m_label; }
 		[[nodiscard]] inline const std::string_view GetDescription() const override { return m_description; }
 		[[nodiscard]] inline const size_t GetElementTypeSize() const override { return sizeof(ELEMENT_TYPE); }
+		[[nodiscard]] inline const bool IsElementTriviallyCopyable() const override { return std::is_trivially_copyable_v<ELEMENT_TYPE>; }
 		[[nodiscard]] inline const ICommonTypeDesc* GetElementTypeDesc() const override
 		{
 			if constexpr (IsReflectedType<ELEMENT_TYPE>() || IsArrayType<ELEMENT_TYPE>())
@@ -321,6 +328,8 @@ namespace Volt
 		[[nodiscard]] inline const std::string_view GetDescription() const override { return m_componentDescription; }
 		[[nodiscard]] inline const Vector<ComponentMember>& GetMembers() const override { return m_members; }
 		[[nodiscard]] inline const bool IsHidden() const override { return m_isHidden; }
+		[[nodiscard]] inline const size_t GetSize() const override { return sizeof(T); }
+		[[nodiscard]] inline const bool IsTriviallyCopyable() const override { return std::is_trivially_copyable_v<T>; }
 
 		void OnCreate(const EntityHelper& entityHelper) const override;
 		void OnDestroy(const EntityHelper& entityHelper) const override;
@@ -374,11 +383,11 @@ namespace Volt
 
 			if constexpr (IsArrayType<Type>() || IsReflectedType<Type>())
 			{
-				m_members.emplace_back(offset, name, label, description, AssetTypeType::element_type::guid, flags, GetTypeDesc<Type>(), this, TypeTraits::TypeIndex::FromType<Type>(), CreateScope<DefaultValueType<DefaultValueT>>(defaultValue), copyFunction);
+				m_members.emplace_back(offset, name, label, description, AssetTypeType::element_type::guid, flags, GetTypeDesc<Type>(), this, TypeTraits::TypeIndex::FromType<Type>(), CreateScope<DefaultValueType<DefaultValueT>>(defaultValue), copyFunction, sizeof(Type), std::is_trivially_copyable_v<Type>);
 			}
 			else
 			{
-				m_members.emplace_back(offset, name, label, description, AssetTypeType::element_type::guid, flags, nullptr, this, TypeTraits::TypeIndex::FromType<Type>(), CreateScope<DefaultValueType<DefaultValueT>>(defaultValue), copyFunction);
+				m_members.emplace_back(offset, name, label, description, AssetTypeType::element_type::guid, flags, nullptr, this, TypeTraits::TypeIndex::FromType<Type>(), CreateScope<DefaultValueType<DefaultValueT>>(defaultValue), copyFunction, sizeof(Type), std::is_trivially_copyable_v<Type>);
 			}
 
 
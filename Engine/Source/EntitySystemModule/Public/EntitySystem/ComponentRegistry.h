@@ -6,6 +6,7 @@
 #include "EntitySystem/EntityHelper.h"
 
 #include <unordered_map>
+#include <span>
 #include <entt.hpp>
 
 namespace Volt
@@ -34,6 +35,12 @@ namespace Volt
 			std::function<void(entt::registry&, entt::entity)> removeComponent;
 			std::function<bool(const entt::registry&, entt::entity)> hasComponent;
 			std::function<void*(entt::registry&, entt::entity)> getComponent;
+
+			// Adds default constructed components where missing, and outputs a pointer to every entity's component.
+			std::function<void(entt::registry&, std::span<const entt::entity>, std::span<void*>)> getOrAddComponents;
+
+			// Copies an array of components, one per entity, into the storage. Missing components are inserted in one batch.
+			std::function<void(entt::registry&, std::span<const entt::entity>, const void*)> insertComponents;
 			std::function<void(entt::registry&)> setupOnCreate;
 			std::function<void(entt::registry&)> setupOnDestroy;
 		};
@@ -45,6 +52,8 @@ namespace Volt
 			VTES_API static void RemoveComponentWithGUID(const VoltGUID& guid, entt::registry& registry, entt::entity entity);
 			VTES_API static const bool HasComponentWithGUID(const VoltGUID& guid, const entt::registry& registry, entt::entity entity);
 			VTES_API static void* GetComponentWithGUID(const VoltGUID& guid, entt::registry& registry, entt::entity entity);
+			VTES_API static void GetOrAddComponentsWithGUID(const VoltGUID& guid, entt::registry& registry, std::span<const entt::entity> entities, std::span<void*> outComponents);
+			VTES_API static void InsertComponentsWithGUID(const VoltGUID& guid, entt::registry& registry, std::span<const entt::entity> entities, const void* components);
 			VTES_API static void SetupComponentCallbacks(entt::registry& registry);
 
 		private:
@@ -113,6 +122,64 @@ namespace Volt
 			return nullptr;
 		};
 
+		helpers.getOrAddComponents = [](entt::registry& registry, std::span<const entt::entity> entities, std::span<void*> outComponents)
+		{
+			auto& storage = registry.storage<T>();
+
+			for (const auto& entity : entities)
+			{
+				if (!storage.contains(entity))
+				{
+					registry.emplace<T>(entity);
+				}
+			}
+
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				if constexpr (std::is_empty_v<T>)
+				{
+					// Empty components have no storage
+					outComponents[i] = nullptr;
+				}
+				else
+				{
+					outComponents[i] = &storage.get(entities[i]);
+				}
+			}
+		};
+
+		helpers.insertComponents = [](entt::registry& registry, std::span<const entt::entity> entities, const void* components)
+		{
+			if constexpr (std::is_empty_v<T>)
+			{
+				for (const auto& entity : entities)
+				{
+					registry.emplace_or_replace<T>(entity);
+				}
+			}
+			else
+			{
+				const T* typedComponents = reinterpret_cast<const T*>(components);
+				auto& storage = registry.storage<T>();
+
+				const bool hasAnyComponent = std::any_of(entities.begin(), entities.end(), [&storage](entt::entity entity)
+				{
+					return storage.contains(entity);
+				});
+
+				if (!hasAnyComponent)
+				{
+					registry.insert<T>(entities.begin(), entities.end(), typedComponents);
+					return;
+				}
+
+				for (size_t i = 0; i < entities.size(); i++)
+				{
+					registry.emplace_or_replace<T>(entities[i], typedComponents[i]);
+				}
+			}
+		};
+
 		helpers.setupOnCreate = [](entt::registry& registry)
 		{
 			registry.on_construct<T>().template connect<&ComponentRegistry::OnConstructComponent<T>>();
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "EntitySystem/EntityID.h"
+
+#include <CoreUtilities/Core.h>
+#include <CoreUtilities/Containers/Vector.h>
+#include <CoreUtilities/Containers/Map.h>
+
+#include <entt.hpp>
+
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Volt
+{
+	class EntityScene;
+	class EntityHelper;
+
+	// Lets the owner of an entity scene create and destroy the entities of played back command buffers,
+	// so that they go through the same paths as entities created and destroyed by the owner itself.
+	// The entity scene creates and destroys the entities on its own if a callback is not set.
+	struct EntityCommandPlaybackCallbacks
+	{
+		std::function<Vector<EntityHelper>(size_t count)> createEntities;
+		std::function<void(const Vector<EntityID>& entityIds)> destroyEntities;
+	};
+
+	// Handle to an entity which is either already alive, or which will be created when the command buffer is played back.
+	class DeferredEntity
+	{
+	public:
+		DeferredEntity(EntityID id)
+			: m_id(id)
+		{
+		}
+
+		VT_NODISCARD VT_INLINE bool IsPending() const { return m_pendingIndex != INVALID_PENDING_INDEX; }
+		VT_NODISCARD VT_INLINE EntityID GetID() const { return m_id; }
+
+	private:
+		friend class EntityCommandBuffer;
+
+		inline static constexpr uint32_t INVALID_PENDING_INDEX = std::numeric_limits<uint32_t>::max();
+
+		DeferredEntity(uint32_t pendingIndex, bool)
+			: m_id(EntityID::Null()), m_pendingIndex(pendingIndex)
+		{
+		}
+
+		EntityID m_id;
+		uint32_t m_pendingIndex = INVALID_PENDING_INDEX;
+	};
+
+	// Records structural changes to an entity scene, so that they can be made from any thread.
+	// The commands are applied in recording order when the buffer is played back on the main thread.
+	// A single buffer must only be recorded to from one thread at a time.
+	class VTES_API EntityCommandBuffer
+	{
+	public:
+		EntityCommandBuffer() = default;
+		~EntityCommandBuffer() = default;
+
+		VT_DELETE_COPY_MOVE(EntityCommandBuffer);
+
+		DeferredEntity CreateEntity(const std::string& tag = "");
+		void DestroyEntity(const DeferredEntity& entity);
+
+		template<typename T, typename... Args>
+		void AddComponent(const DeferredEntity& entity, Args&&... args);
+
+		template<typename T>
+		void RemoveComponent(const DeferredEntity& entity);
+
+		void Playback(EntityScene& scene);
+		void Clear();
+
+		VT_NODISCARD VT_INLINE bool IsEmpty() const { return m_commands.empty() && m_pendingEntityTags.empty(); }
+
+	private:
+		enum class CommandType : uint8_t
+		{
+			Destroy,
+			Component
+		};
+
+		using ComponentFunc = std::function<void(entt::registry& registry, entt::entity entity)>;
+
+		struct Command
+		{
+			CommandType type;
+			DeferredEntity entity;
+			ComponentFunc componentFunc;
+		};
+
+		Vector<Command> m_commands;
+		Vector<std::string> m_pendingEntityTags;
+	};
+
+	// Owns the command buffers of a scene.
+	// Buffers are played back sorted by their sort key, which makes the result independent of which thread recorded what.
+	class VTES_API EntityCommandBufferPool
+	{
+	public:
+		EntityCommandBufferPool() = default;
+		~EntityCommandBufferPool() = default;
+
+		VT_DELETE_COPY_MOVE(EntityCommandBufferPool);
+
+		EntityCommandBuffer& Acquire(uint64_t sortKey);
+
+		// Returns the same buffer for every call on the calling thread until the pool is played back.
+		// Only meant as a fallback for recording without an EntityCommandBufferScope, these buffers are played back last in no particular order.
+		EntityCommandBuffer& AcquireForCurrentThread();
+
+		// Buffers acquired while playing back, e.g. by the playback callbacks, are played back by the next playback.
+		void Playback(EntityScene& scene);
+
+	private:
+		inline static constexpr uint64_t UNSCOPED_SORT_KEY = std::numeric_limits<uint64_t>::max();
+
+		struct PooledBuffer
+		{
+			Scope<EntityCommandBuffer> buffer;
+			uint64_t sortKey = 0;
+		};
+
+		EntityCommandBuffer& AcquireInternal(uint64_t sortKey);
+
+		std::mutex m_mutex;
+		Vector<PooledBuffer> m_activeBuffers;
+		Vector<Scope<EntityCommandBuffer>> m_freeBuffers;
+
+		vt::map<std::thread::id, EntityCommandBuffer*> m_threadBuffers;
+	};
+
+	// Binds a sort key for the command buffer returned by EntityScene::GetCommandBuffer on the calling thread.
+	// The buffer is only acquired once a command is recorded, so scopes that don't record anything are free.
+	class VTES_API EntityCommandBufferScope
+	{
+	public:
+		EntityCommandBufferScope(EntityScene& scene, uint64_t sortKey);
+		~EntityCommandBufferScope();
+
+		VT_DELETE_COPY_MOVE(EntityCommandBufferScope);
+
+		VT_NODISCARD static EntityCommandBuffer* GetBoundBuffer(EntityScene& scene);
+
+	private:
+		EntityScene& m_scene;
+		uint64_t m_sortKey;
+		EntityCommandBuffer* m_buffer = nullptr;
+
+		EntityCommandBufferScope* m_previousScope = nullptr;
+	};
+
+	template<typename T, typename... Args>
+	inline void EntityCommandBuffer::AddComponent(const DeferredEntity& entity, Args&&... args)
+	{
+		ComponentFunc componentFunc = [component = T(std::forward<Args>(args)...)](entt::registry& registry, entt::entity entityHandle) mutable
+		{
+			registry.emplace_or_replace<T>(entityHandle, std::move(component));
+		};
+
+		m_commands.emplace_back(Command{ CommandType::Component, entity, std::move(componentFunc) });
+	}
+
+	template<typename T>
+	inline void EntityCommandBuffer::RemoveComponent(const DeferredEntity& entity)
+	{
+		ComponentFunc componentFunc = [](entt::registry& registry, entt::entity entityHandle)
+		{
+			registry.remove<T>(entityHandle);
+		};
+
+		m_commands.emplace_back(Command{ CommandType::Component, entity, std::move(componentFunc) });
+	}
+}
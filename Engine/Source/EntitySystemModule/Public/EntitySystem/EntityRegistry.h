@@ -17,6 +17,7 @@ namespace Volt
 		void ClearEditedEntities();
 
 		void AddEntity(const EntityHelper& entity);
+		void Reserve(size_t entityCount);
 		void RemoveEntity(const EntityID& entityId, entt::entity entityHandle);
 
 		EntityID GetUUIDFromHandle(entt::entity handle) const;
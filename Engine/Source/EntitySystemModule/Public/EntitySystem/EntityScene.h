@@ -2,6 +2,7 @@
 
 #include "EntitySystem/EntityTransformCache.h"
 #include "EntitySystem/EntityRegistry.h"
+#include "EntitySystem/EntityCommandBuffer.h"
 
 #include <entt.hpp>
 
@@ -27,15 +28,46 @@ namespace Volt
 		void SortScene();
 		void ClearScene();
 
+		// Only sorts if entities have been destroyed or created out of order since the last sort.
+		void SortSceneIfDirty();
+
 		EntityHelper CreateEntity(const std::string& tag = "");
 		EntityHelper CreateEntityWithID(EntityID id, const std::string& tag = "");
 
+		// Creates entities with the default components in one go.
+		// Storages are reserved once and the scene is sorted at most once, instead of once per entity.
+		Vector<EntityHelper> CreateEntities(size_t count, const std::string& tag = "");
+		Vector<EntityHelper> CreateEntitiesWithIDs(const Vector<EntityID>& ids, const std::string& tag = "");
+
+		// Same as above, but the whole batch also gets default constructed Components.
+		template<typename... Components>
+		Vector<EntityHelper> CreateEntities(size_t count, const std::string& tag = "");
+
 		void DestroyEntity(EntityID id, bool isDestroyingChildFromParent = false);
 
+		// Destroys the entities and all of their children in one go, entities that appear more than once are only destroyed once.
+		void DestroyEntities(const Vector<EntityID>& ids);
+
+		// Structural changes made from systems should go through a command buffer, as they might run on any thread.
+		// Returns the buffer bound by the current EntityCommandBufferScope, which systems bind with their execution and chunk index.
+		// Code outside of systems must bind its own scope, so that the buffers are played back in a deterministic order.
+		EntityCommandBuffer& GetCommandBuffer();
+		void PlaybackCommandBuffers();
+
+		VT_INLINE void SetCommandPlaybackCallbacks(const EntityCommandPlaybackCallbacks& callbacks) { m_commandPlaybackCallbacks = callbacks; }
+		VT_NODISCARD VT_INLINE const EntityCommandPlaybackCallbacks& GetCommandPlaybackCallbacks() const { return m_commandPlaybackCallbacks; }
+
 		void MarkEntityAsEdited(const EntityHelper& entityHelper);
 		void ClearEditedEntities();
 
-		Vector<EntityID> InvalidateEntityTransform(EntityID entityId);
+		void InvalidateEntityTransform(EntityID entityId);
+
+		// Recalculates all invalidated world transforms and notifies the components of every entity that moved.
+		// Called before and after the systems of every update.
+		void UpdateTransformCache();
+
+		// Called by UpdateTransformCache with every entity that moved since the last call.
+		VT_INLINE void SetTransformsChangedCallback(std::function<void(const Vector<entt::entity>&)>&& callback) { m_transformsChangedCallback = std::move(callback); }
 
 		VT_NODISCARD bool IsEntityValid(EntityID entityId) const;
 		VT_NODISCARD TQS GetEntityWorldTQS(const EntityHelper& entityHelper) const;
@@ -55,21 +87,51 @@ namespace Volt
 
 	private:
 		friend class EntityHelper;
+		friend class EntityCommandBufferScope;
 
 		void Initialize();
 
+		Vector<EntityHelper> CreateEntitiesInternal(size_t count, const EntityID* ids, const std::string& tag);
+		void SortSceneIfNeeded(size_t firstNewEntityIndex);
+
+		TQS CalculateEntityWorldTQS(const EntityHelper& entityHelper) const;
+
 		void ComponentOnStart();
 		void ComponentOnStop();
 
 		entt::registry m_registry;
 
 		bool m_isPlaying = false;
+		bool m_isSceneSorted = true;
 
 		Scope<ECSBuilder> m_ecsBuilder;
 		Scope<ScriptingEngine> m_scriptingEngine;
 		EntityRegistry m_entityRegistry;
-		mutable EntityTransformCache m_transformCache;
+		EntityTransformCache m_transformCache;
+		EntityCommandBufferPool m_commandBufferPool;
+		EntityCommandPlaybackCallbacks m_commandPlaybackCallbacks;
+		std::function<void(const Vector<entt::entity>&)> m_transformsChangedCallback;
 
 		RenderScene* m_renderScene;
 	};
+
+	template<typename... Components>
+	inline Vector<EntityHelper> EntityScene::CreateEntities(size_t count, const std::string& tag)
+	{
+		Vector<EntityHelper> result = CreateEntitiesInternal(count, nullptr, tag);
+
+		Vector<entt::entity> entityHandles;
+		entityHandles.reserve(result.size());
+
+		for (const auto& helper : result)
+		{
+			entityHandles.emplace_back(helper.GetHandle());
+		}
+
+		// Every storage grows once for the whole batch.
+		(m_registry.storage<Components>().reserve(m_registry.storage<Components>().size() + entityHandles.size()), ...);
+		(m_registry.insert<Components>(entityHandles.begin(), entityHandles.end()), ...);
+
+		return result;
+	}
 }
@@ -3,30 +3,104 @@
 #include "EntitySystem/EntityID.h"
 
 #include <CoreUtilities/CompilerTraits.h>
-#include <CoreUtilities/Containers/Map.h>
+#include <CoreUtilities/Containers/Vector.h>
 #include <CoreUtilities/Math/TQS.h>
 
-#include <shared_mutex>
+#include <entt.hpp>
+
+#include <atomic>
+#include <mutex>
 
 namespace Volt
 {
+	class EntityRegistry;
+
+	// World transforms of all entities, stored densely with parents before their children.
+	// Invalidating an entity only marks its own node, Update and reads push the change down to the children.
+	// The transforms are recalculated in a single pass by Update, which also collects every entity that moved since the last update.
+	// Transforms invalidated between updates are recalculated by the first read, and written back for later reads.
+	// Reads never wait on each other, but Update must not run at the same time as any reads.
 	class VTES_API EntityTransformCache
 	{
 	public:
 		EntityTransformCache() = default;
 		~EntityTransformCache() = default;
 
-		void CacheTransform(EntityID entityId, const TQS& transform);
-		void InvalidateTransform(EntityID entityId);
-		const TQS& GetCachedTransform(EntityID entityId) const;
+		void Update(const entt::registry& registry, const EntityRegistry& entityRegistry);
+
+		// Safe to call from any thread, but not while another thread reads the entity or its children.
+		void InvalidateTransform(entt::entity entityHandle);
+
+		// Must be called when entities are created or destroyed, or when their parent changes.
+		VT_INLINE void InvalidateHierarchy() { m_isHierarchyDirty.store(true, std::memory_order_release); }
+
+		// Recalculates the entity and its parents if they have been invalidated since the last update.
+		// Returns false if the entity is unknown to the cache, or if it or any of its parents has changed parent since the last rebuild.
+		VT_NODISCARD bool TryGetWorldTransform(const entt::registry& registry, entt::entity entityHandle, TQS& outTransform) const;
 
-		VT_NODISCARD VT_INLINE bool HasCachedTransform(EntityID entityId) const { ReadLock lock{ m_mutex }; return m_transformCache.contains(entityId); }
+		// Entities that were invalidated, or have an invalidated parent, before the last update.
+		VT_NODISCARD VT_INLINE const Vector<entt::entity>& GetMovedEntities() const { return m_movedEntities; }
 
 	private:
-		using WriteLock = std::unique_lock<std::shared_mutex>;
-		using ReadLock = std::shared_lock<std::shared_mutex>;
+		inline static constexpr uint32_t INVALID_NODE_INDEX = std::numeric_limits<uint32_t>::max();
+		inline static constexpr size_t MIN_PARALLEL_NODE_COUNT = 4096;
+
+		enum class NodeState : uint8_t
+		{
+			Clean,
+			Dirty,
+			Resolving
+		};
+
+		void RebuildHierarchy(const entt::registry& registry, const EntityRegistry& entityRegistry);
+		bool UpdateNodeRange(const entt::registry& registry, uint32_t beginNode, uint32_t endNode, Vector<entt::entity>& outMovedEntities);
+		bool ResolveNode(const entt::registry& registry, uint32_t nodeIndex, TQS& outTransform, bool& outWasRecalculated) const;
+
+		VT_NODISCARD VT_INLINE uint32_t GetNodeIndex(entt::entity entityHandle) const
+		{
+			const size_t entityIndex = static_cast<size_t>(entt::to_entity(entityHandle));
+			if (entityIndex >= m_entityToNode.size())
+			{
+				return INVALID_NODE_INDEX;
+			}
+
+			const uint32_t nodeIndex = m_entityToNode[entityIndex];
+			if (nodeIndex == INVALID_NODE_INDEX || m_nodeHandles[nodeIndex] != entityHandle)
+			{
+				return INVALID_NODE_INDEX;
+			}
+
+			return nodeIndex;
+		}
+
+		// Indexed by the entity part of the entity handle.
+		Vector<uint32_t> m_entityToNode;
+
+		// Indexed by node, in hierarchy order.
+		Vector<entt::entity> m_nodeHandles;
+		Vector<uint32_t> m_parentNodes;
+		Vector<EntityID> m_parentIds;
+
+		// One past the last node of the subtree of every node.
+		Vector<uint32_t> m_subtreeEnds;
+
+		// Written by reads that recalculate invalidated nodes, the node state guards every node.
+		mutable Vector<TQS> m_localTransforms;
+		mutable Vector<TQS> m_worldTransforms;
+		mutable Vector<std::atomic<NodeState>> m_nodeStates;
+
+		// Set by invalidation and only cleared by Update, reads don't touch it.
+		Vector<std::atomic_uint8_t> m_movedFlags;
+		Vector<entt::entity> m_movedEntities;
+
+		// Entities invalidated before the cache knows about them, they are marked as moved by the next rebuild.
+		std::mutex m_pendingMovedMutex;
+		Vector<entt::entity> m_pendingMovedEntities;
+
+		// The first node of every root subtree, subtrees can be updated in parallel.
+		Vector<uint32_t> m_rootNodes;
 
-		vt::map<EntityID, TQS> m_transformCache;
-		mutable std::shared_mutex m_mutex;
+		std::atomic_bool m_isHierarchyDirty = true;
+		std::atomic_bool m_hasDirtyNodes = false;
 	};
 }
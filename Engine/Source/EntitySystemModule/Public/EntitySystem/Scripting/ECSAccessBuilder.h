@@ -333,6 +333,13 @@ namespace ECS
 		}
 
 		VT_NODISCARD VT_INLINE entt::entity GetHandle() const { return m_entityHelper.GetHandle(); }
+
+		// Creating and destroying entities, or adding and removing components, has to be deferred while systems are running.
+		VT_NODISCARD Volt::EntityCommandBuffer& GetCommandBuffer() const
+		{
+			return m_entityHelper.GetSceneReference()->GetCommandBuffer();
+		}
+
 		VT_NODISCARD Volt::RenderScene* GetRenderScene() const
 		{
 			return m_entityHelper.GetSceneReference()->GetRenderScene();
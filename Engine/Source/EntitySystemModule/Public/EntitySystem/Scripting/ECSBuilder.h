@@ -4,6 +4,7 @@
 #include "EntitySystem/Scripting/ScriptingEngine.h"
 
 #include <EventSystem/Event.h>
+#include <JobSystem/TaskGraph.h>
 
 #include <CoreUtilities/Containers/Map.h>
 #include <CoreUtilities/UUID.h>
@@ -22,6 +23,10 @@ public:
 	void VTES_API Execute(Volt::EntityScene& scene, float deltaTime);
 	void VTES_API Compile();
 
+	// When enabled, systems which do not conflict in component access run at the same time on the job system.
+	// Off by default, as every system of the game loop has to be marked exclusive if it has side effects outside of its declared components.
+	VT_INLINE void SetParallelExecutionEnabled(bool enabled) { m_parallelExecutionEnabled = enabled; }
+
 	template<typename Ret, typename... Args>
 	ECSSystem& RegisterSystem(Ret(*func)(Args...))
 	{
@@ -35,8 +40,16 @@ public:
 	}
 
 private:
+	void BuildTaskGraph();
+	void ExecuteSerial(Volt::EntityScene& scene, float deltaTime);
+
 	vt::map<UUID64, ECSSystem> m_registeredSystems;
 	Vector<Vector<UUID64>> m_executionBuckets;
+
+	Scope<Volt::TaskGraph> m_taskGraph;
+	Volt::EntityScene* m_executingScene = nullptr;
+	float m_executingDeltaTime = 0.f;
+	bool m_parallelExecutionEnabled = false;
 };
 
 class ScriptingEngine;
@@ -25,6 +25,9 @@ private:
 };
 
 using ECSSystemFunc = std::function<void(Volt::EntityScene& registry, float deltaTime)>;
+using ECSSystemRangeFunc = std::function<void(Volt::EntityScene& registry, float deltaTime, size_t begin, size_t end)>;
+using ECSSystemEntityCountFunc = std::function<size_t(Volt::EntityScene& registry)>;
+using ECSSystemPrepareFunc = std::function<void(Volt::EntityScene& registry)>;
 
 struct ComponentAccess
 {
@@ -41,18 +44,49 @@ public:
 
 	void Execute(Volt::EntityScene& scene, float deltaTime);
 
+	// Creates any missing component storages used by the system.
+	// Must be called on the main thread before the system is executed on a worker.
+	void PrepareStorages(Volt::EntityScene& scene);
+
+	// Returns true if the systems access the same component, and at least one of them writes to it.
+	VT_NODISCARD bool ConflictsWith(const ECSSystem& other) const;
+
+	// A parallel safe system may be called for different entities at the same time,
+	// which allows large views to be split up across the job system workers.
+	VT_INLINE ECSSystem& SetIsParallelSafe(bool isParallelSafe) { m_isParallelSafe = isParallelSafe; return *this; }
+	VT_NODISCARD VT_INLINE bool IsParallelSafe() const { return m_isParallelSafe; }
+
+	// An exclusive system never runs at the same time as any other system of its game loop.
+	// Systems with side effects outside of their declared components, like moving entities through the scene, must be exclusive.
+	VT_INLINE ECSSystem& SetIsExclusive(bool isExclusive) { m_isExclusive = isExclusive; return *this; }
+	VT_NODISCARD VT_INLINE bool IsExclusive() const { return m_isExclusive; }
+
 	VT_NODISCARD VT_INLINE ECSExecutionOrder& Order() { return m_executionOrder; }
+	VT_NODISCARD VT_INLINE const ECSExecutionOrder& Order() const { return m_executionOrder; }
+	VT_NODISCARD VT_INLINE const Vector<ComponentAccess>& GetComponentAccesses() const { return m_componentAccesses; }
 	VT_NODISCARD VT_INLINE UUID64 GetID() const { return m_id; }
 
 private:
 	template<typename Ret, typename... Args>
 	friend class ECSSystemRegisterer;
+	friend class ECSGameLoopContainer;
+
+	inline static constexpr size_t MIN_PARALLEL_ENTITY_COUNT = 256;
+
+	// Command buffers recorded by the system are played back in system order, and then in chunk order.
+	VT_NODISCARD VT_INLINE uint64_t GetCommandSortKey(size_t chunkIndex) const { return (static_cast<uint64_t>(m_executionIndex) << 32ull) | static_cast<uint64_t>(chunkIndex); }
 
 	ECSSystemFunc m_systemFunc;
+	ECSSystemRangeFunc m_systemRangeFunc;
+	ECSSystemEntityCountFunc m_entityCountFunc;
+	ECSSystemPrepareFunc m_prepareFunc;
 	ECSExecutionOrder m_executionOrder;
 
 	Vector<ComponentAccess> m_componentAccesses;
 	UUID64 m_id = 0;
+	uint32_t m_executionIndex = 0;
+	bool m_isParallelSafe = false;
+	bool m_isExclusive = false;
 };
 
 template<typename Ret, typename... Args>
@@ -89,27 +123,47 @@ public:
 		auto systemFunc = [func](Volt::EntityScene& scene, float deltaTime = 0.f)
 		{
 			auto view = GetRegistryView<ComponentTuple>(scene.GetRegistry());
-			auto deltaTimeTuple = std::tuple{ deltaTime };
 
 			for (const auto& entity : view)
 			{
-				auto arguments = GetSystemArgument<ArgumentTypes, IsFinalArgFloat>(scene, view, entity);
+				InvokeSystem<IsFinalArgFloat>(func, scene, view, entity, deltaTime);
+			}
+		};
 
-				if constexpr (IsFinalArgFloat)
-				{
-					auto finalArguments = std::tuple_cat(arguments, deltaTimeTuple);
-					std::apply(func, finalArguments);
-				}
-				else
+		// Iterates a sub range of the leading storage of the view, used when splitting the system across workers.
+		auto systemRangeFunc = [func](Volt::EntityScene& scene, float deltaTime, size_t begin, size_t end)
+		{
+			auto view = GetRegistryView<ComponentTuple>(scene.GetRegistry());
+			const auto* entities = view.handle().data();
+
+			for (size_t i = begin; i < end; i++)
+			{
+				const entt::entity entity = entities[i];
+				if (!view.contains(entity))
 				{
-					std::apply(func, arguments);
+					continue;
 				}
+
+				InvokeSystem<IsFinalArgFloat>(func, scene, view, entity, deltaTime);
 			}
 		};
 
+		auto entityCountFunc = [](Volt::EntityScene& scene) -> size_t
+		{
+			return GetRegistryView<ComponentTuple>(scene.GetRegistry()).handle().size();
+		};
+
+		auto prepareFunc = [](Volt::EntityScene& scene)
+		{
+			PrepareArgumentStorages<ArgumentTypes, IsFinalArgFloat>(scene.GetRegistry());
+		};
+
 		ECSSystem result;
 		result.m_id = id;
 		result.m_systemFunc = std::move(systemFunc);
+		result.m_systemRangeFunc = std::move(systemRangeFunc);
+		result.m_entityCountFunc = std::move(entityCountFunc);
+		result.m_prepareFunc = std::move(prepareFunc);
 		result.m_componentAccesses = GetComponentAccesses<ArgumentTypes, IsFinalArgFloat>();
 
 		return result;
@@ -174,7 +228,59 @@ private:
 		}
 	}
 
+	// Storage preparation
+	template<typename Tuple, std::size_t... Indices>
+	static void PrepareStoragesImpl(std::index_sequence<Indices...>, entt::registry& registry)
+	{
+		(registry.storage<std::remove_const_t<std::remove_reference_t<std::tuple_element_t<Indices, Tuple>>>>(), ...);
+	}
+
+	template<typename T>
+	static void PrepareArgumentStorage(entt::registry& registry)
+	{
+		using ViewTuple = typename T::ComponentViewTuple;
+		using ComponentTuple = typename T::ComponentTuple;
+
+		PrepareStoragesImpl<ViewTuple>(std::make_index_sequence<std::tuple_size_v<ViewTuple>>{}, registry);
+		PrepareStoragesImpl<ComponentTuple>(std::make_index_sequence<std::tuple_size_v<ComponentTuple>>{}, registry);
+	}
+
+	template<typename Tuple, std::size_t... Indices>
+	static void PrepareArgumentStoragesImpl(std::index_sequence<Indices...>, entt::registry& registry)
+	{
+		(PrepareArgumentStorage<std::tuple_element_t<Indices, Tuple>>(registry), ...);
+	}
+
+	template<typename Tuple, bool HasFloatArg>
+	static void PrepareArgumentStorages(entt::registry& registry)
+	{
+		if constexpr (HasFloatArg)
+		{
+			PrepareArgumentStoragesImpl<Tuple>(std::make_index_sequence<std::tuple_size_v<Tuple> - 1>{}, registry);
+		}
+		else
+		{
+			PrepareArgumentStoragesImpl<Tuple>(std::make_index_sequence<std::tuple_size_v<Tuple>>{}, registry);
+		}
+	}
+
 	// System functions
+	template<bool HasFloatArg, typename EntityView>
+	static void InvokeSystem(Ret(*func)(Args...), Volt::EntityScene& scene, EntityView& view, entt::entity entity, float deltaTime)
+	{
+		auto arguments = GetSystemArgument<ArgumentTypes, HasFloatArg>(scene, view, entity);
+
+		if constexpr (HasFloatArg)
+		{
+			auto finalArguments = std::tuple_cat(arguments, std::tuple{ deltaTime });
+			std::apply(func, finalArguments);
+		}
+		else
+		{
+			std::apply(func, arguments);
+		}
+	}
+
 	template<typename Tuple, std::size_t... Indices>
 	static auto GetRegistryViewImpl(std::index_sequence<Indices...>, entt::registry& registry)
 	{
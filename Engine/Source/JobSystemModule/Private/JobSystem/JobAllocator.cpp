@@ -3,53 +3,256 @@
 
 namespace Volt
 {
-	JobAllocator::JobAllocator()
+	namespace Utility
 	{
-		m_jobAllocator.resize(MAX_JOB_COUNT);
+		static std::atomic<JobAllocator*> s_activeAllocator = nullptr;
 	}
 
-	AllocatedJob JobAllocator::AllocateJob()
+	struct JobAllocatorThreadCache
+	{
+		inline static constexpr uint32_t CACHE_SIZE = 64;
+		inline static constexpr uint32_t REFILL_COUNT = CACHE_SIZE / 2;
+
+		~JobAllocatorThreadCache()
+		{
+			// Give the cached slots back when the thread exits, as long as the allocator is still around.
+			if (owner && owner == Utility::s_activeAllocator.load())
+			{
+				owner->FlushThreadCache(*this, count);
+			}
+		}
+
+		JobAllocator* owner = nullptr;
+		uint32_t count = 0;
+		uint32_t indices[CACHE_SIZE];
+
+		// Batches of new slots must never span two pages.
+		static_assert(JobAllocator::PAGE_SIZE % REFILL_COUNT == 0);
+	};
+
+	namespace Utility
 	{
-		JobID jobId = INVALID_JOB_ID;
+		static thread_local JobAllocatorThreadCache s_threadCache;
 
+		VT_INLINE JobAllocatorThreadCache& GetThreadCache(JobAllocator* allocator)
 		{
-			std::scoped_lock lock{ m_freeJobsMutex };
-			if (!m_freeJobs.empty())
+			if (s_threadCache.owner != allocator)
 			{
-				jobId = m_freeJobs.back();
-				m_freeJobs.pop_back();
+				s_threadCache.owner = allocator;
+				s_threadCache.count = 0;
 			}
+
+			return s_threadCache;
 		}
+	}
 
-		if (jobId == INVALID_JOB_ID)
+	JobAllocator::JobAllocator()
+	{
+		for (auto& page : m_pages)
 		{
-			jobId = m_currentTailIndex.fetch_add(1u);
+			page.store(nullptr, std::memory_order_relaxed);
 		}
 
-		VT_ENSURE(jobId < MAX_JOB_COUNT);
-		VT_ENSURE(m_jobAllocator[jobId].unfinishedJobs == 0);
-		return { &m_jobAllocator[jobId], jobId };
+		Utility::s_activeAllocator = this;
+	}
+
+	JobAllocator::~JobAllocator()
+	{
+		Utility::s_activeAllocator = nullptr;
+
+		for (auto& page : m_pages)
+		{
+			delete page.load();
+		}
+	}
+
+	AllocatedJob JobAllocator::AllocateJob()
+	{
+		auto& cache = Utility::GetThreadCache(this);
+		if (cache.count == 0)
+		{
+			RefillThreadCache(cache);
+		}
+
+		const uint32_t index = cache.indices[--cache.count];
+		Job& job = GetJob(index);
+
+		VT_ENSURE(job.unfinishedJobs == 0);
+		return { &job, job.id.load(std::memory_order_acquire) };
 	}
 
 	void JobAllocator::FreeJob(JobID id)
 	{
-		m_jobAllocator[id].unfinishedJobs = 0;
-		m_jobAllocator[id].func = nullptr;
-		m_jobAllocator[id].parentJob = INVALID_JOB_ID;
-	
-		std::scoped_lock lock{ m_freeJobsMutex };
-		m_freeJobs.emplace_back(id);
+		Job* job = GetJobFromID(id);
+		if (!job)
+		{
+			return;
+		}
+
+		FreeJob(job);
 	}
 
 	void JobAllocator::FreeJob(Job* job)
 	{
-		// As the job index matches with the job ID, this will work
-		FreeJob(static_cast<JobID>(std::distance(m_jobAllocator.begin(), job)));
+		const JobID id = job->id.load(std::memory_order_relaxed);
+		const uint32_t index = GetIndexFromID(id);
+
+		job->unfinishedJobs = 0;
+		job->func = nullptr;
+		job->parentJob = INVALID_JOB_ID;
+
+		// Bumping the generation invalidates all handles to the job.
+		job->id.store(CreateID(index, GetGenerationFromID(id) + 1), std::memory_order_release);
+
+		auto& cache = Utility::GetThreadCache(this);
+		if (cache.count == JobAllocatorThreadCache::CACHE_SIZE)
+		{
+			FlushThreadCache(cache, JobAllocatorThreadCache::CACHE_SIZE / 2);
+		}
+
+		cache.indices[cache.count++] = index;
+	}
+
+	Job* JobAllocator::GetJobFromID(JobID id) const
+	{
+		const uint32_t index = GetIndexFromID(id);
+		if (id == INVALID_JOB_ID || index >= m_nextUnusedIndex.load(std::memory_order_acquire))
+		{
+			return nullptr;
+		}
+
+		Page* page = m_pages[index / PAGE_SIZE].load(std::memory_order_acquire);
+		if (!page)
+		{
+			return nullptr;
+		}
+
+		Job* job = &page->jobs[index % PAGE_SIZE];
+		if (job->id.load(std::memory_order_acquire) != id)
+		{
+			return nullptr;
+		}
+
+		return job;
+	}
+
+	void JobAllocator::RefillThreadCache(JobAllocatorThreadCache& cache)
+	{
+		while (cache.count < JobAllocatorThreadCache::REFILL_COUNT)
+		{
+			const uint32_t index = PopFreeIndex();
+			if (index == INVALID_INDEX)
+			{
+				break;
+			}
+
+			cache.indices[cache.count++] = index;
+		}
+
+		if (cache.count > 0)
+		{
+			return;
+		}
+
+		// The free list is empty, grab a batch of new slots.
+		uint32_t startIndex = m_nextUnusedIndex.load(std::memory_order_relaxed);
+		while (true)
+		{
+			// Make sure the page exists before the indices become visible to GetJobFromID.
+			GetOrCreatePage(startIndex / PAGE_SIZE);
+
+			if (m_nextUnusedIndex.compare_exchange_weak(startIndex, startIndex + JobAllocatorThreadCache::REFILL_COUNT, std::memory_order_acq_rel, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+
+		for (uint32_t i = 0; i < JobAllocatorThreadCache::REFILL_COUNT; i++)
+		{
+			// Push in reverse so that the lowest index is handed out first.
+			cache.indices[cache.count++] = startIndex + JobAllocatorThreadCache::REFILL_COUNT - 1 - i;
+		}
+	}
+
+	void JobAllocator::FlushThreadCache(JobAllocatorThreadCache& cache, uint32_t count)
+	{
+		count = std::min(count, cache.count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			PushFreeIndex(cache.indices[--cache.count]);
+		}
+	}
+
+	uint32_t JobAllocator::PopFreeIndex()
+	{
+		uint64_t head = m_freeListHead.load(std::memory_order_acquire);
+		while (true)
+		{
+			const uint32_t index = static_cast<uint32_t>(head & 0xFFFFFFFFull);
+			if (index == INVALID_INDEX)
+			{
+				return INVALID_INDEX;
+			}
+
+			const uint32_t nextIndex = m_pages[index / PAGE_SIZE].load(std::memory_order_acquire)->nextFree[index % PAGE_SIZE].load(std::memory_order_relaxed);
+			const uint64_t tag = (head >> 32ull) + 1;
+			const uint64_t newHead = (tag << 32ull) | nextIndex;
+
+			if (m_freeListHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				return index;
+			}
+		}
+	}
+
+	void JobAllocator::PushFreeIndex(uint32_t index)
+	{
+		auto& nextFree = m_pages[index / PAGE_SIZE].load(std::memory_order_acquire)->nextFree[index % PAGE_SIZE];
+
+		uint64_t head = m_freeListHead.load(std::memory_order_relaxed);
+		while (true)
+		{
+			nextFree.store(static_cast<uint32_t>(head & 0xFFFFFFFFull), std::memory_order_relaxed);
+
+			const uint64_t tag = (head >> 32ull) + 1;
+			const uint64_t newHead = (tag << 32ull) | index;
+
+			if (m_freeListHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+			{
+				return;
+			}
+		}
+	}
+
+	JobAllocator::Page& JobAllocator::GetOrCreatePage(uint32_t pageIndex)
+	{
+		VT_ENSURE_MSG(pageIndex < MAX_PAGE_COUNT, "Out of job slots!");
+
+		Page* page = m_pages[pageIndex].load(std::memory_order_acquire);
+		if (page)
+		{
+			return *page;
+		}
+
+		Page* newPage = new Page();
+		for (uint32_t i = 0; i < PAGE_SIZE; i++)
+		{
+			newPage->jobs[i].id.store(CreateID(pageIndex * PAGE_SIZE + i, 0), std::memory_order_relaxed);
+			newPage->nextFree[i].store(INVALID_INDEX, std::memory_order_relaxed);
+		}
+
+		// Another thread might have created the page at the same time.
+		if (!m_pages[pageIndex].compare_exchange_strong(page, newPage, std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			delete newPage;
+			return *page;
+		}
+
+		return *newPage;
 	}
 
-	Job* JobAllocator::GetJobFromID(JobID id)
+	Job& JobAllocator::GetJob(uint32_t index) const
 	{
-		VT_ENSURE(id < MAX_JOB_COUNT);
-		return &m_jobAllocator[id];
+		return m_pages[index / PAGE_SIZE].load(std::memory_order_acquire)->jobs[index % PAGE_SIZE];
 	}
 }
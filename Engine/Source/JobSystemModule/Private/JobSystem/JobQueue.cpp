@@ -1,81 +1,97 @@
 #include "jspch.h"
 #include "JobQueue.h"
 
-#include <CoreUtilities/Atomic.h>
-
 namespace Volt
 {
 	JobQueue::JobQueue()
 	{
-		memset(m_jobQueue, 0, MAX_JOB_COUNT * sizeof(Job*));
+		for (auto& job : m_jobQueue)
+		{
+			job.store(nullptr, std::memory_order_relaxed);
+		}
 	}
+
 	JobQueue::~JobQueue()
 	{
 	}
 
-	void JobQueue::Push(Job* job)
+	bool JobQueue::Push(Job* job)
 	{
-		long b = m_bottom;
-		m_jobQueue[b & MASK] = job;
+		const int64_t b = m_bottom.load(std::memory_order_relaxed);
+		const int64_t t = m_top.load(std::memory_order_acquire);
+
+		if (b - t >= static_cast<int64_t>(MAX_JOB_COUNT))
+		{
+			return false;
+		}
+
+		m_jobQueue[b & MASK].store(job, std::memory_order_relaxed);
 
 		// Ensure that job is written before bottom is updated.
-		VT_COMPILER_BARRIER();
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(b + 1, std::memory_order_relaxed);
 
-		m_bottom = b + 1;
+		return true;
 	}
 
 	Job* JobQueue::Pop()
-	{        
-		long b = m_bottom - 1;
-		Atomic::InterlockedExchange(&m_bottom, b);
+	{
+		const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(b, std::memory_order_relaxed);
+
+		// The bottom store must be visible to thieves before we read top.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		int64_t t = m_top.load(std::memory_order_relaxed);
+		if (t > b)
+		{
+			// Queue was empty
+			m_bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
 
-		long t = m_top;
-		if (t <= b)
+		Job* job = m_jobQueue[b & MASK].load(std::memory_order_relaxed);
+		if (t != b)
 		{
-			Job* job = m_jobQueue[b & MASK];
-			if (t != b)
-			{
-				return job;
-			}
-
-			if (Atomic::InterlockedCompareExchange(&m_top, t + 1, t) != t)
-			{
-				job = nullptr;
-			}
-
-			m_bottom = t + 1;
 			return job;
 		}
-		else
+
+		// Last job in the queue, race against the thieves for it.
+		if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
 		{
-			m_bottom = t;
-			return nullptr;
+			job = nullptr;
 		}
+
+		m_bottom.store(b + 1, std::memory_order_relaxed);
+		return job;
 	}
 
 	Job* JobQueue::Steal()
 	{
-		long t = m_top;
+		int64_t t = m_top.load(std::memory_order_acquire);
 
 		// Ensure that top is always read before bottom.
-		VT_COMPILER_BARRIER();
-
-		long b = m_bottom;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
 
-		if (t < b)
+		const int64_t b = m_bottom.load(std::memory_order_acquire);
+		if (t >= b)
 		{
-			Job* job = m_jobQueue[t & MASK];
-
-			if (Atomic::InterlockedCompareExchange(&m_top, t + 1, t) != t)
-			{
-				return nullptr;
-			}
-
-			return job;
+			return nullptr;
 		}
-		else
+
+		Job* job = m_jobQueue[t & MASK].load(std::memory_order_relaxed);
+		if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
 		{
 			return nullptr;
 		}
+
+		return job;
+	}
+
+	bool JobQueue::IsEmpty() const
+	{
+		const int64_t b = m_bottom.load(std::memory_order_relaxed);
+		const int64_t t = m_top.load(std::memory_order_relaxed);
+		return b <= t;
 	}
 }
@@ -49,4 +49,10 @@ namespace Volt
 		++m_top;
 		return job;
 	}
+
+	bool JobQueueLocking::IsEmpty() const
+	{
+		std::scoped_lock lock{ *m_mutex };
+		return m_bottom - m_top <= 0;
+	}
 }
@@ -7,60 +7,54 @@
 #include <CoreUtilities/Atomic.h>
 #include <CoreUtilities/Random.h>
 
+#include <immintrin.h>
+
 namespace Volt
 {
 	VT_REGISTER_SUBSYSTEM(JobSystem, PreEngine, 3);
 
-	JobSystem::JobSystem()
+	namespace Utility
 	{
-		VT_ENSURE(s_instance == nullptr);
-		s_instance = this;
+		// Slot used by the current thread. Thread locals can't be members of an exported class.
+		static thread_local uint32_t s_threadSlotIndex = std::numeric_limits<uint32_t>::max();
+		static thread_local uint32_t s_randomState = 0;
 
-		RegisterListener<AppUpdateEvent>(VT_BIND_EVENT_FN(JobSystem::OnUpdate));
-	}
-
-	JobSystem::~JobSystem()
-	{
-		s_instance = nullptr;
-	}
-
-	JobID JobSystem::CreateJob(const std::function<void()>& task)
-	{
-		VT_ENSURE(s_instance);
-		return CreateJob(ExecutionPolicy::WorkerThread, task);
-	}
+		static constexpr uint32_t OVERFLOW_THREAD_SLOT = std::numeric_limits<uint32_t>::max() - 1;
 
-	JobID JobSystem::CreateJob(ExecutionPolicy executionPolicy, const std::function<void()>& task)
-	{
-		auto [jobPtr, jobId] = s_instance->AllocateJobInternal(executionPolicy, task);
-		return jobId;
-	}
+		VT_INLINE uint32_t NextRandom()
+		{
+			// Xorshift32, cheap enough to be called on every steal attempt.
+			uint32_t x = s_randomState;
+			if (x == 0)
+			{
+				x = static_cast<uint32_t>(Random::Int(1, std::numeric_limits<int>::max()));
+			}
 
-	JobID JobSystem::CreateAndRunJob(const std::function<void()>& task)
-	{
-		return CreateAndRunJob(ExecutionPolicy::WorkerThread, task);
+			x ^= x << 13;
+			x ^= x >> 17;
+			x ^= x << 5;
+			s_randomState = x;
+			return x;
+		}
 	}
 
-	JobID JobSystem::CreateAndRunJob(ExecutionPolicy executionPolicy, const std::function<void()>& task)
+	JobSystem::JobSystem()
 	{
-		JobID jobId = CreateJob(executionPolicy, task);
-		RunJob(jobId);
+		VT_ENSURE(s_instance == nullptr);
+		s_instance = this;
 
-		return jobId;
+		RegisterListener<AppUpdateEvent>(VT_BIND_EVENT_FN(JobSystem::OnUpdate));
 	}
 
-	JobID JobSystem::CreateJobAsChild(JobID parentJob, const std::function<void()>& task)
+	JobSystem::~JobSystem()
 	{
-		return CreateJobAsChild(ExecutionPolicy::WorkerThread, parentJob, task);
+		s_instance = nullptr;
 	}
 
-	JobID JobSystem::CreateJobAsChild(ExecutionPolicy executionPolicy, JobID parentJob, const std::function<void()>& task)
+	AllocatedJob JobSystem::AllocateJob(ExecutionPolicy executionPolicy, JobID parentJob)
 	{
 		VT_ENSURE(s_instance);
-		VT_ENSURE_MSG(parentJob != INVALID_JOB_ID, "The parent job must be a valid job ID!");
-
-		auto [jobPtr, jobId] = s_instance->AllocateJobInternal(executionPolicy, task, parentJob);
-		return jobId;
+		return s_instance->AllocateJobInternal(executionPolicy, parentJob);
 	}
 
 	void JobSystem::DestroyJob(JobID jobId)
@@ -81,13 +75,18 @@ namespace Volt
 			return;
 		}
 
-		while (!s_instance->HasCompletedJob(job))
+		const uint32_t slotIndex = s_instance->GetOrAssignThreadSlot();
+		while (!s_instance->HasCompletedJob(job, jobId))
 		{
-			Job* nextJob = s_instance->TryGetJob(0);
+			Job* nextJob = s_instance->TryGetJob(slotIndex);
 			if (nextJob)
 			{
 				s_instance->ExecuteJob(nextJob);
 			}
+			else
+			{
+				_mm_pause();
+			}
 		}
 	}
 
@@ -98,12 +97,11 @@ namespace Volt
 
 		auto& internalState = s_instance->m_internalState;
 		Job* jobPtr = s_instance->m_allocator.GetJobFromID(jobId);
+		VT_ENSURE_MSG(jobPtr, "Trying to run a job which has already finished!");
 
 		if (jobPtr->executionPolicy == ExecutionPolicy::WorkerThread)
 		{
-			const uint32_t nextQueueToPush = internalState.nextQueueToPush.fetch_add(1) % internalState.workerCount;
-			internalState.jobQueues.at(nextQueueToPush).Push(jobPtr);
-			internalState.wakeCondition.notify_one();
+			s_instance->PushJob(jobPtr);
 		}
 		else if (jobPtr->executionPolicy == ExecutionPolicy::MainThread)
 		{
@@ -111,6 +109,19 @@ namespace Volt
 		}
 	}
 
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		VT_ENSURE(s_instance);
+		return s_instance->m_internalState.workerCount;
+	}
+
+	size_t JobSystem::GetDefaultGrainSize(size_t count)
+	{
+		// The calling thread helps out while waiting, so count it as a worker.
+		const size_t threadCount = static_cast<size_t>(GetWorkerCount()) + 1;
+		return std::max(count / (threadCount * PARALLEL_FOR_CHUNKS_PER_WORKER), size_t(1));
+	}
+
 	void JobSystem::ExecuteMainThreadJobs()
 	{
 		auto& internalState = m_internalState;
@@ -129,8 +140,12 @@ namespace Volt
 		// Initialize num cores - 2 threads.
 		const uint32_t hardwareConcurrency = std::thread::hardware_concurrency() - 2;
 		m_internalState.workerCount = hardwareConcurrency;
-		m_internalState.jobQueues.resize(m_internalState.workerCount);
-		m_internalState.jobGroups.resize(MAX_JOB_GROUP_COUNT);
+
+		m_internalState.threadSlots.reserve(m_internalState.workerCount + MAX_EXTERNAL_THREAD_COUNT);
+		for (uint32_t i = 0; i < m_internalState.workerCount + MAX_EXTERNAL_THREAD_COUNT; i++)
+		{
+			m_internalState.threadSlots.emplace_back(CreateScope<ThreadSlot>());
+		}
 
 		for (uint32_t i = 0; i < hardwareConcurrency; i++)
 		{
@@ -143,13 +158,27 @@ namespace Volt
 			std::string threadName = std::format("Volt::Worker {}", i);
 			Thread::SetThreadName(worker.native_handle(), threadName);
 		}
+
+		// Lets modules below the job system, such as block compression in CoreUtilities, run on the workers.
+		Thread::SetParallelForFunction([](size_t count, const std::function<void(size_t)>& func)
+		{
+			JobSystem::ParallelFor(count, 1, func);
+		});
 	}
 
 	void JobSystem::Shutdown()
 	{
+		Thread::SetParallelForFunction(nullptr);
+
 		// Kill the job system, and wake all threads
 		m_internalState.alive = false;
-		m_internalState.wakeCondition.notify_all();
+
+		for (uint32_t i = 0; i < m_internalState.workerCount; i++)
+		{
+			auto& slot = *m_internalState.threadSlots[i];
+			slot.wakeToken.fetch_add(1);
+			slot.wakeToken.notify_all();
+		}
 
 		for (auto& w : m_workerThreads)
 		{
@@ -163,16 +192,17 @@ namespace Volt
 		return false;
 	}
 
-	JobSystem::AllocatedJob JobSystem::AllocateJobInternal(ExecutionPolicy executionPolicy, const std::function<void()>& task, JobID parentJob)
+	AllocatedJob JobSystem::AllocateJobInternal(ExecutionPolicy executionPolicy, JobID parentJob)
 	{
 		auto [newJob, jobId] = m_allocator.AllocateJob();
 		newJob->unfinishedJobs = 1;
-		newJob->func = task;
 		newJob->executionPolicy = executionPolicy;
 
 		if (parentJob != INVALID_JOB_ID)
 		{
 			Job* parentJobPtr = m_allocator.GetJobFromID(parentJob);
+			VT_ENSURE_MSG(parentJobPtr, "The parent job has already finished!");
+
 			Atomic::InterlockedIncrement(&parentJobPtr->unfinishedJobs);
 			newJob->parentJob = parentJob;
 		}
@@ -180,47 +210,158 @@ namespace Volt
 		return { newJob, jobId };
 	}
 
-	Job* JobSystem::TryGetJob(uint32_t workerId)
+	uint32_t JobSystem::GetOrAssignThreadSlot()
 	{
-		auto& workerQueue = m_internalState.jobQueues.at(workerId);
+		if (Utility::s_threadSlotIndex == INVALID_THREAD_SLOT)
+		{
+			const uint32_t externalSlot = m_internalState.nextExternalSlot.fetch_add(1);
+			if (externalSlot < MAX_EXTERNAL_THREAD_COUNT)
+			{
+				Utility::s_threadSlotIndex = m_internalState.workerCount + externalSlot;
+			}
+			else
+			{
+				VT_LOGC(Warning, LogJobSystem, "Out of external job slots, falling back to the shared overflow queue!");
+				Utility::s_threadSlotIndex = Utility::OVERFLOW_THREAD_SLOT;
+			}
+		}
 
-		Job* job = workerQueue.Pop();
-		if (!job)
+		return Utility::s_threadSlotIndex;
+	}
+
+	void JobSystem::PushJob(Job* job)
+	{
+		const uint32_t slotIndex = GetOrAssignThreadSlot();
+		if (slotIndex == Utility::OVERFLOW_THREAD_SLOT)
+		{
+			m_internalState.overflowQueue.Push(job);
+		}
+		else if (!m_internalState.threadSlots[slotIndex]->jobQueue.Push(job))
+		{
+			// The local queue is full, run the job in place instead of blocking.
+			ExecuteJob(job);
+			return;
+		}
+
+		// The push must be visible before we check for parked workers, pairs with the fence in ParkWorker.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		WakeWorker();
+	}
+
+	void JobSystem::WakeWorker()
+	{
+		if (m_internalState.parkedWorkerCount.load() == 0)
+		{
+			return;
+		}
+
+		const uint32_t workerCount = m_internalState.workerCount;
+		const uint32_t startIndex = Utility::NextRandom() % workerCount;
+
+		for (uint32_t i = 0; i < workerCount; i++)
+		{
+			auto& slot = *m_internalState.threadSlots[(startIndex + i) % workerCount];
+			if (slot.isParked.load(std::memory_order_relaxed) && slot.isParked.exchange(false))
+			{
+				m_internalState.parkedWorkerCount.fetch_sub(1);
+				slot.wakeToken.fetch_add(1, std::memory_order_release);
+				slot.wakeToken.notify_one();
+				return;
+			}
+		}
+	}
+
+	void JobSystem::ParkWorker(uint32_t workerId)
+	{
+		auto& slot = *m_internalState.threadSlots[workerId];
+		const uint32_t wakeToken = slot.wakeToken.load(std::memory_order_acquire);
+
+		slot.isParked.store(true);
+		m_internalState.parkedWorkerCount.fetch_add(1);
+
+		// A job might have been pushed before we were marked as parked, so check again before sleeping.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (HasQueuedJobs() || !m_internalState.alive.load())
+		{
+			if (slot.isParked.exchange(false))
+			{
+				m_internalState.parkedWorkerCount.fetch_sub(1);
+			}
+			return;
+		}
+
+		slot.wakeToken.wait(wakeToken, std::memory_order_acquire);
+	}
+
+	bool JobSystem::HasQueuedJobs() const
+	{
+		for (const auto& slot : m_internalState.threadSlots)
+		{
+			if (!slot->jobQueue.IsEmpty())
+			{
+				return true;
+			}
+		}
+
+		return !m_internalState.overflowQueue.IsEmpty();
+	}
+
+	Job* JobSystem::TryGetJob(uint32_t slotIndex)
+	{
+		if (slotIndex != Utility::OVERFLOW_THREAD_SLOT)
+		{
+			Job* job = m_internalState.threadSlots[slotIndex]->jobQueue.Pop();
+			if (job)
+			{
+				return job;
+			}
+		}
+
+		// Pick a random victim to start from, so that thieves don't all hammer the same queue.
+		const uint32_t slotCount = static_cast<uint32_t>(m_internalState.threadSlots.size());
+		const uint32_t startIndex = Utility::NextRandom() % slotCount;
+
+		for (uint32_t i = 0; i < slotCount; i++)
 		{
-			uint32_t currentQueue = (workerId + 1) % m_internalState.workerCount;
+			const uint32_t victimIndex = (startIndex + i) % slotCount;
+			if (victimIndex == slotIndex)
+			{
+				continue;
+			}
 
-			while (currentQueue != workerId)
+			Job* stolenJob = m_internalState.threadSlots[victimIndex]->jobQueue.Steal();
+			if (stolenJob)
 			{
-				auto& stealingQueue = m_internalState.jobQueues.at(currentQueue);
-				Job* stolenJob = stealingQueue.Steal();
-				if (stolenJob)
-				{
-					return stolenJob;
-				}
-
-				currentQueue = (currentQueue + 1) % m_internalState.workerCount;
+				return stolenJob;
 			}
 		}
 
-		return job;
+		return m_internalState.overflowQueue.Steal();
 	}
 
 	void JobSystem::SpawnWorker(uint32_t workerId)
 	{
+		Utility::s_threadSlotIndex = workerId;
+
+		uint32_t idleSpinCount = 0;
 		while (m_internalState.alive.load())
 		{
 			Job* job = TryGetJob(workerId);
-			const bool foundWork = job != nullptr;
-
-			if (foundWork)
+			if (job)
 			{
 				ExecuteJob(job);
+				idleSpinCount = 0;
+				continue;
 			}
-			else
+
+			if (++idleSpinCount < SPIN_COUNT_BEFORE_PARK)
 			{
-				std::unique_lock<std::mutex> lock{ m_internalState.wakeMutex };
-				m_internalState.wakeCondition.wait(lock);
+				_mm_pause();
+				continue;
 			}
+
+			idleSpinCount = 0;
+			ParkWorker(workerId);
 		}
 	}
 
@@ -244,8 +385,9 @@ namespace Volt
 		}
 	}
 
-	bool JobSystem::HasCompletedJob(Job* job)
+	bool JobSystem::HasCompletedJob(Job* job, JobID jobId)
 	{
-		return job->unfinishedJobs == 0;
+		// If the generation has changed the job has been freed, and the slot might already be reused.
+		return job->unfinishedJobs == 0 || job->id.load(std::memory_order_acquire) != jobId;
 	}
 }
@@ -6,82 +6,200 @@
 namespace Volt
 {
 	TaskGraph::TaskGraph(size_t predictedTaskCount)
-		: m_predictedTaskCount(predictedTaskCount)
 	{
-		CreateNewSubGraph();
+		m_tasks.reserve(predictedTaskCount);
+		m_tasksSinceBarrier.reserve(predictedTaskCount);
 	}
 
 	TaskGraph::~TaskGraph()
 	{
-		if (!m_executed)
-		{
-			for (auto& subGraph : m_subGraphs)
-			{
-				JobSystem::DestroyJob(subGraph.parentJobId);
-				for (const auto& jobId : subGraph.createdJobs)
-				{
-					JobSystem::DestroyJob(jobId);
-				}
-			}
-		}
+		// Running tasks reference the graph, so it can't go away until they are done.
+		Wait();
 	}
 
-	TaskID TaskGraph::AddTask(const std::function<void()>& task)
+	void TaskGraph::AddDependency(TaskID before, TaskID after)
 	{
-		auto& currentSubGraph = m_subGraphs.back();
+		VT_ENSURE(before < m_tasks.size() && after < m_tasks.size());
+		VT_ENSURE_MSG(before != after, "A task can't depend on itself!");
 
-		JobID newJobId = JobSystem::CreateJobAsChild(currentSubGraph.parentJobId, task);
-		currentSubGraph.createdJobs.emplace_back(newJobId);
-		return newJobId;
+		m_tasks[before].successors.emplace_back(after);
+		m_tasks[after].dependencyCount++;
+		m_isCompiled = false;
 	}
 
 	void TaskGraph::Barrier()
 	{
-		CreateNewSubGraph();
+		if (m_tasksSinceBarrier.empty())
+		{
+			return;
+		}
+
+		// The barrier is an empty task which waits for everything since the last barrier,
+		// which keeps the edge count linear instead of connecting every task on both sides.
+		m_currentBarrier = INVALID_TASK_ID;
+		const TaskID barrierTask = AddTaskInternal([]() {});
+
+		for (const auto& taskId : m_tasksSinceBarrier)
+		{
+			if (taskId != barrierTask)
+			{
+				AddDependency(taskId, barrierTask);
+			}
+		}
+
+		m_tasksSinceBarrier.clear();
+		m_currentBarrier = barrierTask;
 	}
 
-	void TaskGraph::Execute()
+	void TaskGraph::Compile()
 	{
-		m_executed = true;
+		m_rootTasks.clear();
 
-		for (size_t i = 0; auto& subGraph : m_subGraphs)
+		for (TaskID i = 0; i < static_cast<TaskID>(m_tasks.size()); i++)
 		{
-			for (const auto& jobId : subGraph.createdJobs)
+			if (m_tasks[i].dependencyCount == 0)
 			{
-				JobSystem::RunJob(jobId);
+				m_rootTasks.emplace_back(i);
 			}
+		}
 
-			JobSystem::RunJob(subGraph.parentJobId);
+		if (m_remainingDependenciesCapacity < m_tasks.size())
+		{
+			m_remainingDependencies = CreateScope<std::atomic_uint32_t[]>(m_tasks.size());
+			m_remainingDependenciesCapacity = m_tasks.size();
+		}
 
-			if (i < m_subGraphs.size() - 1)
+#ifdef VT_ENABLE_ENSURES
+		// Kahn's algorithm, all tasks must be reachable from the roots or the graph has a cycle.
+		{
+			Vector<uint32_t> dependencyCounts(m_tasks.size());
+			for (size_t i = 0; i < m_tasks.size(); i++)
 			{
-				JobSystem::WaitForJob(subGraph.parentJobId);
+				dependencyCounts[i] = m_tasks[i].dependencyCount;
+			}
+
+			Vector<TaskID> readyTasks = m_rootTasks;
+			size_t visitedCount = 0;
+
+			while (!readyTasks.empty())
+			{
+				const TaskID taskId = readyTasks.back();
+				readyTasks.pop_back();
+				visitedCount++;
+
+				for (const auto& successor : m_tasks[taskId].successors)
+				{
+					if (--dependencyCounts[successor] == 0)
+					{
+						readyTasks.emplace_back(successor);
+					}
+				}
 			}
 
-			i++;
+			VT_ENSURE_MSG(visitedCount == m_tasks.size(), "TaskGraph contains a cycle!");
 		}
+#endif
+
+		m_isCompiled = true;
+	}
+
+	void TaskGraph::Execute()
+	{
+		// The previous execution must be done before the counters can be reset.
+		Wait();
+
+		if (!m_isCompiled)
+		{
+			Compile();
+		}
+
+		for (size_t i = 0; i < m_tasks.size(); i++)
+		{
+			m_remainingDependencies[i].store(m_tasks[i].dependencyCount, std::memory_order_relaxed);
+		}
+
+		// All tasks are children of the execution job, so waiting on it waits for the whole graph.
+		m_executionJob = JobSystem::CreateJob([]() {});
+
+		for (const auto& taskId : m_rootTasks)
+		{
+			LaunchTask(taskId);
+		}
+
+		JobSystem::RunJob(m_executionJob);
 	}
 
 	void TaskGraph::ExecuteAndWait()
 	{
 		Execute();
-		JobSystem::WaitForJob(m_subGraphs.back().parentJobId);
+		Wait();
 	}
 
 	void TaskGraph::Wait()
 	{
-		VT_ENSURE(m_executed);
+		if (m_executionJob == INVALID_JOB_ID)
+		{
+			return;
+		}
+
+		JobSystem::WaitForJob(m_executionJob);
+		m_executionJob = INVALID_JOB_ID;
+	}
+
+	TaskID TaskGraph::AddTaskInternal(JobFunc&& task)
+	{
+		const TaskID taskId = static_cast<TaskID>(m_tasks.size());
+
+		auto& node = m_tasks.emplace_back();
+		node.func = std::move(task);
 
-		for (const auto& subGraph : m_subGraphs)
+		if (m_currentBarrier != INVALID_TASK_ID)
 		{
-			JobSystem::WaitForJob(subGraph.parentJobId);
+			AddDependency(m_currentBarrier, taskId);
 		}
+
+		m_tasksSinceBarrier.emplace_back(taskId);
+		m_isCompiled = false;
+
+		return taskId;
 	}
 
-	void TaskGraph::CreateNewSubGraph()
+	void TaskGraph::LaunchTask(TaskID taskId)
 	{
-		auto& newSubGraph = m_subGraphs.emplace_back();
-		newSubGraph.createdJobs.reserve(m_predictedTaskCount);
-		newSubGraph.parentJobId = JobSystem::CreateJob([]() {});
+		JobSystem::RunJob(JobSystem::CreateJobAsChild(m_executionJob, [this, taskId]()
+		{
+			RunTask(taskId);
+		}));
+	}
+
+	void TaskGraph::RunTask(TaskID taskId)
+	{
+		TaskID currentTask = taskId;
+		while (currentTask != INVALID_TASK_ID)
+		{
+			auto& node = m_tasks[currentTask];
+			node.func();
+
+			// The first successor that becomes ready runs on this thread, the rest are launched as new jobs.
+			TaskID nextTask = INVALID_TASK_ID;
+			for (const auto& successor : node.successors)
+			{
+				if (m_remainingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) != 1)
+				{
+					continue;
+				}
+
+				if (nextTask == INVALID_TASK_ID)
+				{
+					nextTask = successor;
+				}
+				else
+				{
+					LaunchTask(successor);
+				}
+			}
+
+			currentTask = nextTask;
+		}
 	}
 }
@@ -1,15 +1,20 @@
 #pragma once
 
+#include <CoreUtilities/Functional/InlineFunction.h>
+
 #include <atomic>
 #include <functional>
 
 namespace Volt
 {
-	using JobID = uint32_t;
-	using JobFunc = std::function<void()>;
+	constexpr size_t TARGET_SIZE = 128;
+	constexpr size_t JOB_FUNCTION_CAPACITY = 88;
+
+	// Lower 32 bits is the slot index, upper 32 bits is the generation of the slot.
+	using JobID = uint64_t;
+	using JobFunc = InlineFunction<void(), JOB_FUNCTION_CAPACITY>;
 
 	constexpr JobID INVALID_JOB_ID = std::numeric_limits<JobID>::max();
-	constexpr size_t TARGET_SIZE = 128;
 
 	enum class ExecutionPolicy
 	{
@@ -19,12 +24,17 @@ namespace Volt
 
 	struct Job
 	{
-		// #TODO_Ivar: Switch to not using std::function as std::function is very large.
 		JobFunc func;
 		JobID parentJob = INVALID_JOB_ID;
+
+		// Current ID of the slot, changes generation every time the job is freed.
+		std::atomic<JobID> id = INVALID_JOB_ID;
+
 		volatile long unfinishedJobs = 0;
 		ExecutionPolicy executionPolicy = ExecutionPolicy::WorkerThread;
 
-		char alignmentPadding[TARGET_SIZE - sizeof(func) - sizeof(parentJob) - sizeof(unfinishedJobs) - sizeof(executionPolicy)];
+		char alignmentPadding[TARGET_SIZE - sizeof(func) - sizeof(parentJob) - sizeof(id) - sizeof(unfinishedJobs) - sizeof(executionPolicy)];
 	};
+
+	static_assert(sizeof(Job) == TARGET_SIZE, "Job must fit in its target size!");
 }
@@ -2,8 +2,6 @@
 
 #include "JobSystem/Job.h"
 
-#include <CoreUtilities/Containers/Vector.h>
-
 #include <atomic>
 
 namespace Volt
@@ -14,25 +12,53 @@ namespace Volt
 		JobID id;
 	};
 
+	struct JobAllocatorThreadCache;
+
+	// Lock free job slot pool. Slots are allocated in pages and cached per thread,
+	// the shared free list is only touched when a thread cache runs empty or overflows.
 	class JobAllocator
 	{
 	public:
 		JobAllocator();
+		~JobAllocator();
 
 		AllocatedJob AllocateJob();
 		void FreeJob(JobID id);
 		void FreeJob(Job* job);
-		Job* GetJobFromID(JobID id);
+
+		// Returns nullptr if the ID is stale, which means that the job has finished and it's slot has been freed.
+		Job* GetJobFromID(JobID id) const;
+
+		inline static constexpr uint32_t GetIndexFromID(JobID id) { return static_cast<uint32_t>(id & 0xFFFFFFFFull); }
+		inline static constexpr uint32_t GetGenerationFromID(JobID id) { return static_cast<uint32_t>(id >> 32ull); }
+		inline static constexpr JobID CreateID(uint32_t index, uint32_t generation) { return (static_cast<JobID>(generation) << 32ull) | static_cast<JobID>(index); }
 
 	private:
-		inline static constexpr uint32_t MAX_JOB_COUNT = 8096;
-		
-		std::atomic_uint32_t m_jobAllocationIndex = 0;
-		std::atomic_uint32_t m_currentTailIndex = 0;
+		friend struct JobAllocatorThreadCache;
+
+		inline static constexpr uint32_t PAGE_SIZE = 1024;
+		inline static constexpr uint32_t MAX_PAGE_COUNT = 1024;
+		inline static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+		struct Page
+		{
+			Job jobs[PAGE_SIZE];
+			std::atomic_uint32_t nextFree[PAGE_SIZE];
+		};
+
+		void RefillThreadCache(JobAllocatorThreadCache& cache);
+		void FlushThreadCache(JobAllocatorThreadCache& cache, uint32_t count);
+
+		uint32_t PopFreeIndex();
+		void PushFreeIndex(uint32_t index);
+
+		Page& GetOrCreatePage(uint32_t pageIndex);
+		Job& GetJob(uint32_t index) const;
 
-		Vector<Job> m_jobAllocator;
+		std::atomic<Page*> m_pages[MAX_PAGE_COUNT];
+		std::atomic_uint32_t m_nextUnusedIndex = 0;
 
-		std::mutex m_freeJobsMutex;
-		Vector<JobID> m_freeJobs;
+		// Lower 32 bits is the head index, upper 32 bits is a tag to avoid ABA issues.
+		std::atomic_uint64_t m_freeListHead = INVALID_INDEX;
 	};
 }
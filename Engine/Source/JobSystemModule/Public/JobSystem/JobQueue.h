@@ -2,25 +2,36 @@
 
 #include "JobSystem/Config.h"
 
+#include <atomic>
+#include <cstdint>
+
 namespace Volt
 {
 	struct Job;
+
+	// Chase-Lev work stealing deque.
+	// Push and Pop may only be called by the owning thread, Steal may be called from any thread.
 	class VTJS_API JobQueue
 	{
 	public:
 		JobQueue();
 		~JobQueue();
 
-		void Push(Job* job);
+		// Returns false if the queue is full.
+		bool Push(Job* job);
 		Job* Pop();
 		Job* Steal();
 
+		bool IsEmpty() const;
+
 	private:
 		inline static constexpr uint32_t MAX_JOB_COUNT = 4096u;
 		inline static constexpr uint32_t MASK = MAX_JOB_COUNT - 1u;
+		inline static constexpr size_t CACHE_LINE_SIZE = 64;
 
-		Job* m_jobQueue[MAX_JOB_COUNT];
-		long m_bottom = 0;
-		long m_top = 0;
+		// Top and bottom live on separate cache lines, as thieves only touch top.
+		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_top = 0;
+		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_bottom = 0;
+		alignas(CACHE_LINE_SIZE) std::atomic<Job*> m_jobQueue[MAX_JOB_COUNT];
 	};
 }
@@ -19,6 +19,8 @@ namespace Volt
 		Job* Pop();
 		Job* Steal();
 
+		bool IsEmpty() const;
+
 	private:
 		inline static constexpr uint32_t MAX_JOB_COUNT = 4096u;
 		inline static constexpr uint32_t MASK = MAX_JOB_COUNT - 1u;
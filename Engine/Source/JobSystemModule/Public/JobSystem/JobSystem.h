@@ -1,6 +1,7 @@
 #pragma once
 
 #include "JobSystem/Job.h"
+#include "JobSystem/JobQueue.h"
 #include "JobSystem/JobQueueLocking.h"
 #include "JobSystem/JobAllocator.h"
 
@@ -11,11 +12,6 @@
 
 namespace Volt
 {
-	struct JobGroup
-	{
-		long unfinishedJobs = 0;
-	};
-
 	class AppUpdateEvent;
 	class VTJS_API JobSystem : public SubSystem, EventListener
 	{
@@ -23,44 +19,89 @@ namespace Volt
 		JobSystem();
 		~JobSystem();
 
-		static JobID CreateJob(const std::function<void()>& task);
-		static JobID CreateJob(ExecutionPolicy executionPolicy, const std::function<void()>& task);
-		static JobID CreateAndRunJob(const std::function<void()>& task);
-		static JobID CreateAndRunJob(ExecutionPolicy executionPolicy, const std::function<void()>& task);
-		static JobID CreateJobAsChild(JobID parentJob, const std::function<void()>& task);
-		static JobID CreateJobAsChild(ExecutionPolicy executionPolicy, JobID parentJob, const std::function<void()>& task);
+		// The task is moved straight into the job slot, it must fit within JOB_FUNCTION_CAPACITY bytes.
+		template<typename F>
+		static JobID CreateJob(F&& task);
+
+		template<typename F>
+		static JobID CreateJob(ExecutionPolicy executionPolicy, F&& task);
+
+		template<typename F>
+		static JobID CreateAndRunJob(F&& task);
+
+		template<typename F>
+		static JobID CreateAndRunJob(ExecutionPolicy executionPolicy, F&& task);
+
+		template<typename F>
+		static JobID CreateJobAsChild(JobID parentJob, F&& task);
+
+		template<typename F>
+		static JobID CreateJobAsChild(ExecutionPolicy executionPolicy, JobID parentJob, F&& task);
 
 		static void DestroyJob(JobID jobId);
 
 		static void WaitForJob(JobID jobId);
 		static void RunJob(JobID jobId);
 
+		// Calls func(index) for every index in [0, count) and returns once all of them have finished.
+		// The range is split in halves until it is smaller than the grain size, and the halves that are
+		// split off can be stolen by idle workers. A grain size of zero picks one from the worker count.
+		template<typename F>
+		static void ParallelFor(size_t count, size_t grainSize, F&& func);
+
+		template<typename F>
+		static void ParallelFor(size_t count, F&& func);
+
+		// Calls func(begin, end) -> T for grain sized chunks of [0, count) in parallel, and then
+		// combines the partial results in chunk order using reduceFunc(T, T) -> T.
+		template<typename T, typename F, typename ReduceFunc>
+		static T ParallelReduce(size_t count, size_t grainSize, const T& identity, F&& func, ReduceFunc&& reduceFunc);
+
+		static uint32_t GetWorkerCount();
+		static size_t GetDefaultGrainSize(size_t count);
+
 		VT_DECLARE_SUBSYSTEM("{FBB8F365-99B3-416D-84EA-702BD4F56962}"_guid)
 
 	private:
+		struct alignas(64) ThreadSlot
+		{
+			JobQueue jobQueue;
+
+			// Parking primitive, only used by worker slots.
+			std::atomic_bool isParked = false;
+			std::atomic_uint32_t wakeToken = 0;
+		};
+
 		struct InternalState
 		{
 			std::atomic_bool alive = true;
-			std::atomic_uint32_t nextQueueToPush = 0;
-			std::atomic_uint32_t nextJobGroupIndex = 0;
-			std::atomic_uint32_t aliveJobGroupCount = 0;
-			std::mutex wakeMutex;
-			std::condition_variable wakeCondition;
+			std::atomic_uint32_t nextExternalSlot = 0;
+			std::atomic_uint32_t parkedWorkerCount = 0;
 			uint32_t workerCount = 0;
 
-			Vector<JobGroup> jobGroups;
-			//Vector<JobQueue> jobQueues;
-			Vector<JobQueueLocking> jobQueues;
+			// Slots [0, workerCount) belong to the workers, the rest are handed out to other threads on first use.
+			Vector<Scope<ThreadSlot>> threadSlots;
+
+			// Used by external threads once all external slots have been handed out.
+			JobQueueLocking overflowQueue;
 			JobQueueLocking mainThreadQueue;
 		};
 
-		struct AllocatedJob
+		template<typename F>
+		struct ParallelForContext
 		{
-			Job* ptr;
-			JobID id;
+			F* func;
+			size_t grainSize;
+			JobID rootJob;
 		};
 
-		inline static constexpr uint32_t MAX_JOB_GROUP_COUNT = 1024;
+		template<typename F>
+		static void ParallelForRange(const ParallelForContext<F>* context, size_t begin, size_t end);
+
+		inline static constexpr uint32_t MAX_EXTERNAL_THREAD_COUNT = 16;
+		inline static constexpr size_t PARALLEL_FOR_CHUNKS_PER_WORKER = 4;
+		inline static constexpr uint32_t INVALID_THREAD_SLOT = std::numeric_limits<uint32_t>::max();
+		inline static constexpr uint32_t SPIN_COUNT_BEFORE_PARK = 256;
 
 		void Initialize() override;
 		void Shutdown() override;
@@ -69,14 +110,21 @@ namespace Volt
 
 		void ExecuteMainThreadJobs();
 
-		AllocatedJob AllocateJobInternal(ExecutionPolicy executionPolicy, const std::function<void()>& task, JobID parentJob = INVALID_JOB_ID);
+		static AllocatedJob AllocateJob(ExecutionPolicy executionPolicy, JobID parentJob);
+		AllocatedJob AllocateJobInternal(ExecutionPolicy executionPolicy, JobID parentJob = INVALID_JOB_ID);
 
-		Job* TryGetJob(uint32_t workerId);
+		uint32_t GetOrAssignThreadSlot();
+		void PushJob(Job* job);
+		void WakeWorker();
+		void ParkWorker(uint32_t workerId);
+		bool HasQueuedJobs() const;
+
+		Job* TryGetJob(uint32_t slotIndex);
 		void SpawnWorker(uint32_t workerId);
 		void ExecuteJob(Job* job);
 		void FinishJob(Job* job, JobAllocator& allocator);
 
-		bool HasCompletedJob(Job* job);
+		bool HasCompletedJob(Job* job, JobID jobId);
 
 		inline static JobSystem* s_instance = nullptr;
 
@@ -84,4 +132,138 @@ namespace Volt
 		JobAllocator m_allocator;
 		Vector<std::thread> m_workerThreads;
 	};
+
+	template<typename F>
+	inline JobID JobSystem::CreateJob(F&& task)
+	{
+		return CreateJob(ExecutionPolicy::WorkerThread, std::forward<F>(task));
+	}
+
+	template<typename F>
+	inline JobID JobSystem::CreateJob(ExecutionPolicy executionPolicy, F&& task)
+	{
+		auto [jobPtr, jobId] = AllocateJob(executionPolicy, INVALID_JOB_ID);
+		jobPtr->func = std::forward<F>(task);
+		return jobId;
+	}
+
+	template<typename F>
+	inline JobID JobSystem::CreateAndRunJob(F&& task)
+	{
+		return CreateAndRunJob(ExecutionPolicy::WorkerThread, std::forward<F>(task));
+	}
+
+	template<typename F>
+	inline JobID JobSystem::CreateAndRunJob(ExecutionPolicy executionPolicy, F&& task)
+	{
+		JobID jobId = CreateJob(executionPolicy, std::forward<F>(task));
+		RunJob(jobId);
+
+		return jobId;
+	}
+
+	template<typename F>
+	inline JobID JobSystem::CreateJobAsChild(JobID parentJob, F&& task)
+	{
+		return CreateJobAsChild(ExecutionPolicy::WorkerThread, parentJob, std::forward<F>(task));
+	}
+
+	template<typename F>
+	inline JobID JobSystem::CreateJobAsChild(ExecutionPolicy executionPolicy, JobID parentJob, F&& task)
+	{
+		VT_ENSURE_MSG(parentJob != INVALID_JOB_ID, "The parent job must be a valid job ID!");
+
+		auto [jobPtr, jobId] = AllocateJob(executionPolicy, parentJob);
+		jobPtr->func = std::forward<F>(task);
+		return jobId;
+	}
+
+	template<typename F>
+	inline void JobSystem::ParallelFor(size_t count, size_t grainSize, F&& func)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (grainSize == 0)
+		{
+			grainSize = GetDefaultGrainSize(count);
+		}
+
+		if (count <= grainSize)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				func(i);
+			}
+			return;
+		}
+
+		ParallelForContext<std::remove_reference_t<F>> context{ &func, grainSize, CreateJob([]() {}) };
+		ParallelForRange(&context, 0, count);
+
+		RunJob(context.rootJob);
+		WaitForJob(context.rootJob);
+	}
+
+	template<typename F>
+	inline void JobSystem::ParallelFor(size_t count, F&& func)
+	{
+		ParallelFor(count, 0, std::forward<F>(func));
+	}
+
+	template<typename T, typename F, typename ReduceFunc>
+	inline T JobSystem::ParallelReduce(size_t count, size_t grainSize, const T& identity, F&& func, ReduceFunc&& reduceFunc)
+	{
+		if (count == 0)
+		{
+			return identity;
+		}
+
+		if (grainSize == 0)
+		{
+			grainSize = GetDefaultGrainSize(count);
+		}
+
+		const size_t chunkCount = (count + grainSize - 1) / grainSize;
+		Vector<T> partialResults(chunkCount, identity);
+
+		ParallelFor(chunkCount, 1, [&](size_t chunkIndex)
+		{
+			const size_t begin = chunkIndex * grainSize;
+			const size_t end = std::min(begin + grainSize, count);
+			partialResults[chunkIndex] = func(begin, end);
+		});
+
+		// Combined in order, so the result doesn't depend on which worker ran which chunk.
+		T result = identity;
+		for (const auto& partialResult : partialResults)
+		{
+			result = reduceFunc(result, partialResult);
+		}
+
+		return result;
+	}
+
+	template<typename F>
+	inline void JobSystem::ParallelForRange(const ParallelForContext<F>* context, size_t begin, size_t end)
+	{
+		// Keep splitting off the upper half as a stealable job, and process what is left on this thread.
+		while (end - begin > context->grainSize)
+		{
+			const size_t middle = begin + (end - begin) / 2;
+			RunJob(CreateJobAsChild(context->rootJob, [context, middle, end]()
+			{
+				ParallelForRange(context, middle, end);
+			}));
+
+			end = middle;
+		}
+
+		for (size_t i = begin; i < end; i++)
+		{
+			(*context->func)(i);
+		}
+	}
 }
@@ -3,6 +3,7 @@
 #include "JobSystem/Config.h"
 
 #include "JobSystem/Job.h"
+#include "JobSystem/JobSystem.h"
 
 #include <cstdint>
 #include <functional>
@@ -11,6 +12,11 @@ namespace Volt
 {
 	using TaskID = uint32_t;
 
+	constexpr TaskID INVALID_TASK_ID = std::numeric_limits<TaskID>::max();
+
+	// Graph of tasks with explicit dependency edges.
+	// A graph can be executed any number of times, as long as the previous execution has finished.
+	// The tasks and edges are kept between executions, so a per frame graph only has to be built once.
 	class VTJS_API TaskGraph
 	{
 	public:
@@ -19,25 +25,64 @@ namespace Volt
 
 		VT_DELETE_COPY_MOVE(TaskGraph);
 
-		TaskID AddTask(const std::function<void()>& task);
+		// Tasks added after a call to Barrier depend on all tasks added before it.
+		template<typename F>
+		TaskID AddTask(F&& task);
+
+		// Adds a task which runs once the antecedent task has finished.
+		template<typename F>
+		TaskID AddContinuation(TaskID antecedent, F&& task);
+
+		void AddDependency(TaskID before, TaskID after);
 
 		void Barrier();
 
+		// Sorts out the root tasks and validates that the graph has no cycles.
+		// Called by Execute if the graph has changed since the last compile.
+		void Compile();
+
 		void Execute();
 		void ExecuteAndWait();
 		void Wait();
 
+		VT_INLINE size_t GetTaskCount() const { return m_tasks.size(); }
+
 	private:
-		struct TaskSubGraph
+		struct TaskNode
 		{
-			JobID parentJobId;
-			Vector<JobID> createdJobs;
+			JobFunc func;
+			Vector<TaskID> successors;
+			uint32_t dependencyCount = 0;
 		};
 
-		void CreateNewSubGraph();
+		TaskID AddTaskInternal(JobFunc&& task);
+
+		void LaunchTask(TaskID taskId);
+		void RunTask(TaskID taskId);
 
-		Vector<TaskSubGraph> m_subGraphs;
-		size_t m_predictedTaskCount;
-		bool m_executed = false;
+		Vector<TaskNode> m_tasks;
+		Vector<TaskID> m_rootTasks;
+		Scope<std::atomic_uint32_t[]> m_remainingDependencies;
+		size_t m_remainingDependenciesCapacity = 0;
+
+		Vector<TaskID> m_tasksSinceBarrier;
+		TaskID m_currentBarrier = INVALID_TASK_ID;
+
+		JobID m_executionJob = INVALID_JOB_ID;
+		bool m_isCompiled = false;
 	};
+
+	template<typename F>
+	inline TaskID TaskGraph::AddTask(F&& task)
+	{
+		return AddTaskInternal(JobFunc{ std::forward<F>(task) });
+	}
+
+	template<typename F>
+	inline TaskID TaskGraph::AddContinuation(TaskID antecedent, F&& task)
+	{
+		const TaskID taskId = AddTask(std::forward<F>(task));
+		AddDependency(antecedent, taskId);
+		return taskId;
+	}
 }
@@ -23,6 +23,7 @@ namespace VoltSharpmake
             conf.AddPublicDependency<RecastDetour>(target);
 
             conf.AddPrivateDependency<LogModule>(target);
+            conf.AddPrivateDependency<JobSystemModule>(target);
             conf.AddPrivateDependency<AssetSystemModule>(target);
             conf.AddPrivateDependency<EntitySystemModule>(target);
             conf.AddPrivateDependency<VoltRenderCore>(target);
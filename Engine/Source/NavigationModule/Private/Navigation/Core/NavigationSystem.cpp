@@ -14,6 +14,8 @@
 
 #include <AssetSystem/AssetManager.h>
 
+#include <JobSystem/JobSystem.h>
+
 namespace Volt
 {
 	namespace AI
@@ -26,6 +28,11 @@ namespace Volt
 			RegisterListener<Volt::OnSceneLoadedEvent>(VT_BIND_EVENT_FN(NavigationSystem::OnSceneLoadedEvent));
 		}
 
+		NavigationSystem::~NavigationSystem()
+		{
+			SetActiveScene(nullptr);
+		}
+
 		void NavigationSystem::SetVTNavMesh(Ref<NavMesh> navmesh)
 		{
 			myNavMesh = navmesh;
@@ -43,78 +50,219 @@ namespace Volt
 					return false;
 				}
 
-				auto& agentMap = crowd->GetAgentMap();
 				{
-					VT_PROFILE_SCOPE("Remove old agents");
+					VT_PROFILE_SCOPE("Add & remove changed agents");
+					ApplyAgentChanges();
+				}
 
-					for (auto [entityId, agentId] : agentMap)
-					{
-						auto entity = myActiveScene->GetEntityFromID(entityId);
+				{
+					VT_PROFILE_SCOPE("Sync agents from entities");
+					SyncAgentsFromEntities(e.GetTimestep());
+				}
 
-						if (!entity || !entity.HasComponent<Volt::NavAgentComponent>())
-						{
-							crowd->RemoveAgent(entity);
-						}
+				{
+					VT_PROFILE_SCOPE("Detour crowd update");
+					myNavMesh->Update(e.GetTimestep());
+				}
 
-						if (myEntityIdToTargetPosMap.contains(entityId))
-						{
-							myEntityIdToTargetPosMap.erase(entityId);
-						}
-					}
+				{
+					VT_PROFILE_SCOPE("Update agent positions");
+					WriteBackAgentPositions(e.GetTimestep());
 				}
+			}
+
+			return false;
+		}
+
+		void NavigationSystem::SetActiveScene(Ref<Scene> scene)
+		{
+			if (myActiveScene)
+			{
+				auto& registry = myActiveScene->GetRegistry();
+				registry.on_construct<Volt::NavAgentComponent>().disconnect<&NavigationSystem::OnNavAgentConstructed>(*this);
+				registry.on_destroy<Volt::NavAgentComponent>().disconnect<&NavigationSystem::OnNavAgentDestroyed>(*this);
+			}
+
+			myActiveScene = scene;
 
+			myAddedAgents.clear();
+			myRemovedAgents.clear();
+
+			if (myActiveScene)
+			{
+				auto& registry = myActiveScene->GetRegistry();
+				registry.on_construct<Volt::NavAgentComponent>().connect<&NavigationSystem::OnNavAgentConstructed>(*this);
+				registry.on_destroy<Volt::NavAgentComponent>().connect<&NavigationSystem::OnNavAgentDestroyed>(*this);
+			}
+		}
+
+		void NavigationSystem::OnNavAgentConstructed(entt::registry& registry, entt::entity entityHandle)
+		{
+			// Agents are only simulated while playing, and are all added when the runtime starts
+			if (myActiveScene->IsPlaying())
+			{
+				myAddedAgents.emplace_back(entityHandle);
+			}
+		}
+
+		void NavigationSystem::OnNavAgentDestroyed(entt::registry& registry, entt::entity entityHandle)
+		{
+			if (myActiveScene->IsPlaying())
+			{
+				myRemovedAgents.emplace_back(entityHandle);
+			}
+		}
+
+		void NavigationSystem::ApplyAgentChanges()
+		{
+			auto& crowd = myNavMesh->GetCrowd();
+			auto& registry = myActiveScene->GetRegistry();
+
+			// Removed first, so that an agent whose component was removed and added again is added back
+			for (const auto entityHandle : myRemovedAgents)
+			{
+				crowd->RemoveAgent(entityHandle);
+				myPausedAgentTargets.erase(entityHandle);
+			}
+
+			for (const auto entityHandle : myAddedAgents)
+			{
+				// Skips agents which were removed again within the same frame
+				if (!registry.valid(entityHandle) || !registry.all_of<Volt::NavAgentComponent>(entityHandle) || crowd->HasAgent(entityHandle))
 				{
-					VT_PROFILE_SCOPE("Add new agents & disable movement on inactive agents");
+					continue;
+				}
 
-					auto& registry = myActiveScene->GetRegistry();
+				crowd->AddAgent(Volt::Entity(entityHandle, myActiveScene));
+			}
 
-					auto view = registry.view<const Volt::NavAgentComponent>();
-					view.each([&](const entt::entity id, const Volt::NavAgentComponent& comp)
-					{
-						auto entity = Volt::Entity(id, myActiveScene);
+			myAddedAgents.clear();
+			myRemovedAgents.clear();
+		}
 
-						crowd->SetAgentPosition(entity, entity.GetPosition());
+		void NavigationSystem::SyncAgentsFromEntities(float deltaTime)
+		{
+			auto& crowd = myNavMesh->GetCrowd();
+			dtCrowd* detourCrowd = crowd->GetDTCrowd().get();
+
+			const auto& agentEntities = crowd->GetAgentEntities();
+			const auto& agentIndices = crowd->GetAgentIndices();
 
-						if (!crowd->GetAgentMap().contains(entity.GetID()))
-						{
-							crowd->AddAgent(entity);
-							crowd->UpdateAgentParams(entity);
-						}
-						else if (!comp.active)
-						{
-							PauseAgent(entity, e.GetTimestep());
-						}
-						else if (comp.active)
-						{
-							UnpauseAgent(entity);
-						}
-					});
+			myAgentStates.resize(agentEntities.size());
+
+			JobSystem::ParallelFor(agentEntities.size(), [&](size_t agentIndex)
+			{
+				const entt::entity entityHandle = agentEntities[agentIndex];
+				const Volt::Entity entity(entityHandle, myActiveScene);
+
+				const bool isActive = entity.GetComponent<Volt::NavAgentComponent>().active;
+				const bool isPaused = myPausedAgentTargets.contains(entityHandle);
+
+				if (isActive)
+				{
+					myAgentStates[agentIndex] = isPaused ? AgentState::Unpausing : AgentState::Active;
+				}
+				else
+				{
+					myAgentStates[agentIndex] = isPaused ? AgentState::Inactive : AgentState::Pausing;
 				}
 
+				// The entity may have been moved by something else since the last update
+				dtCrowdAgent* agent = detourCrowd->getEditableAgent(agentIndices[agentIndex]);
+				if (agent && agent->active)
 				{
-					VT_PROFILE_SCOPE("Detour crowd update");
-					myNavMesh->Update(e.GetTimestep());
+					*(glm::vec3*)&agent->npos = entity.GetPosition();
 				}
+			});
 
+			// Changing the target uses the navmesh query of the crowd, so only agents that change state are handled, one at a time
+			for (size_t agentIndex = 0; agentIndex < agentEntities.size(); agentIndex++)
+			{
+				const AgentState state = myAgentStates[agentIndex];
+				if (state == AgentState::Pausing)
 				{
-					VT_PROFILE_SCOPE("Update agent positions");
-					for (auto [entityId, agentId] : agentMap)
+					PauseAgent(Volt::Entity(agentEntities[agentIndex], myActiveScene), deltaTime);
+				}
+				else if (state == AgentState::Unpausing)
+				{
+					UnpauseAgent(Volt::Entity(agentEntities[agentIndex], myActiveScene));
+				}
+			}
+		}
+
+		void NavigationSystem::WriteBackAgentPositions(float deltaTime)
+		{
+			auto& crowd = myNavMesh->GetCrowd();
+			const dtCrowd* detourCrowd = crowd->GetDTCrowd().get();
+
+			const auto& agentEntities = crowd->GetAgentEntities();
+			const auto& agentIndices = crowd->GetAgentIndices();
+
+			myAgentLocalPositions.resize(agentEntities.size());
+			myAgentWriteBacks.resize(agentEntities.size());
+
+			// The new local positions are calculated in parallel, only the agents that moved are written
+			JobSystem::ParallelFor(agentEntities.size(), [&](size_t agentIndex)
+			{
+				myAgentWriteBacks[agentIndex] = AgentWriteBack::None;
+
+				const AgentState state = myAgentStates[agentIndex];
+				if (state == AgentState::Inactive || state == AgentState::Pausing)
+				{
+					return;
+				}
+
+				const Volt::Entity entity(agentEntities[agentIndex], myActiveScene);
+
+				// Moved through the physics scene, which has to be done on this thread
+				if (entity.HasComponent<Volt::CharacterControllerComponent>())
+				{
+					myAgentWriteBacks[agentIndex] = AgentWriteBack::CharacterController;
+					return;
+				}
+
+				const dtCrowdAgent* agent = detourCrowd->getAgent(agentIndices[agentIndex]);
+				const glm::vec3 position = *(const glm::vec3*)&agent->npos;
+
+				glm::vec3 localPosition = position;
+				if (Volt::Entity parent = entity.GetParent())
+				{
+					const TQS parentTransform = myActiveScene->GetEntityWorldTQS(parent);
+					localPosition = (glm::conjugate(parentTransform.rotation) * (position - parentTransform.translation)) / parentTransform.scale;
+				}
+
+				if (localPosition != entity.GetLocalPosition())
+				{
+					myAgentLocalPositions[agentIndex] = localPosition;
+					myAgentWriteBacks[agentIndex] = AgentWriteBack::Transform;
+				}
+			});
+
+			for (size_t agentIndex = 0; agentIndex < agentEntities.size(); agentIndex++)
+			{
+				switch (myAgentWriteBacks[agentIndex])
+				{
+					case AgentWriteBack::Transform:
 					{
-						Volt::Entity entity = myActiveScene->GetEntityFromID(entityId);
-						if (entity.GetComponent<NavAgentComponent>().active)
-						{
-							SyncDetourPosition(entity, e.GetTimestep());
-						}
+						Volt::Entity entity(agentEntities[agentIndex], myActiveScene);
+						entity.SetLocalPosition(myAgentLocalPositions[agentIndex]);
+						break;
+					}
+					case AgentWriteBack::CharacterController:
+					{
+						SyncDetourPosition(Volt::Entity(agentEntities[agentIndex], myActiveScene), deltaTime);
+						break;
 					}
 				}
 			}
-
-			return false;
 		}
 
 		bool NavigationSystem::OnSceneLoadedEvent(Volt::OnSceneLoadedEvent& e)
 		{
-			myActiveScene = e.GetScene();
+			// The agents belong to the previous scene, whether or not the new one has a nav mesh
+			ClearAgents();
+			SetActiveScene(e.GetScene());
+
 			const auto& metadata = AssetManager::GetMetadataFromHandle(myActiveScene->handle);
 
 			if (!metadata.IsValid())
@@ -134,6 +282,7 @@ namespace Volt
 
 			if (myActiveScene->IsPlaying())
 			{
+				// The new nav mesh might have been used by an earlier session
 				ClearAgents();
 				InitAgents();
 			}
@@ -153,10 +302,10 @@ namespace Volt
 
 		void NavigationSystem::PauseAgent(Volt::Entity entity, float deltaTime)
 		{
-			if (myEntityIdToTargetPosMap.contains(entity.GetID())) { return; }
+			if (myPausedAgentTargets.contains(entity.GetHandle())) { return; }
 			auto& crowd = myNavMesh->GetCrowd();
 
-			myEntityIdToTargetPosMap[entity.GetID()] = *(glm::vec3*)&crowd->GetAgent(entity.GetID())->targetPos;
+			myPausedAgentTargets[entity.GetHandle()] = *(glm::vec3*)&crowd->GetAgent(entity)->targetPos;
 			crowd->ResetAgentTarget(entity);
 
 			SyncDetourPosition(entity, deltaTime);
@@ -164,12 +313,13 @@ namespace Volt
 
 		void NavigationSystem::UnpauseAgent(Volt::Entity entity)
 		{
-			if (!myEntityIdToTargetPosMap.contains(entity.GetID())) { return; }
+			auto it = myPausedAgentTargets.find(entity.GetHandle());
+			if (it == myPausedAgentTargets.end()) { return; }
 
 			auto& crowd = myNavMesh->GetCrowd();
-			crowd->SetAgentTarget(entity, myEntityIdToTargetPosMap.at(entity.GetID()));
+			crowd->SetAgentTarget(entity, it->second);
 
-			myEntityIdToTargetPosMap.erase(entity.GetID());
+			myPausedAgentTargets.erase(it);
 		}
 
 		void NavigationSystem::SyncDetourPosition(Volt::Entity entity, float deltaTime)
@@ -226,9 +376,15 @@ namespace Volt
 				auto view = registry.view<const Volt::NavAgentComponent>();
 				view.each([&](const entt::entity id, const Volt::NavAgentComponent& comp)
 				{
-					Volt::Entity entity(id, myActiveScene);
-					crowd->AddAgent(entity);
+					if (!crowd->HasAgent(id))
+					{
+						crowd->AddAgent(Volt::Entity(id, myActiveScene));
+					}
 				});
+
+				// Everything that was added before now is already in the crowd
+				myAddedAgents.clear();
+				myRemovedAgents.clear();
 			}
 		}
 
@@ -242,6 +398,8 @@ namespace Volt
 					crowd->ClearAgents();
 				}
 			}
+
+			myPausedAgentTargets.clear();
 		}
 	}
 }
@@ -3,6 +3,8 @@
 
 #include "Navigation/Core/CoreInterfaces.h"
 
+#include <JobSystem/JobSystem.h>
+
 #include <DetourCommon.h>
 
 namespace Volt
@@ -17,12 +19,35 @@ namespace Volt
 			dtVscale(vel, vel, speed);
 		}
 
+		namespace Utility
+		{
+			void RunCrowdTasks(const int taskCount, dtCrowdTaskFunc* task, void* taskData, void*)
+			{
+				JobSystem::ParallelFor(static_cast<size_t>(taskCount), 1, [&](size_t taskIndex)
+				{
+					task(static_cast<int>(taskIndex), taskData);
+				});
+			}
+		}
+
 		DtCrowd::DtCrowd(Ref<DtNavMesh> navmesh)
 			: myNavMesh(navmesh)
+		{
+			myCrowd = CreateRef<dtCrowd>();
+
+			// The per agent steering phases are split across the workers, and the calling thread.
+			myCrowd->setParallelFor(&Utility::RunCrowdTasks, nullptr, static_cast<int>(JobSystem::GetWorkerCount() + 1));
+
+			InitializeCrowd();
+		}
+
+		void DtCrowd::InitializeCrowd()
 		{
 			dtStatus status;
 
-			myCrowd = CreateRef<dtCrowd>();
+			myAgentEntities.clear();
+			myAgentIndices.clear();
+			myEntityToDenseIndex.clear();
 
 			status = myCrowd->init(myMaxAgents, myMaxAgentRadius, myNavMesh->GetNavMesh().get());
 			if (dtStatusFailed(status))
@@ -68,41 +93,50 @@ namespace Volt
 			myCrowd->setObstacleAvoidanceParams(3, &params);
 		}
 
-		const dtCrowdAgent* DtCrowd::GetAgent(Volt::Entity entity)
+		void DtCrowd::SetMaxAgents(uint32_t count)
 		{
-			if (!myCrowd || !entity.HasComponent<Volt::NavAgentComponent>() || !myEntityToAgentMap.contains(entity.GetID()))
+			if (count == myMaxAgents)
 			{
-				VT_LOG(Warning, "Could not get agent from entity: {0}", entity.GetID());
-				return nullptr;
+				return;
 			}
 
-			return myCrowd->getAgent(myEntityToAgentMap.at(entity.GetID()));
+			myMaxAgents = count;
+			InitializeCrowd();
 		}
 
-		const dtCrowdAgent* DtCrowd::GetAgent(EntityID entityId)
+		void DtCrowd::SetMaxAgentRadius(float radius)
 		{
-			if (!myCrowd || !myEntityToAgentMap.contains(entityId))
+			if (radius == myMaxAgentRadius)
 			{
-				VT_LOG(Warning, "Could not get agent from entity: {0}", entityId);
+				return;
+			}
+
+			myMaxAgentRadius = radius;
+			InitializeCrowd();
+		}
+
+		const dtCrowdAgent* DtCrowd::GetAgent(Volt::Entity entity)
+		{
+			auto it = myEntityToDenseIndex.find(entity.GetHandle());
+			if (!myCrowd || it == myEntityToDenseIndex.end())
+			{
+				VT_LOG(Warning, "Could not get agent from entity: {0}", entity.GetID());
 				return nullptr;
 			}
 
-			return myCrowd->getAgent(myEntityToAgentMap.at(entityId));
+			return myCrowd->getAgent(myAgentIndices[it->second]);
 		}
 
 		void DtCrowd::SetAgentPosition(Volt::Entity entity, glm::vec3 position)
 		{
-			auto entityId = entity.GetID();
-
-			if (!myCrowd || !myEntityToAgentMap.contains(entityId))
+			auto it = myEntityToDenseIndex.find(entity.GetHandle());
+			if (!myCrowd || it == myEntityToDenseIndex.end())
 			{
-				VT_LOG(Warning, "Could not set agent position for entity: {0}", entityId);
+				VT_LOG(Warning, "Could not set agent position for entity: {0}", entity.GetID());
 				return;
 			}
 
-			auto agentIndex = myEntityToAgentMap.at(entityId);
-
-			dtCrowdAgent* ag = myCrowd->getEditableAgent(agentIndex);
+			dtCrowdAgent* ag = myCrowd->getEditableAgent(myAgentIndices[it->second]);
 			if (ag && ag->active)
 			{
 				ag->npos[0] = position.x;
@@ -115,15 +149,14 @@ namespace Volt
 
 		void DtCrowd::SetAgentTarget(Volt::Entity entity, glm::vec3 target)
 		{
-			auto entityId = entity.GetID();
-
-			if (!myCrowd || !myEntityToAgentMap.contains(entity.GetID()))
+			auto it = myEntityToDenseIndex.find(entity.GetHandle());
+			if (!myCrowd || it == myEntityToDenseIndex.end())
 			{
-				VT_LOG(Warning, "Could not set agent target for entity: {0}", entityId);
+				VT_LOG(Warning, "Could not set agent target for entity: {0}", entity.GetID());
 				return;
 			}
 
-			auto agentIndex = myEntityToAgentMap.at(entityId);
+			const int32_t agentIndex = myAgentIndices[it->second];
 
 			const dtCrowdAgent* ag = myCrowd->getAgent(agentIndex);
 			const dtQueryFilter* filter = myCrowd->getFilter(0);
@@ -141,15 +174,14 @@ namespace Volt
 
 		void DtCrowd::ResetAgentTarget(Volt::Entity entity)
 		{
-			auto entityId = entity.GetID();
-
-			if (!myCrowd || !myEntityToAgentMap.contains(entity.GetID()))
+			auto it = myEntityToDenseIndex.find(entity.GetHandle());
+			if (!myCrowd || it == myEntityToDenseIndex.end())
 			{
-				VT_LOG(Warning, "Could not set agent target for entity: {0}", entityId);
+				VT_LOG(Warning, "Could not set agent target for entity: {0}", entity.GetID());
 				return;
 			}
 
-			auto agentIndex = myEntityToAgentMap.at(entityId);
+			const int32_t agentIndex = myAgentIndices[it->second];
 
 			const dtCrowdAgent* ag = myCrowd->getAgent(agentIndex);
 
@@ -196,18 +228,24 @@ namespace Volt
 				return;
 			}
 
-			if (!myEntityToAgentMap.contains(entity.GetID()))
+			if (!HasAgent(entity.GetHandle()))
 			{
 				AddAgent(entity);
 			}
 
+			auto it = myEntityToDenseIndex.find(entity.GetHandle());
+			if (it == myEntityToDenseIndex.end())
+			{
+				return;
+			}
+
 			auto ap = GetAgentParams(entity);
-			myCrowd->updateAgentParameters(myEntityToAgentMap.at(entity.GetID()), &ap);
+			myCrowd->updateAgentParameters(myAgentIndices[it->second], &ap);
 		}
 
 		void DtCrowd::AddAgent(Volt::Entity entity)
 		{
-			if (!myCrowd || !entity.HasComponent<Volt::NavAgentComponent>() || myEntityToAgentMap.contains(entity.GetID()))
+			if (!myCrowd || !entity.HasComponent<Volt::NavAgentComponent>() || HasAgent(entity.GetHandle()))
 			{
 				VT_LOG(Warning, "Could not add agent for entity: {0}", entity.GetID());
 				return;
@@ -217,27 +255,52 @@ namespace Volt
 
 			auto ap = GetAgentParams(entity);
 
-			myEntityToAgentMap[entity.GetID()] = (uint32_t)myCrowd->addAgent((const float*)&position, &ap);
+			const int32_t agentIndex = myCrowd->addAgent((const float*)&position, &ap);
+			if (agentIndex < 0)
+			{
+				VT_LOG(Warning, "Could not add agent for entity: {0}, the crowd is limited to {1} agents", entity.GetID(), myMaxAgents);
+				return;
+			}
+
+			myEntityToDenseIndex[entity.GetHandle()] = static_cast<uint32_t>(myAgentEntities.size());
+			myAgentEntities.emplace_back(entity.GetHandle());
+			myAgentIndices.emplace_back(agentIndex);
 		}
 
-		void DtCrowd::RemoveAgent(Volt::Entity entity)
+		void DtCrowd::RemoveAgent(entt::entity entityHandle)
 		{
-			if (!myCrowd && !myEntityToAgentMap.contains(entity.GetID())) return;
+			auto it = myEntityToDenseIndex.find(entityHandle);
+			if (!myCrowd || it == myEntityToDenseIndex.end()) return;
+
+			const uint32_t denseIndex = it->second;
+			myEntityToDenseIndex.erase(it);
+
+			myCrowd->removeAgent(myAgentIndices[denseIndex]);
+
+			const uint32_t lastIndex = static_cast<uint32_t>(myAgentEntities.size() - 1);
+			if (denseIndex != lastIndex)
+			{
+				myAgentEntities[denseIndex] = myAgentEntities[lastIndex];
+				myAgentIndices[denseIndex] = myAgentIndices[lastIndex];
+				myEntityToDenseIndex[myAgentEntities[denseIndex]] = denseIndex;
+			}
 
-			myCrowd->removeAgent((int)myEntityToAgentMap.at(entity.GetID()));
-			myEntityToAgentMap.erase(entity.GetID());
+			myAgentEntities.pop_back();
+			myAgentIndices.pop_back();
 		}
 
 		void DtCrowd::ClearAgents()
 		{
 			if (!myCrowd) return;
 
-			for (int i = 0; i < myCrowd->getAgentCount(); ++i)
+			for (const int32_t agentIndex : myAgentIndices)
 			{
-				myCrowd->removeAgent(i);
+				myCrowd->removeAgent(agentIndex);
 			}
 
-			myEntityToAgentMap.clear();
+			myAgentEntities.clear();
+			myAgentIndices.clear();
+			myEntityToDenseIndex.clear();
 		}
 	}
 }
@@ -19,6 +19,30 @@ namespace Volt
 			{
 				VT_LOG(Error, "Could not init Detour NavMesh Query");
 			}
+
+			myPathfindingService = CreateRef<PathfindingService>(myNavMesh);
+		}
+
+		const dtQueryFilter& DtNavMesh::GetDefaultQueryFilter()
+		{
+			static const dtQueryFilter s_filter = []()
+			{
+				dtQueryFilter dtFilter;
+				dtFilter.setIncludeFlags(POLYFLAGS_ALL ^ POLYFLAGS_DISABLED);
+				dtFilter.setExcludeFlags(0);
+
+				// Change costs.
+				dtFilter.setAreaCost(POLYAREA_GROUND, 1.0f);
+				//dtFilter.setAreaCost(POLYAREA_WATER, 10.0f);
+				//dtFilter.setAreaCost(POLYAREA_ROAD, 1.0f);
+				//dtFilter.setAreaCost(POLYAREA_DOOR, 1.0f);
+				//dtFilter.setAreaCost(POLYAREA_GRASS, 2.0f);
+				//dtFilter.setAreaCost(POLYAREA_JUMP, 1.5f);
+
+				return dtFilter;
+			}();
+
+			return s_filter;
 		}
 
 		Vector<glm::vec3> DtNavMesh::FindPath(glm::vec3 start, glm::vec3 end, glm::vec3 polySearchDistance)
@@ -29,17 +53,7 @@ namespace Volt
 
 			dtStatus status = 0;
 
-			dtQueryFilter dtFilter;
-			dtFilter.setIncludeFlags(POLYFLAGS_ALL ^ POLYFLAGS_DISABLED);
-			dtFilter.setExcludeFlags(0);
-
-			// Change costs.
-			dtFilter.setAreaCost(POLYAREA_GROUND, 1.0f);
-			//dtFilter.setAreaCost(POLYAREA_WATER, 10.0f);
-			//dtFilter.setAreaCost(POLYAREA_ROAD, 1.0f);
-			//dtFilter.setAreaCost(POLYAREA_DOOR, 1.0f);
-			//dtFilter.setAreaCost(POLYAREA_GRASS, 2.0f);
-			//dtFilter.setAreaCost(POLYAREA_JUMP, 1.5f);
+			const dtQueryFilter& dtFilter = GetDefaultQueryFilter();
 
 			glm::vec3 halfExtents = polySearchDistance;
 
@@ -0,0 +1,192 @@
+#include "nvpch.h"
+#include "Navigation/NavMesh/PathfindingService.h"
+
+#include "Navigation/NavMesh/DtNavMesh.h"
+
+#include <JobSystem/JobSystem.h>
+
+namespace Volt
+{
+	namespace AI
+	{
+		PathfindingService::PathfindingService(Ref<dtNavMesh> navmesh, const PathfindingSettings& settings)
+			: myNavMesh(navmesh), mySettings(settings)
+		{
+			VT_ENSURE(mySettings.maxIterationsPerQuery > 0 && mySettings.maxPathPolys > 0);
+
+			// One query per worker, and one for the thread calling Update, which takes part in the batch
+			const uint32_t queryCount = JobSystem::GetWorkerCount() + 1;
+			myQueryContexts.resize(queryCount);
+
+			for (auto& context : myQueryContexts)
+			{
+				context.query = CreateScope<dtNavMeshQuery>();
+
+				const dtStatus status = context.query->init(myNavMesh.get(), static_cast<int32_t>(mySettings.maxSearchNodes));
+				if (dtStatusFailed(status))
+				{
+					VT_LOG(Error, "Could not init Detour NavMesh Query for the pathfinding service");
+				}
+
+				context.polyBuffer.resize(mySettings.maxPathPolys);
+				context.straightPathBuffer.resize(mySettings.maxPathPolys);
+			}
+		}
+
+		PathRequestHandle PathfindingService::RequestPath(const glm::vec3& start, const glm::vec3& end, const glm::vec3& polySearchDistance)
+		{
+			PathRequestHandle request = CreateRef<PathRequest>(start, end, polySearchDistance);
+			myPendingRequestCount.fetch_add(1, std::memory_order_relaxed);
+
+			std::scoped_lock lock{ myIncomingMutex };
+			myIncomingRequests.emplace_back(request);
+
+			return request;
+		}
+
+		void PathfindingService::Update()
+		{
+			VT_PROFILE_FUNCTION();
+
+			DistributeIncomingRequests();
+
+			if (GetPendingRequestCount() == 0)
+			{
+				return;
+			}
+
+			JobSystem::ParallelFor(myQueryContexts.size(), 1, [&](size_t contextIndex)
+			{
+				ProcessRequests(myQueryContexts[contextIndex]);
+			});
+		}
+
+		void PathfindingService::DistributeIncomingRequests()
+		{
+			Vector<PathRequestHandle> incomingRequests;
+			{
+				std::scoped_lock lock{ myIncomingMutex };
+				incomingRequests.swap(myIncomingRequests);
+			}
+
+			for (auto& request : incomingRequests)
+			{
+				auto it = std::min_element(myQueryContexts.begin(), myQueryContexts.end(), [](const QueryContext& lhs, const QueryContext& rhs)
+				{
+					return lhs.requests.size() < rhs.requests.size();
+				});
+
+				it->requests.emplace_back(std::move(request));
+			}
+		}
+
+		void PathfindingService::ProcessRequests(QueryContext& context)
+		{
+			int32_t iterationsLeft = static_cast<int32_t>(mySettings.maxIterationsPerQuery);
+
+			// The query holds a single sliced search, so requests are searched one at a time, in order
+			while (!context.requests.empty() && iterationsLeft > 0)
+			{
+				PathRequest& request = *context.requests.front();
+
+				if (request.myIsCancelled.load(std::memory_order_relaxed))
+				{
+					CompleteRequest(request, PathRequestStatus::Cancelled);
+					context.requests.pop_front();
+					continue;
+				}
+
+				if (request.myStatus.load(std::memory_order_relaxed) == PathRequestStatus::Queued)
+				{
+					if (!BeginSearch(context, request))
+					{
+						CompleteRequest(request, PathRequestStatus::Failed);
+						context.requests.pop_front();
+						continue;
+					}
+
+					request.myStatus.store(PathRequestStatus::InProgress, std::memory_order_relaxed);
+				}
+
+				int32_t doneIterations = 0;
+				const dtStatus status = context.query->updateSlicedFindPath(iterationsLeft, &doneIterations);
+				iterationsLeft -= std::max(doneIterations, 1);
+
+				if (dtStatusInProgress(status))
+				{
+					// Out of budget, the search continues from here in the next update
+					break;
+				}
+
+				FinishSearch(context, request, status);
+				context.requests.pop_front();
+			}
+		}
+
+		bool PathfindingService::BeginSearch(QueryContext& context, PathRequest& request)
+		{
+			const dtQueryFilter& filter = DtNavMesh::GetDefaultQueryFilter();
+			dtNavMeshQuery& query = *context.query;
+
+			dtStatus status = query.findNearestPoly((const float*)&request.myStart, (const float*)&request.myPolySearchDistance, &filter, &request.myStartPoly, (float*)&request.myStartPoint);
+			if (dtStatusFailed(status) || request.myStartPoly == 0)
+			{
+				return false;
+			}
+
+			status = query.findNearestPoly((const float*)&request.myEnd, (const float*)&request.myPolySearchDistance, &filter, &request.myEndPoly, (float*)&request.myEndPoint);
+			if (dtStatusFailed(status) || request.myEndPoly == 0)
+			{
+				return false;
+			}
+
+			status = query.initSlicedFindPath(request.myStartPoly, request.myEndPoly, (const float*)&request.myStartPoint, (const float*)&request.myEndPoint, &filter);
+			return !dtStatusFailed(status);
+		}
+
+		void PathfindingService::FinishSearch(QueryContext& context, PathRequest& request, dtStatus searchStatus)
+		{
+			dtNavMeshQuery& query = *context.query;
+
+			int32_t polyCount = 0;
+			dtStatus status = searchStatus;
+
+			if (!dtStatusFailed(status))
+			{
+				status = query.finalizeSlicedFindPath(context.polyBuffer.data(), &polyCount, static_cast<int32_t>(context.polyBuffer.size()));
+			}
+
+			if (dtStatusFailed(status) || polyCount == 0)
+			{
+				CompleteRequest(request, PathRequestStatus::Failed);
+				return;
+			}
+
+			// A partial path ends on the poly closest to the target, so the end point is moved onto it
+			glm::vec3 endPoint = request.myEndPoint;
+			if (context.polyBuffer[polyCount - 1] != request.myEndPoly)
+			{
+				query.closestPointOnPoly(context.polyBuffer[polyCount - 1], (const float*)&request.myEndPoint, (float*)&endPoint, nullptr);
+			}
+
+			int32_t straightPathSize = 0;
+			status = query.findStraightPath((const float*)&request.myStartPoint, (const float*)&endPoint, context.polyBuffer.data(), polyCount,
+				(float*)context.straightPathBuffer.data(), nullptr, nullptr, &straightPathSize, static_cast<int32_t>(context.straightPathBuffer.size()));
+
+			if (dtStatusFailed(status) || straightPathSize == 0)
+			{
+				CompleteRequest(request, PathRequestStatus::Failed);
+				return;
+			}
+
+			request.myPath.assign(context.straightPathBuffer.begin(), context.straightPathBuffer.begin() + straightPathSize);
+			CompleteRequest(request, PathRequestStatus::Succeeded);
+		}
+
+		void PathfindingService::CompleteRequest(PathRequest& request, PathRequestStatus status)
+		{
+			request.Complete(status);
+			myPendingRequestCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+}
@@ -15,6 +15,11 @@ namespace Volt
 		{
 			if (myNavMesh)
 			{
+				if (auto& pathfindingService = myNavMesh->GetPathfindingService())
+				{
+					pathfindingService->Update();
+				}
+
 				if (!myCrowd) return;
 
 				myCrowd->GetDTCrowd()->update(deltaTime, nullptr);
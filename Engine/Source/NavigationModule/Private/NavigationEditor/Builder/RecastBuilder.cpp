@@ -12,6 +12,8 @@
 #include <DetourTileCache.h>
 #include <fastlz.h>
 
+#include <JobSystem/JobSystem.h>
+
 #include <array>
 #include <unordered_set>
 
@@ -24,6 +26,12 @@ struct TileCacheData
 	int dataSize;
 };
 
+struct TileLayerSet
+{
+	TileCacheData layers[MAX_LAYERS]{};
+	int layerCount = 0;
+};
+
 struct RasterizationContext
 {
 	RasterizationContext() :
@@ -186,6 +194,7 @@ struct MeshProcess : public dtTileCacheMeshProcess
 };
 
 int RecastBuilder::rasterizeTileLayers(
+							   rcContext* ctx,
 							   const int tx, const int ty,
 							   const rcConfig& cfg,
 							   TileCacheData* tiles,
@@ -228,7 +237,7 @@ int RecastBuilder::rasterizeTileLayers(
 		VT_LOG(Error, "buildNavigation: Out of memory 'solid'.");
 		return 0;
 	}
-	if (!rcCreateHeightfield(m_ctx.get(), *rc.solid, tcfg.width, tcfg.height, tcfg.bmin, tcfg.bmax, tcfg.cs, tcfg.ch))
+	if (!rcCreateHeightfield(ctx, *rc.solid, tcfg.width, tcfg.height, tcfg.bmin, tcfg.bmax, tcfg.cs, tcfg.ch))
 	{
 		VT_LOG(Error, "buildNavigation: Could not create solid heightfield.");
 		return 0;
@@ -263,10 +272,10 @@ int RecastBuilder::rasterizeTileLayers(
 		const int ntris = node.n;
 
 		memset(rc.triareas, 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(m_ctx.get(), tcfg.walkableSlopeAngle,
+		rcMarkWalkableTriangles(ctx, tcfg.walkableSlopeAngle,
 								verts, nverts, tris, ntris, rc.triareas);
 
-		if (!rcRasterizeTriangles(m_ctx.get(), verts, nverts, tris, rc.triareas, ntris, *rc.solid, tcfg.walkableClimb))
+		if (!rcRasterizeTriangles(ctx, verts, nverts, tris, rc.triareas, ntris, *rc.solid, tcfg.walkableClimb))
 			return 0;
 	}
 
@@ -274,11 +283,11 @@ int RecastBuilder::rasterizeTileLayers(
 	// remove unwanted overhangs caused by the conservative rasterization
 	// as well as filter spans where the character cannot possibly stand.
 	if (m_filterLowHangingObstacles)
-		rcFilterLowHangingWalkableObstacles(m_ctx.get(), tcfg.walkableClimb, *rc.solid);
+		rcFilterLowHangingWalkableObstacles(ctx, tcfg.walkableClimb, *rc.solid);
 	if (m_filterLedgeSpans)
-		rcFilterLedgeSpans(m_ctx.get(), tcfg.walkableHeight, tcfg.walkableClimb, *rc.solid);
+		rcFilterLedgeSpans(ctx, tcfg.walkableHeight, tcfg.walkableClimb, *rc.solid);
 	if (m_filterWalkableLowHeightSpans)
-		rcFilterWalkableLowHeightSpans(m_ctx.get(), tcfg.walkableHeight, *rc.solid);
+		rcFilterWalkableLowHeightSpans(ctx, tcfg.walkableHeight, *rc.solid);
 
 
 	rc.chf = rcAllocCompactHeightfield();
@@ -287,14 +296,14 @@ int RecastBuilder::rasterizeTileLayers(
 		VT_LOG(Error, "buildNavigation: Out of memory 'chf'.");
 		return 0;
 	}
-	if (!rcBuildCompactHeightfield(m_ctx.get(), tcfg.walkableHeight, tcfg.walkableClimb, *rc.solid, *rc.chf))
+	if (!rcBuildCompactHeightfield(ctx, tcfg.walkableHeight, tcfg.walkableClimb, *rc.solid, *rc.chf))
 	{
 		VT_LOG(Error, "buildNavigation: Could not build compact data.");
 		return 0;
 	}
 
 	// Erode the walkable area by agent radius.
-	if (!rcErodeWalkableArea(m_ctx.get(), tcfg.walkableRadius, *rc.chf))
+	if (!rcErodeWalkableArea(ctx, tcfg.walkableRadius, *rc.chf))
 	{
 		VT_LOG(Error, "buildNavigation: Could not erode.");
 		return 0;
@@ -304,7 +313,7 @@ int RecastBuilder::rasterizeTileLayers(
 	const ConvexVolume* vols = m_geom->getConvexVolumes();
 	for (int i = 0; i < m_geom->getConvexVolumeCount(); ++i)
 	{
-		rcMarkConvexPolyArea(m_ctx.get(), vols[i].verts, vols[i].nverts,
+		rcMarkConvexPolyArea(ctx, vols[i].verts, vols[i].nverts,
 							 vols[i].hmin, vols[i].hmax,
 							 (unsigned char)vols[i].area, *rc.chf);
 	}
@@ -315,7 +324,7 @@ int RecastBuilder::rasterizeTileLayers(
 		VT_LOG(Error, "buildNavigation: Out of memory 'lset'.");
 		return 0;
 	}
-	if (!rcBuildHeightfieldLayers(m_ctx.get(), *rc.chf, tcfg.borderSize, tcfg.walkableHeight, *rc.lset))
+	if (!rcBuildHeightfieldLayers(ctx, *rc.chf, tcfg.borderSize, tcfg.walkableHeight, *rc.lset))
 	{
 		VT_LOG(Error, "buildNavigation: Could not build heighfield layers.");
 		return 0;
@@ -397,6 +406,7 @@ Ref<Volt::AI::NavMesh> RecastBuilder::BuildSingleNavMesh()
 	}
 
 	CleanUp();
+	ClearTiledNavMesh();
 
 	dtStatus status;
 	Ref<Volt::AI::NavMesh> result;
@@ -789,6 +799,7 @@ Ref<Volt::AI::NavMesh> RecastBuilder::BuildTiledNavMesh()
 	}
 
 	CleanUp();
+	ClearTiledNavMesh();
 
 	m_tmproc->init(m_geom.get());
 
@@ -805,7 +816,7 @@ Ref<Volt::AI::NavMesh> RecastBuilder::BuildTiledNavMesh()
 
 	// Init cache
 	int gw = 0, gh = 0;
-	rcCalcGridSize(m_cfg.bmin, m_cfg.bmax, m_cfg.cs, &gw, &gh);
+	rcCalcGridSize((const float*)&bmin, (const float*)&bmax, m_buildSettings->cellSize, &gw, &gh);
 	const int ts = (int)m_buildSettings->tileSize;
 	const int tw = (gw + ts - 1) / ts;
 	const int th = (gh + ts - 1) / ts;
@@ -830,6 +841,8 @@ Ref<Volt::AI::NavMesh> RecastBuilder::BuildTiledNavMesh()
 	cfg.height = cfg.tileSize + cfg.borderSize * 2;
 	cfg.detailSampleDist = m_buildSettings->detailSampleDist < 0.9f ? 0 : m_buildSettings->cellSize * m_buildSettings->detailSampleDist;
 	cfg.detailSampleMaxError = m_buildSettings->cellHeight * m_buildSettings->detailSampleMaxError;
+	rcVcopy(cfg.bmin, (const float*)&bmin);
+	rcVcopy(cfg.bmax, (const float*)&bmax);
 	rcVcopy(m_cfg.bmin, (const float*)&bmin);
 	rcVcopy(m_cfg.bmax, (const float*)&bmax);
 
@@ -898,32 +911,23 @@ Ref<Volt::AI::NavMesh> RecastBuilder::BuildTiledNavMesh()
 	m_cacheCompressedSize = 0;
 	m_cacheRawSize = 0;
 
+	m_tileConfig = cfg;
+	m_tileGridWidth = tw;
+	m_tileGridHeight = th;
+
+	Vector<glm::ivec2> tileCoordinates;
+	tileCoordinates.reserve(tw * th);
+
 	for (int y = 0; y < th; ++y)
 	{
 		for (int x = 0; x < tw; ++x)
 		{
-			TileCacheData tiles[MAX_LAYERS];
-			memset(tiles, 0, sizeof(tiles));
-			int ntiles = rasterizeTileLayers(x, y, cfg, tiles, MAX_LAYERS);
-
-			for (int i = 0; i < ntiles; ++i)
-			{
-				TileCacheData* tile = &tiles[i];
-				status = tileCache->addTile(tile->data, tile->dataSize, DT_COMPRESSEDTILE_FREE_DATA, 0);
-				if (dtStatusFailed(status))
-				{
-					dtFree(tile->data);
-					tile->data = 0;
-					continue;
-				}
-
-				m_cacheLayerCount++;
-				m_cacheCompressedSize += tile->dataSize;
-				m_cacheRawSize += calcLayerBufferSize(tcparams.width, tcparams.height);
-			}
+			tileCoordinates.emplace_back(x, y);
 		}
 	}
 
+	BuildTileCacheLayers(tileCoordinates, *tileCache);
+
 	// Build initial meshes
 	m_ctx->startTimer(RC_TIMER_TOTAL);
 	for (int y = 0; y < th; ++y)
@@ -934,6 +938,9 @@ Ref<Volt::AI::NavMesh> RecastBuilder::BuildTiledNavMesh()
 	m_cacheBuildTimeMs = m_ctx->getAccumulatedTime(RC_TIMER_TOTAL) / 1000.0f;
 	m_cacheBuildMemUsage = static_cast<unsigned int>(m_talloc->high);
 
+	m_tileCache = tileCache;
+	m_tiledNavMesh = navMesh;
+
 	result = CreateRef<Volt::AI::NavMesh>();
 	result->Initialize(navMesh, tileCache);
 
@@ -950,6 +957,183 @@ Ref<Volt::AI::NavMesh> RecastBuilder::BuildTiledNavMesh()
 	return result;
 }
 
+bool RecastBuilder::RebuildTiledNavMeshTiles(const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+	VT_PROFILE_FUNCTION();
+
+	if (!m_tileCache || !m_tiledNavMesh)
+	{
+		VT_LOG(Error, "rebuildTiles: No tiled nav mesh has been built.");
+		return false;
+	}
+
+	if (!m_geom || !m_geom->getChunkyMesh())
+	{
+		VT_LOG(Error, "rebuildTiles: Input mesh is not specified.");
+		return false;
+	}
+
+	glm::ivec2 minTile;
+	glm::ivec2 maxTile;
+	if (!GetTileRange(boundsMin, boundsMax, minTile, maxTile))
+	{
+		return true;
+	}
+
+	m_tmproc->init(m_geom.get());
+
+	Vector<glm::ivec2> tileCoordinates;
+
+	for (int y = minTile.y; y <= maxTile.y; ++y)
+	{
+		for (int x = minTile.x; x <= maxTile.x; ++x)
+		{
+			tileCoordinates.emplace_back(x, y);
+
+			// The layer count of a tile can change, so every old layer is removed before the tile is rebuilt
+			dtCompressedTileRef compressedTiles[MAX_LAYERS];
+			const int compressedTileCount = m_tileCache->getTilesAt(x, y, compressedTiles, MAX_LAYERS);
+			for (int i = 0; i < compressedTileCount; ++i)
+			{
+				// The new layers are added to the stats when they are built
+				if (const dtCompressedTile* compressedTile = m_tileCache->getTileByRef(compressedTiles[i]))
+				{
+					m_cacheLayerCount--;
+					m_cacheCompressedSize -= compressedTile->dataSize;
+					m_cacheRawSize -= calcLayerBufferSize(m_tileConfig.tileSize, m_tileConfig.tileSize);
+				}
+
+				m_tileCache->removeTile(compressedTiles[i], 0, 0);
+			}
+
+			const dtMeshTile* meshTiles[MAX_LAYERS];
+			const int meshTileCount = m_tiledNavMesh->getTilesAt(x, y, meshTiles, MAX_LAYERS);
+
+			dtTileRef meshTileRefs[MAX_LAYERS];
+			for (int i = 0; i < meshTileCount; ++i)
+			{
+				meshTileRefs[i] = m_tiledNavMesh->getTileRef(meshTiles[i]);
+			}
+
+			for (int i = 0; i < meshTileCount; ++i)
+			{
+				m_tiledNavMesh->removeTile(meshTileRefs[i], 0, 0);
+			}
+		}
+	}
+
+	BuildTileCacheLayers(tileCoordinates, *m_tileCache);
+
+	for (const auto& tile : tileCoordinates)
+	{
+		m_tileCache->buildNavMeshTilesAt(tile.x, tile.y, m_tiledNavMesh.get());
+	}
+
+	VT_LOG(Info, ">> Rebuilt {0} nav mesh tiles", tileCoordinates.size());
+	return true;
+}
+
+bool RecastBuilder::GetRebuiltTileBounds(const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::vec3& outBoundsMin, glm::vec3& outBoundsMax) const
+{
+	glm::ivec2 minTile;
+	glm::ivec2 maxTile;
+	if (!m_tileCache || !GetTileRange(boundsMin, boundsMax, minTile, maxTile))
+	{
+		return false;
+	}
+
+	// Tiles rasterize everything within their border as well
+	const float tileWorldSize = m_tileConfig.tileSize * m_tileConfig.cs;
+	const float borderWorldSize = m_tileConfig.borderSize * m_tileConfig.cs;
+
+	outBoundsMin = { m_tileConfig.bmin[0] + minTile.x * tileWorldSize - borderWorldSize, m_tileConfig.bmin[1], m_tileConfig.bmin[2] + minTile.y * tileWorldSize - borderWorldSize };
+	outBoundsMax = { m_tileConfig.bmin[0] + (maxTile.x + 1) * tileWorldSize + borderWorldSize, m_tileConfig.bmax[1], m_tileConfig.bmin[2] + (maxTile.y + 1) * tileWorldSize + borderWorldSize };
+	return true;
+}
+
+bool RecastBuilder::GetTileRange(const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::ivec2& outMinTile, glm::ivec2& outMaxTile) const
+{
+	// Tiles are rasterized with a border reaching into their neighbours, so tiles next to the bounds are affected as well
+	const float tileWorldSize = m_tileConfig.tileSize * m_tileConfig.cs;
+	const float borderWorldSize = m_tileConfig.borderSize * m_tileConfig.cs;
+
+	const int minTileX = (int)floorf((boundsMin.x - borderWorldSize - m_tileConfig.bmin[0]) / tileWorldSize);
+	const int minTileY = (int)floorf((boundsMin.z - borderWorldSize - m_tileConfig.bmin[2]) / tileWorldSize);
+	const int maxTileX = (int)floorf((boundsMax.x + borderWorldSize - m_tileConfig.bmin[0]) / tileWorldSize);
+	const int maxTileY = (int)floorf((boundsMax.z + borderWorldSize - m_tileConfig.bmin[2]) / tileWorldSize);
+
+	if (maxTileX < 0 || maxTileY < 0 || minTileX >= m_tileGridWidth || minTileY >= m_tileGridHeight)
+	{
+		return false;
+	}
+
+	outMinTile = { rcMax(minTileX, 0), rcMax(minTileY, 0) };
+	outMaxTile = { rcMin(maxTileX, m_tileGridWidth - 1), rcMin(maxTileY, m_tileGridHeight - 1) };
+	return true;
+}
+
+void RecastBuilder::ClearTiledNavMesh()
+{
+	m_tileCache = nullptr;
+	m_tiledNavMesh = nullptr;
+
+	memset(&m_tileConfig, 0, sizeof(m_tileConfig));
+	m_tileGridWidth = 0;
+	m_tileGridHeight = 0;
+
+	m_cacheLayerCount = 0;
+	m_cacheCompressedSize = 0;
+	m_cacheRawSize = 0;
+}
+
+void RecastBuilder::BuildTileCacheLayers(const Vector<glm::ivec2>& tileCoordinates, dtTileCache& tileCache)
+{
+	VT_PROFILE_FUNCTION();
+
+	Vector<TileLayerSet> tileLayers(tileCoordinates.size());
+
+	if (m_buildSettings->buildTilesInParallel)
+	{
+		// Tiles don't share any build state, only the input geometry which is read only.
+		// Recast contexts aren't thread safe, so every tile gets its own, without logging and timers.
+		Volt::JobSystem::ParallelFor(tileCoordinates.size(), 1, [&](size_t tileIndex)
+		{
+			rcContext tileContext{ false };
+
+			TileLayerSet& layerSet = tileLayers[tileIndex];
+			layerSet.layerCount = rasterizeTileLayers(&tileContext, tileCoordinates[tileIndex].x, tileCoordinates[tileIndex].y, m_tileConfig, layerSet.layers, MAX_LAYERS);
+		});
+	}
+	else
+	{
+		for (size_t tileIndex = 0; tileIndex < tileCoordinates.size(); ++tileIndex)
+		{
+			TileLayerSet& layerSet = tileLayers[tileIndex];
+			layerSet.layerCount = rasterizeTileLayers(m_ctx.get(), tileCoordinates[tileIndex].x, tileCoordinates[tileIndex].y, m_tileConfig, layerSet.layers, MAX_LAYERS);
+		}
+	}
+
+	// Added in tile order, so the tile cache comes out the same however the tiles were scheduled
+	for (auto& layerSet : tileLayers)
+	{
+		for (int i = 0; i < layerSet.layerCount; ++i)
+		{
+			TileCacheData* tile = &layerSet.layers[i];
+			dtStatus status = tileCache.addTile(tile->data, tile->dataSize, DT_COMPRESSEDTILE_FREE_DATA, 0);
+			if (dtStatusFailed(status))
+			{
+				dtFree(tile->data);
+				tile->data = 0;
+				continue;
+			}
+
+			m_cacheLayerCount++;
+			m_cacheCompressedSize += tile->dataSize;
+			m_cacheRawSize += calcLayerBufferSize(m_tileConfig.tileSize, m_tileConfig.tileSize);
+		}
+	}
+}
+
 void RecastBuilder::AddNavLinkConnection(Volt::AI::NavLinkConnection link)
 {
 	if (m_geom)
@@ -7,6 +7,8 @@
 #include <EventSystem/ApplicationEvents.h>
 #include <EventSystem/EventListener.h>
 
+#include <CoreUtilities/Containers/Map.h>
+
 static const int MAX_POLYS = 256;
 
 namespace Volt
@@ -17,7 +19,7 @@ namespace Volt
 		{
 		public:
 			NavigationSystem();
-			~NavigationSystem() = default;
+			~NavigationSystem();
 
 			void SetVTNavMesh(Ref<NavMesh> navmesh);
 			const Ref<NavMesh>& GetVTNavMesh() { return myNavMesh; };
@@ -29,6 +31,14 @@ namespace Volt
 			bool OnAppUpdateEvent(Volt::AppUpdateEvent& e);
 			bool OnRuntimeStart();
 
+			void SetActiveScene(Ref<Scene> scene);
+			void OnNavAgentConstructed(entt::registry& registry, entt::entity entityHandle);
+			void OnNavAgentDestroyed(entt::registry& registry, entt::entity entityHandle);
+
+			void ApplyAgentChanges();
+			void SyncAgentsFromEntities(float deltaTime);
+			void WriteBackAgentPositions(float deltaTime);
+
 			void PauseAgent(Volt::Entity entity, float deltaTime);
 			void UnpauseAgent(Volt::Entity entity);
 			void SyncDetourPosition(Volt::Entity entity, float deltaTime);
@@ -36,7 +46,31 @@ namespace Volt
 			void InitAgents();
 			void ClearAgents();
 
-			std::unordered_map<EntityID, glm::vec3> myEntityIdToTargetPosMap;
+			enum class AgentState : uint8_t
+			{
+				Active,
+				Inactive,
+				Pausing,
+				Unpausing
+			};
+
+			// Filled by the component events, and applied at the start of the next update.
+			Vector<entt::entity> myAddedAgents;
+			Vector<entt::entity> myRemovedAgents;
+
+			enum class AgentWriteBack : uint8_t
+			{
+				None,
+				Transform,
+				CharacterController
+			};
+
+			// Per frame scratch, at the same positions as the dense agent arrays of the crowd.
+			Vector<AgentState> myAgentStates;
+			Vector<AgentWriteBack> myAgentWriteBacks;
+			Vector<glm::vec3> myAgentLocalPositions;
+
+			vt::map<entt::entity, glm::vec3> myPausedAgentTargets;
 
 			Ref<NavMesh> myNavMesh = nullptr;
 			Ref<Scene> myActiveScene = nullptr;
@@ -5,6 +5,8 @@
 #include <Volt/Scene/Entity.h>
 #include <Volt/Components/NavigationComponents.h>
 
+#include <CoreUtilities/Containers/Map.h>
+
 #include <DetourCrowd.h>
 
 namespace Volt
@@ -17,8 +19,13 @@ namespace Volt
 			DtCrowd(Ref<DtNavMesh> navmesh);
 
 			const dtCrowdAgent* GetAgent(Volt::Entity entity);
-			const dtCrowdAgent* GetAgent(EntityID entityId);
-			const std::unordered_map<EntityID, uint32_t>& GetAgentMap() const { return myEntityToAgentMap; };
+
+			// The agents are kept densely, with the entity and the Detour agent index of each agent at the same position.
+			// Removing an agent moves the last agent into its place.
+			const Vector<entt::entity>& GetAgentEntities() const { return myAgentEntities; };
+			const Vector<int32_t>& GetAgentIndices() const { return myAgentIndices; };
+			uint32_t GetAgentCount() const { return static_cast<uint32_t>(myAgentEntities.size()); };
+			bool HasAgent(entt::entity entityHandle) const { return myEntityToDenseIndex.contains(entityHandle); };
 
 			void SetAgentPosition(Volt::Entity entity, glm::vec3 position);
 			void SetAgentTarget(Volt::Entity entity, glm::vec3 target);
@@ -27,18 +34,23 @@ namespace Volt
 			void UpdateAgentParams(Volt::Entity entity);
 
 			void AddAgent(Volt::Entity entity);
-			void RemoveAgent(Volt::Entity entity);
+			void RemoveAgent(entt::entity entityHandle);
 			void ClearAgents();
 
-			void SetMaxAgents(uint32_t count) { myMaxAgents = count; };
-			void SetMaxAgentRadius(float radius) { myMaxAgentRadius = radius; };
+			// Changing the limits recreates the crowd, which removes all agents.
+			void SetMaxAgents(uint32_t count);
+			void SetMaxAgentRadius(float radius);
 
 			Ref<dtCrowd>& GetDTCrowd() { return myCrowd; };
 
 		private:
-			std::unordered_map<EntityID, uint32_t> myEntityToAgentMap;
+			void InitializeCrowd();
+
+			Vector<entt::entity> myAgentEntities;
+			Vector<int32_t> myAgentIndices;
+			vt::map<entt::entity, uint32_t> myEntityToDenseIndex;
 
-			uint32_t myMaxAgents = 100;
+			uint32_t myMaxAgents = 1024;
 			float myMaxAgentRadius = 60.f;
 
 			Ref<DtNavMesh> myNavMesh = nullptr;
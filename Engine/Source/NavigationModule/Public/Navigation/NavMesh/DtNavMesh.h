@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Navigation/NavMesh/PathfindingService.h"
+
 #include <Volt/Core/Base.h>
 
 #include <CoreUtilities/Containers/Vector.h>
@@ -19,16 +21,21 @@ namespace Volt
 		public:
 			DtNavMesh(Ref<dtNavMesh> navmesh, Ref<dtTileCache> tilecache = nullptr);
 
+			// Searches on the calling thread. Use the pathfinding service when many paths are needed.
 			Vector<glm::vec3> FindPath(glm::vec3 start, glm::vec3 end, glm::vec3 polySearchDistance);
 
+			static const dtQueryFilter& GetDefaultQueryFilter();
+
 			Ref<dtNavMesh>& GetNavMesh() { return myNavMesh; };
 			Ref<dtNavMeshQuery>& GetNavMeshQuery() { return myNavMeshQuery; };
 			Ref<dtTileCache>& GetTileCache() { return myTileCache; };
+			Ref<PathfindingService>& GetPathfindingService() { return myPathfindingService; };
 
 		private:
 			Ref<dtNavMesh> myNavMesh = nullptr;
 			Ref<dtNavMeshQuery> myNavMeshQuery = nullptr;
 			Ref<dtTileCache> myTileCache = nullptr;
+			Ref<PathfindingService> myPathfindingService = nullptr;
 		};
 	}
 }
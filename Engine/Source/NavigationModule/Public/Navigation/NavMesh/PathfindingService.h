@@ -0,0 +1,127 @@
+#pragma once
+
+#include <Volt/Core/Base.h>
+
+#include <CoreUtilities/Containers/Vector.h>
+
+#include <glm/glm.hpp>
+
+#include <DetourNavMesh.h>
+#include <DetourNavMeshQuery.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace Volt
+{
+	namespace AI
+	{
+		enum class PathRequestStatus : uint32_t
+		{
+			Queued,
+			InProgress,
+			Succeeded,
+			Failed,
+			Cancelled
+		};
+
+		// Shared between the requester and the service. The path may only be read once the request is done.
+		class PathRequest
+		{
+		public:
+			PathRequest(const glm::vec3& start, const glm::vec3& end, const glm::vec3& polySearchDistance)
+				: myStart(start), myEnd(end), myPolySearchDistance(polySearchDistance)
+			{
+			}
+
+			VT_NODISCARD VT_INLINE PathRequestStatus GetStatus() const { return myStatus.load(std::memory_order_acquire); }
+			VT_NODISCARD VT_INLINE bool IsDone() const { return GetStatus() >= PathRequestStatus::Succeeded; }
+			VT_NODISCARD VT_INLINE bool HasSucceeded() const { return GetStatus() == PathRequestStatus::Succeeded; }
+
+			// Empty unless the request has succeeded.
+			VT_NODISCARD VT_INLINE const Vector<glm::vec3>& GetPath() const { VT_ENSURE(IsDone()); return myPath; }
+
+			// The request is dropped the next time the service reaches it, unless it is already done.
+			VT_INLINE void Cancel() { myIsCancelled.store(true, std::memory_order_relaxed); }
+
+		private:
+			friend class PathfindingService;
+
+			void Complete(PathRequestStatus status) { myStatus.store(status, std::memory_order_release); }
+
+			glm::vec3 myStart;
+			glm::vec3 myEnd;
+			glm::vec3 myPolySearchDistance;
+
+			// Search state, only touched by the worker that owns the request.
+			dtPolyRef myStartPoly = 0;
+			dtPolyRef myEndPoly = 0;
+			glm::vec3 myStartPoint = { 0.f };
+			glm::vec3 myEndPoint = { 0.f };
+
+			Vector<glm::vec3> myPath;
+
+			std::atomic<PathRequestStatus> myStatus = PathRequestStatus::Queued;
+			std::atomic_bool myIsCancelled = false;
+		};
+
+		using PathRequestHandle = Ref<PathRequest>;
+
+		struct PathfindingSettings
+		{
+			// A* iterations each query may run per update. Searches that run out continue in the next update.
+			uint32_t maxIterationsPerQuery = 1024;
+			uint32_t maxSearchNodes = 2048;
+			uint32_t maxPathPolys = 256;
+		};
+
+		// Accepts path requests from any thread, and runs them in batches on the job system.
+		// Every worker gets its own query object, and requests are spread across them by queue length.
+		// Searches are sliced, so a long path only takes its query's iteration budget per update.
+		class PathfindingService
+		{
+		public:
+			PathfindingService(Ref<dtNavMesh> navmesh, const PathfindingSettings& settings = {});
+			~PathfindingService() = default;
+
+			VT_DELETE_COPY_MOVE(PathfindingService);
+
+			PathRequestHandle RequestPath(const glm::vec3& start, const glm::vec3& end, const glm::vec3& polySearchDistance);
+
+			// Runs the queued searches and returns once the budget of every query is spent, or there is nothing left to do.
+			// The navmesh must not be modified while it runs.
+			void Update();
+
+			// Requests that are queued or in progress.
+			VT_NODISCARD VT_INLINE uint32_t GetPendingRequestCount() const { return myPendingRequestCount.load(std::memory_order_relaxed); }
+
+		private:
+			struct QueryContext
+			{
+				Scope<dtNavMeshQuery> query;
+				std::deque<PathRequestHandle> requests;
+
+				Vector<dtPolyRef> polyBuffer;
+				Vector<glm::vec3> straightPathBuffer;
+			};
+
+			void DistributeIncomingRequests();
+			void ProcessRequests(QueryContext& context);
+
+			bool BeginSearch(QueryContext& context, PathRequest& request);
+			void FinishSearch(QueryContext& context, PathRequest& request, dtStatus searchStatus);
+			void CompleteRequest(PathRequest& request, PathRequestStatus status);
+
+			Ref<dtNavMesh> myNavMesh;
+			PathfindingSettings mySettings;
+
+			Vector<QueryContext> myQueryContexts;
+
+			std::mutex myIncomingMutex;
+			Vector<PathRequestHandle> myIncomingRequests;
+
+			std::atomic_uint32_t myPendingRequestCount = 0;
+		};
+	}
+}
@@ -42,6 +42,8 @@ struct RecastBuildSettings
 	float tileSize = 48.f;
 	// Build using tile cache
 	bool useTileCache = false;
+	// Rasterize and compress tile cache tiles on the job system
+	bool buildTilesInParallel = true;
 	bool useAutoBaking = true;
 };
 
@@ -4,6 +4,7 @@
 #include "InputGeom.h"
 
 #include <DetourNavMesh.h>
+#include <DetourTileCache.h>
 #include <Recast.h>
 
 #include <glm/glm.hpp>
@@ -32,6 +33,18 @@ public:
 	Ref<Volt::AI::NavMesh> BuildSingleNavMesh();
 	Ref<Volt::AI::NavMesh> BuildTiledNavMesh();
 
+	// Rebuilds the tiles overlapping the bounds from the current input geometry, on the nav mesh from the last BuildTiledNavMesh.
+	// Tiles outside of the original build bounds can't be added.
+	bool RebuildTiledNavMeshTiles(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+	bool HasTiledNavMesh() const { return m_tileCache && m_tiledNavMesh; }
+
+	// World bounds of the tiles RebuildTiledNavMeshTiles would rebuild for the bounds, including the border they rasterize.
+	// The input geometry of a rebuild only needs to cover these bounds.
+	bool GetRebuiltTileBounds(const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::vec3& outBoundsMin, glm::vec3& outBoundsMax) const;
+
+	// Forgets the nav mesh from the last BuildTiledNavMesh, it can't be rebuilt after this.
+	void ClearTiledNavMesh();
+
 	RecastBuildContext* GetContext() { return m_ctx.get(); }
 
 	void AddNavLinkConnection(Volt::AI::NavLinkConnection link);
@@ -43,7 +56,11 @@ private:
 	void CleanUp();
 
 	// TileCache
-	int rasterizeTileLayers(const int tx, const int ty, const rcConfig& cfg, struct TileCacheData* tiles, const int maxTiles);
+	bool GetTileRange(const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::ivec2& outMinTile, glm::ivec2& outMaxTile) const;
+	int rasterizeTileLayers(rcContext* ctx, const int tx, const int ty, const rcConfig& cfg, struct TileCacheData* tiles, const int maxTiles);
+
+	// Rasterizes and compresses the tiles, on the job system if enabled, then adds them to the tile cache in the order they were given.
+	void BuildTileCacheLayers(const Vector<glm::ivec2>& tileCoordinates, dtTileCache& tileCache);
 
 	// General Recast
 	rcConfig m_cfg;
@@ -74,6 +91,13 @@ private:
 	Ref<FastLZCompressor> m_tcomp;
 	Ref<MeshProcess> m_tmproc;
 
+	// Kept from the last tiled build, for rebuilding tiles
+	Ref<dtTileCache> m_tileCache;
+	Ref<dtNavMesh> m_tiledNavMesh;
+	rcConfig m_tileConfig;
+	int m_tileGridWidth = 0;
+	int m_tileGridHeight = 0;
+
 	float m_cacheBuildTimeMs;
 	int m_cacheCompressedSize;
 	int m_cacheRawSize;
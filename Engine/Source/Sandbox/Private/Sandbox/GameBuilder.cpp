@@ -3,6 +3,7 @@
 
 #include <Volt/Utility/UIUtility.h>
 #include <Volt/Scene/Scene.h>
+#include <Volt/Asset/Serializers/SceneSerializer.h>
 #include <Volt/Utility/YAMLSerializationHelpers.h>
 #include <Volt/Rendering/Texture/Texture2D.h>
 
@@ -73,7 +74,8 @@ namespace Utility
 			".bank",
 			".vtmeta",
 			".txt",
-			".bnk"
+			".bnk",
+			".vtcooked"
 		};
 
 		const bool result = std::find(includeExtensions.begin(), includeExtensions.end(), path.extension().string()) == includeExtensions.end();
@@ -263,6 +265,30 @@ void GameBuilder::Thread_BuildGame(const BuildInfo& buildInfo)
 		FileSystem::Copy(projectFilePath, buildInfo.buildDirectory / projectFilePath.filename());
 	}
 
+	// Cook scenes, the cooked entities are copied with the assets
+	{
+		for (const auto& handle : buildInfo.sceneHandles)
+		{
+			const bool wasLoaded = Volt::AssetManager::IsLoaded(handle);
+
+			Ref<Volt::Scene> scene = Volt::AssetManager::GetAsset<Volt::Scene>(handle);
+			if (scene)
+			{
+				{
+					std::scoped_lock lock(myMutex);
+					myCurrentFile = Volt::AssetManager::GetFilePathFromAssetHandle(handle).stem().string();
+				}
+
+				Volt::SceneSerializer::Get().CookScene(Volt::AssetManager::GetMetadataFromHandle(handle), scene);
+			}
+
+			if (!wasLoaded)
+			{
+				Volt::AssetManager::Get().Unload(handle);
+			}
+		}
+	}
+
 	// Copy Assets folder
 	{
 		const auto assetsDir = buildInfo.buildDirectory / "Assets";
@@ -94,6 +94,7 @@ void UserSettingsManager::LoadUserSettings()
 	s_editorSettings.navmeshBuildSettings.detailSampleMaxError = streamReader.ReadAtKey("detailSampleMaxError", 1.f);
 	s_editorSettings.navmeshBuildSettings.partitionType = streamReader.ReadAtKey("partitionType", 0);
 	s_editorSettings.navmeshBuildSettings.useTileCache = streamReader.ReadAtKey("useTileCache", false);
+	s_editorSettings.navmeshBuildSettings.buildTilesInParallel = streamReader.ReadAtKey("buildTilesInParallel", true);
 	s_editorSettings.navmeshBuildSettings.useAutoBaking = streamReader.ReadAtKey("useAutoBaking", true);
 
 	streamReader.ExitScope();
@@ -184,6 +185,7 @@ void UserSettingsManager::SaveUserSettings()
 			streamWriter.SetKey("detailSampleMaxError", s_editorSettings.navmeshBuildSettings.detailSampleMaxError);
 			streamWriter.SetKey("partitionType", s_editorSettings.navmeshBuildSettings.partitionType);
 			streamWriter.SetKey("useTileCache", s_editorSettings.navmeshBuildSettings.useTileCache);
+			streamWriter.SetKey("buildTilesInParallel", s_editorSettings.navmeshBuildSettings.buildTilesInParallel);
 			streamWriter.SetKey("useAutoBaking", s_editorSettings.navmeshBuildSettings.useAutoBaking);
 		}
 		streamWriter.EndMap();
@@ -14,6 +14,8 @@
 #include <Sandbox/Utility/EditorUtilities.h>
 #include <Sandbox/UserSettingsManager.h>
 
+#include <unordered_set>
+
 void NavigationPanel::UpdateMainContent()
 {
 	if (ImGui::BeginTabBar("tabs"))
@@ -33,7 +35,9 @@ void NavigationPanel::UpdateMainContent()
 
 void NavigationPanel::Bake()
 {
-	if (auto newMesh = CompileWorldMeshes())
+	const Vector<NavGeometry> geometry = CollectWorldGeometry();
+
+	if (auto newMesh = CompileWorldMeshes(geometry))
 	{
 		myBuilder.SetInputGeom(newMesh);
 		CompileNavLinks();
@@ -52,6 +56,8 @@ void NavigationPanel::Bake()
 			return;
 		}
 
+		StoreBakedGeometryBounds(geometry);
+
 		if (myNavigationSystem.GetVTNavMesh()->GetNavMesh() && !myBuildSettings.useTileCache)
 		{
 			const auto& sceneMeta = Volt::AssetManager::GetMetadataFromHandle(myScene->handle);
@@ -68,6 +74,94 @@ void NavigationPanel::Bake()
 	}
 }
 
+void NavigationPanel::RebakeTiles()
+{
+	if (!myBuilder.HasTiledNavMesh())
+	{
+		return;
+	}
+
+	const Vector<NavGeometry> geometry = CollectWorldGeometry();
+
+	// The tiles under both the old and the new bounds of changed geometry are dirty
+	glm::vec3 dirtyMin = { std::numeric_limits<float>::max() };
+	glm::vec3 dirtyMax = { std::numeric_limits<float>::lowest() };
+	bool hasChanges = false;
+
+	const auto addDirtyBounds = [&](const Volt::BoundingBox& bounds)
+	{
+		dirtyMin = glm::min(dirtyMin, bounds.min);
+		dirtyMax = glm::max(dirtyMax, bounds.max);
+		hasChanges = true;
+	};
+
+	std::unordered_set<Volt::EntityID> currentIds;
+
+	for (const auto& geom : geometry)
+	{
+		currentIds.emplace(geom.id);
+
+		auto it = myBakedGeometryBounds.find(geom.id);
+		if (it == myBakedGeometryBounds.end())
+		{
+			addDirtyBounds(geom.worldBounds);
+		}
+		else if (it->second.min != geom.worldBounds.min || it->second.max != geom.worldBounds.max)
+		{
+			addDirtyBounds(it->second);
+			addDirtyBounds(geom.worldBounds);
+		}
+	}
+
+	for (const auto& [id, bounds] : myBakedGeometryBounds)
+	{
+		if (!currentIds.contains(id))
+		{
+			addDirtyBounds(bounds);
+		}
+	}
+
+	glm::vec3 tilesMin;
+	glm::vec3 tilesMax;
+	if (!hasChanges || !myBuilder.GetRebuiltTileBounds(dirtyMin, dirtyMax, tilesMin, tilesMax))
+	{
+		VT_LOG(Info, "[NavigationPanel] No nav mesh tiles are affected by geometry changes");
+		return;
+	}
+
+	Vector<NavGeometry> tileGeometry;
+	for (const auto& geom : geometry)
+	{
+		if (glm::all(glm::lessThanEqual(geom.worldBounds.min, tilesMax)) && glm::all(glm::greaterThanEqual(geom.worldBounds.max, tilesMin)))
+		{
+			tileGeometry.emplace_back(geom);
+		}
+	}
+
+	auto newMesh = CompileWorldMeshes(tileGeometry);
+	if (!newMesh)
+	{
+		VT_LOG(Warning, "[NavigationPanel] No geometry is left in the changed tiles, bake the whole nav mesh instead");
+		return;
+	}
+
+	myBuilder.SetInputGeom(newMesh);
+	CompileNavLinks();
+
+	if (myBuilder.RebuildTiledNavMeshTiles(dirtyMin, dirtyMax))
+	{
+		StoreBakedGeometryBounds(geometry);
+	}
+}
+
+bool NavigationPanel::OnSceneLoaded(Volt::OnSceneLoadedEvent& e)
+{
+	// The tiles belong to the nav mesh of the previous scene
+	myBuilder.ClearTiledNavMesh();
+	myBakedGeometryBounds.clear();
+	return false;
+}
+
 void NavigationPanel::AgentSettingsTab()
 {
 	ImGui::DragInt("Max Agent", &myBuildSettings.maxAgents, 1.f, 0, 100);
@@ -95,73 +189,118 @@ void NavigationPanel::BuildSettingsTab()
 	ImGui::DragFloat("Tile Size", &myBuildSettings.tileSize, 1.f, 0.f, 100.f);
 	ImGui::Combo("Partition Type", &myBuildSettings.partitionType, "Watershed\0Monotone\0Layers");
 	ImGui::Checkbox("Use TileCache", &myBuildSettings.useTileCache);
+	ImGui::Checkbox("Build Tiles In Parallel", &myBuildSettings.buildTilesInParallel);
 	ImGui::Checkbox("Auto-Baking", &myBuildSettings.useAutoBaking);
 	if (ImGui::Button("Reset to Default"))
 	{
 		SetDefaultBuildSettings();
 	}
+
+	if (myBuildSettings.useTileCache && myBuilder.HasTiledNavMesh())
+	{
+		ImGui::Separator();
+		if (ImGui::Button("Rebake Changed Tiles"))
+		{
+			RebakeTiles();
+		}
+	}
 }
 
-Ref<Volt::Mesh> NavigationPanel::CompileWorldMeshes()
+Vector<NavigationPanel::NavGeometry> NavigationPanel::CollectWorldGeometry()
 {
-	Vector<Ref<Volt::Mesh>> srcMeshes;
-	Vector<glm::mat4> srcTransforms;
-
-	const bool navMeshComponentsExist = myScene->GetRegistry().view<Volt::NavMeshComponent>().empty();
+	Vector<NavGeometry> result;
 
-	if (navMeshComponentsExist)
+	myScene->ForEachWithComponents<const Volt::NavMeshComponent>([&](const entt::entity id, const Volt::NavMeshComponent&)
 	{
-		//myScene->ForEachWithComponents<const Volt::NavMeshComponent, const Volt::BoxColliderComponent>([&](const entt::entity id, const Volt::NavMeshComponent&, const Volt::BoxColliderComponent& collider) 
-		//{
-		//	Volt::Entity entity = { id, myScene };
-		//	auto transform = entity.GetTransform();
+		Volt::Entity entity = { id, myScene };
+		const glm::mat4 transform = entity.GetTransform();
 
-		//	srcMeshes.emplace_back(Volt::AssetManager::GetAsset<Volt::Mesh>("Engine/Meshes/Primitives/SM_Cube_Mesh.vtasset"));
-		//	srcTransforms.emplace_back(transform * glm::translate(glm::mat4(1.f), collider.offset) * glm::scale(glm::mat4(1.f), collider.halfSize * 2.f * 0.01f));
-		//});
+		NavGeometry geometry;
+		geometry.id = entity.GetID();
 
-		//myScene->ForEachWithComponents<const Volt::NavMeshComponent, const Volt::CapsuleColliderComponent>([&](const entt::entity id, const Volt::NavMeshComponent&, const Volt::CapsuleColliderComponent& collider)
-		//{
-		//	Volt::Entity entity = { id, myScene };
-		//	auto transform = entity.GetTransform();
+		if (entity.HasComponent<Volt::MeshColliderComponent>())
+		{
+			geometry.mesh = Volt::AssetManager::GetAsset<Volt::Mesh>(entity.GetComponent<Volt::MeshColliderComponent>().colliderMesh);
+			geometry.transform = transform;
+		}
+		else if (entity.HasComponent<Volt::BoxColliderComponent>())
+		{
+			const auto& collider = entity.GetComponent<Volt::BoxColliderComponent>();
 
-		//	srcMeshes.emplace_back(Volt::AssetManager::GetAsset<Volt::Mesh>("Engine/Meshes/Primitives/SM_Capsule.vtasset"));
-		//	srcTransforms.emplace_back(transform * glm::translate(glm::mat4(1.f), collider.offset) * glm::scale(glm::mat4(1.f), { collider.radius * 2.f * 0.01f, collider.height * 0.01f, collider.radius * 2.f * 0.01f }));
-		//});
+			geometry.mesh = Volt::AssetManager::GetAsset<Volt::Mesh>("Engine/Meshes/Primitives/SM_Cube_Mesh.vtasset");
+			geometry.transform = transform * glm::translate(glm::mat4(1.f), collider.offset) * glm::scale(glm::mat4(1.f), collider.halfSize * 2.f * 0.01f);
+		}
+		else if (entity.HasComponent<Volt::CapsuleColliderComponent>())
+		{
+			const auto& collider = entity.GetComponent<Volt::CapsuleColliderComponent>();
 
-		//myScene->ForEachWithComponents<const Volt::NavMeshComponent, const Volt::SphereColliderComponent>([&](const entt::entity id, const Volt::NavMeshComponent&, const Volt::SphereColliderComponent& collider)
-		//{
-		//	Volt::Entity entity = { id, myScene };
-		//	auto transform = entity.GetTransform();
-		//
-		//	srcMeshes.emplace_back(Volt::AssetManager::GetAsset<Volt::Mesh>("Engine/Meshes/Primitives/SM_Sphere.vtasset"));
-		//	srcTransforms.emplace_back(transform * glm::translate(glm::mat4(1.f), collider.offset) * glm::scale(glm::mat4(1.f), { collider.radius * 2.f * 0.01f }));
-		//});
+			geometry.mesh = Volt::AssetManager::GetAsset<Volt::Mesh>("Engine/Meshes/Primitives/SM_Capsule.vtasset");
+			geometry.transform = transform * glm::translate(glm::mat4(1.f), collider.offset) * glm::scale(glm::mat4(1.f), { collider.radius * 2.f * 0.01f, collider.height * 0.01f, collider.radius * 2.f * 0.01f });
+		}
+		else if (entity.HasComponent<Volt::SphereColliderComponent>())
+		{
+			const auto& collider = entity.GetComponent<Volt::SphereColliderComponent>();
 
-		//myScene->ForEachWithComponents<const Volt::NavMeshComponent, const Volt::CapsuleColliderComponent>([&](const entt::entity id, const Volt::NavMeshComponent&, const Volt::MeshColliderComponent& collider)
-		//{
-		//	Volt::Entity entity = { id, myScene };
-		//	auto transform = entity.GetTransform();
+			geometry.mesh = Volt::AssetManager::GetAsset<Volt::Mesh>("Engine/Meshes/Primitives/SM_Sphere.vtasset");
+			geometry.transform = transform * glm::translate(glm::mat4(1.f), collider.offset) * glm::scale(glm::mat4(1.f), glm::vec3{ collider.radius * 2.f * 0.01f });
+		}
 
-		//	Ref<Volt::Mesh> mesh;
-		//	mesh = Volt::AssetManager::GetAsset<Volt::Mesh>(collider.colliderMesh);
+		if (!geometry.mesh)
+		{
+			return;
+		}
 
-		//	if (!mesh)
-		//	{
-		//		return;
-		//	}
+		// Transform the corners of the local bounding box into world space
+		const auto& localBounds = geometry.mesh->GetBoundingBox();
 
-		//	srcMeshes.emplace_back(mesh);
-		//	srcTransforms.emplace_back(transform);
-		//});
+		geometry.worldBounds.min = glm::vec3{ std::numeric_limits<float>::max() };
+		geometry.worldBounds.max = glm::vec3{ std::numeric_limits<float>::lowest() };
 
-		if (!srcMeshes.empty())
+		for (uint32_t i = 0; i < 8; i++)
 		{
-			return Volt::MeshExporterUtilities::CombineMeshes(srcMeshes, srcTransforms, nullptr);
+			const glm::vec3 corner = { (i & 1) ? localBounds.max.x : localBounds.min.x, (i & 2) ? localBounds.max.y : localBounds.min.y, (i & 4) ? localBounds.max.z : localBounds.min.z };
+			const glm::vec3 worldCorner = geometry.transform * glm::vec4(corner, 1.f);
+
+			geometry.worldBounds.min = glm::min(geometry.worldBounds.min, worldCorner);
+			geometry.worldBounds.max = glm::max(geometry.worldBounds.max, worldCorner);
 		}
+
+		result.emplace_back(geometry);
+	});
+
+	return result;
+}
+
+Ref<Volt::Mesh> NavigationPanel::CompileWorldMeshes(const Vector<NavGeometry>& geometry)
+{
+	if (geometry.empty())
+	{
+		return nullptr;
 	}
 
-	return nullptr;
+	Vector<Ref<Volt::Mesh>> srcMeshes;
+	Vector<glm::mat4> srcTransforms;
+
+	srcMeshes.reserve(geometry.size());
+	srcTransforms.reserve(geometry.size());
+
+	for (const auto& geom : geometry)
+	{
+		srcMeshes.emplace_back(geom.mesh);
+		srcTransforms.emplace_back(geom.transform);
+	}
+
+	return Volt::MeshExporterUtilities::CombineMeshes(srcMeshes, srcTransforms, nullptr);
+}
+
+void NavigationPanel::StoreBakedGeometryBounds(const Vector<NavGeometry>& geometry)
+{
+	myBakedGeometryBounds.clear();
+
+	for (const auto& geom : geometry)
+	{
+		myBakedGeometryBounds[geom.id] = geom.worldBounds;
+	}
 }
 
 void NavigationPanel::CompileNavLinks()
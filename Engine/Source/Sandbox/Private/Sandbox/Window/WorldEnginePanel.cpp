@@ -49,7 +49,8 @@ void WorldEnginePanel::UpdateMainContent()
 
 			Volt::WorldCellID cellId = (x * cellCountX) + y;
 
-			if (worldEngine.IsCellLoaded(cellId))
+			const bool isCellLoaded = worldEngine.IsCellLoaded(cellId);
+			if (isCellLoaded)
 			{
 				color = { 0.f, 1.f, 0.f, 1.f };
 			}
@@ -59,7 +60,14 @@ void WorldEnginePanel::UpdateMainContent()
 			std::string id = "Cell " + std::to_string(cellId) + "##" + std::to_string(x + y);
 			if (ImGui::Button(id.c_str(), { buttonSize, buttonSize }))
 			{
-				worldEngine.BeginStreamingCell(cellId);
+				if (isCellLoaded)
+				{
+					worldEngine.UnloadCell(cellId);
+				}
+				else
+				{
+					worldEngine.BeginStreamingCell(cellId);
+				}
 			}
 
 			if (y < cellCountY - 1)
@@ -6,6 +6,10 @@
 #include <Volt/Core/Application.h>
 
 #include <EventSystem/ApplicationEvents.h>
+#include <Volt/Events/SceneEvents.h>
+#include <Volt/Rendering/BoundingStructures.h>
+
+#include <EntitySystem/EntityID.h>
 
 #include <Sandbox/UserSettingsManager.h>
 
@@ -15,17 +19,34 @@ public:
 	NavigationPanel(Ref<Volt::Scene>& currentScene)
 		: EditorWindow("Navigation Settings"), myBuildSettings(UserSettingsManager::GetSettings().navmeshBuildSettings), myBuilder(myBuildSettings), myScene(currentScene), myNavigationSystem(Volt::Application::Get().GetNavigationSystem())
 	{
+		RegisterListener<Volt::OnSceneLoadedEvent>(VT_BIND_EVENT_FN(NavigationPanel::OnSceneLoaded));
 	}
 
 	void UpdateMainContent() override;
 	void Bake();
 
+	// Rebuilds the tiles of the current tiled nav mesh that are covered by geometry that moved, appeared or disappeared since the last bake.
+	// Only the geometry overlapping the rebuilt tiles is compiled.
+	void RebakeTiles();
+
 private:
+	struct NavGeometry
+	{
+		Volt::EntityID id;
+		Ref<Volt::Mesh> mesh;
+		glm::mat4 transform = { 1.f };
+		Volt::BoundingBox worldBounds;
+	};
+
 	void AgentSettingsTab();
 	void BuildSettingsTab();
 
+	bool OnSceneLoaded(Volt::OnSceneLoadedEvent& e);
+
 
-	Ref<Volt::Mesh> CompileWorldMeshes();
+	Vector<NavGeometry> CollectWorldGeometry();
+	Ref<Volt::Mesh> CompileWorldMeshes(const Vector<NavGeometry>& geometry);
+	void StoreBakedGeometryBounds(const Vector<NavGeometry>& geometry);
 	void SetDefaultAgentSettings();
 	void SetDefaultBuildSettings();
 	void CompileNavLinks();
@@ -37,4 +58,7 @@ private:
 	RecastBuildSettings& myBuildSettings;
 	RecastBuilder myBuilder;
 	Volt::AI::NavigationSystem& myNavigationSystem;
+
+	// World bounds of the geometry at the last bake, compared against on rebake to find the changed tiles.
+	std::unordered_map<Volt::EntityID, Volt::BoundingBox> myBakedGeometryBounds;
 };
@@ -25,13 +25,6 @@ public:
 	bool SavePreset(const std::filesystem::path& indata);
 
 private:
-	struct ParticleSystemData
-	{
-		float emittionTimer = 0;
-		int numberOfAliveParticles = 0;
-		Vector<Volt::Particle> particles;
-	};
-
 	bool OnRenderEvent(Volt::WindowRenderEvent& e);
 	bool OnUpdateEvent(Volt::AppUpdateEvent& e);
 
@@ -48,9 +41,6 @@ private:
 	void DrawElementColor();
 	void DrawElementSize();
 
-
-	//ParticleSystemData myParticleSystemData;
-
 	Volt::Entity myEmitterEntity;
 
 	Vector<std::string> myPresets;
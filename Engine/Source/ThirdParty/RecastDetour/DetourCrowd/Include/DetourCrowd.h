@@ -198,6 +198,19 @@ struct dtCrowdAgentDebugInfo
 	dtObstacleAvoidanceDebugData* vod;
 };
 
+/// A task run by a #dtCrowdParallelForFunc.
+///  @param[in]		taskIndex	The index of the task. [Limits: 0 <= value < taskCount]
+///  @param[in]		taskData	The task data given to the parallel for function.
+typedef void (dtCrowdTaskFunc)(const int taskIndex, void* taskData);
+
+/// Runs every task in [0, taskCount), and returns once all of them have finished.
+/// The tasks may run in any order, and in parallel.
+///  @param[in]		taskCount	The number of tasks to run.
+///  @param[in]		task		The function to call for every task.
+///  @param[in]		taskData	Passed to every call of @p task.
+///  @param[in]		userData	The user data given to dtCrowd::setParallelFor.
+typedef void (dtCrowdParallelForFunc)(const int taskCount, dtCrowdTaskFunc* task, void* taskData, void* userData);
+
 /// Provides local steering behaviors for a group of agents. 
 /// @ingroup crowd
 class dtCrowd
@@ -227,6 +240,21 @@ class dtCrowd
 
 	dtNavMeshQuery* m_navquery;
 
+	dtCrowdParallelForFunc* m_parallelFor;
+	void* m_parallelForUserData;
+	int m_maxTasks;
+
+	// Indexed by task, the first task uses the queries of the crowd.
+	dtNavMeshQuery** m_taskNavQueries;
+	dtObstacleAvoidanceQuery** m_taskObstacleQueries;
+	int* m_taskVelocitySampleCounts;
+
+	bool initTasks();
+	void purgeTasks();
+
+	template<class Func>
+	void runAgentTasks(const int nagents, Func& func);
+
 	void updateTopologyOptimization(dtCrowdAgent** agents, const int nagents, const float dt);
 	void updateMoveRequest(const float dt);
 	void checkPathValidity(dtCrowdAgent** agents, const int nagents, const float dt);
@@ -247,6 +275,15 @@ public:
 	///  @param[in]		nav				The navigation mesh to use for planning.
 	/// @return True if the initialization succeeded.
 	bool init(const int maxAgents, const float maxAgentRadius, dtNavMesh* nav);
+
+	/// Lets the per agent phases of #update be split into tasks that may run in parallel.
+	/// Every task gets its own navmesh and obstacle avoidance query, and agents only write
+	/// to their own state within a phase, so the result is the same as a serial update.
+	///  @param[in]		parallelFor	The function that runs the tasks, or null to update serially.
+	///  @param[in]		userData	Passed to @p parallelFor.
+	///  @param[in]		maxTasks	The maximum number of tasks a phase is split into. [Limit: >= 1]
+	/// @return True if the queries of the tasks could be allocated.
+	bool setParallelFor(dtCrowdParallelForFunc* parallelFor, void* userData, const int maxTasks);
 	
 	/// Sets the shared avoidance configuration for the specified index.
 	///  @param[in]		idx		The index. [Limits: 0 <= value < #DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS]
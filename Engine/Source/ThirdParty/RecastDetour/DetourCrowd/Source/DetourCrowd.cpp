@@ -51,6 +51,9 @@ static const int MAX_ITERS_PER_UPDATE = 100;
 static const int MAX_PATHQUEUE_NODES = 4096;
 static const int MAX_COMMON_NODES = 512;
 
+// Fewer agents than this per task costs more in scheduling than it saves.
+static const int MIN_AGENTS_PER_TASK = 16;
+
 inline float tween(const float t, const float t0, const float t1)
 {
 	return dtClamp((t-t0) / (t1-t0), 0.0f, 1.0f);
@@ -340,7 +343,13 @@ dtCrowd::dtCrowd() :
 	m_maxPathResult(0),
 	m_maxAgentRadius(0),
 	m_velocitySampleCount(0),
-	m_navquery(0)
+	m_navquery(0),
+	m_parallelFor(0),
+	m_parallelForUserData(0),
+	m_maxTasks(1),
+	m_taskNavQueries(0),
+	m_taskObstacleQueries(0),
+	m_taskVelocitySampleCounts(0)
 {
 }
 
@@ -369,6 +378,8 @@ void dtCrowd::purge()
 	dtFreeProximityGrid(m_grid);
 	m_grid = 0;
 
+	purgeTasks();
+
 	dtFreeObstacleAvoidanceQuery(m_obstacleQuery);
 	m_obstacleQuery = 0;
 	
@@ -458,10 +469,125 @@ bool dtCrowd::init(const int maxAgents, const float maxAgentRadius, dtNavMesh* n
 		return false;
 	if (dtStatusFailed(m_navquery->init(nav, MAX_COMMON_NODES)))
 		return false;
+
+	if (!initTasks())
+		return false;
 	
 	return true;
 }
 
+/// @par
+///
+/// May be called before or after #init, the task queries are recreated whenever the crowd is initialized.
+bool dtCrowd::setParallelFor(dtCrowdParallelForFunc* parallelFor, void* userData, const int maxTasks)
+{
+	purgeTasks();
+
+	m_parallelFor = parallelFor;
+	m_parallelForUserData = userData;
+	m_maxTasks = parallelFor ? dtMax(1, maxTasks) : 1;
+
+	// Not initialized yet, init creates the tasks.
+	if (!m_navquery)
+		return true;
+
+	return initTasks();
+}
+
+bool dtCrowd::initTasks()
+{
+	m_taskNavQueries = (dtNavMeshQuery**)dtAlloc(sizeof(dtNavMeshQuery*)*m_maxTasks, DT_ALLOC_PERM);
+	m_taskObstacleQueries = (dtObstacleAvoidanceQuery**)dtAlloc(sizeof(dtObstacleAvoidanceQuery*)*m_maxTasks, DT_ALLOC_PERM);
+	m_taskVelocitySampleCounts = (int*)dtAlloc(sizeof(int)*m_maxTasks, DT_ALLOC_PERM);
+
+	if (m_taskNavQueries)
+		memset(m_taskNavQueries, 0, sizeof(dtNavMeshQuery*)*m_maxTasks);
+	if (m_taskObstacleQueries)
+		memset(m_taskObstacleQueries, 0, sizeof(dtObstacleAvoidanceQuery*)*m_maxTasks);
+
+	if (!m_taskNavQueries || !m_taskObstacleQueries || !m_taskVelocitySampleCounts)
+	{
+		purgeTasks();
+		return false;
+	}
+
+	memset(m_taskVelocitySampleCounts, 0, sizeof(int)*m_maxTasks);
+
+	m_taskNavQueries[0] = m_navquery;
+	m_taskObstacleQueries[0] = m_obstacleQuery;
+
+	const dtNavMesh* nav = m_navquery->getAttachedNavMesh();
+	for (int i = 1; i < m_maxTasks; ++i)
+	{
+		m_taskNavQueries[i] = dtAllocNavMeshQuery();
+		m_taskObstacleQueries[i] = dtAllocObstacleAvoidanceQuery();
+		if (!m_taskNavQueries[i] || !m_taskObstacleQueries[i] ||
+			dtStatusFailed(m_taskNavQueries[i]->init(nav, MAX_COMMON_NODES)) ||
+			!m_taskObstacleQueries[i]->init(6, 8))
+		{
+			purgeTasks();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void dtCrowd::purgeTasks()
+{
+	// The first task doesn't own its queries.
+	for (int i = 1; i < m_maxTasks; ++i)
+	{
+		if (m_taskNavQueries)
+			dtFreeNavMeshQuery(m_taskNavQueries[i]);
+		if (m_taskObstacleQueries)
+			dtFreeObstacleAvoidanceQuery(m_taskObstacleQueries[i]);
+	}
+
+	dtFree(m_taskNavQueries);
+	m_taskNavQueries = 0;
+
+	dtFree(m_taskObstacleQueries);
+	m_taskObstacleQueries = 0;
+
+	dtFree(m_taskVelocitySampleCounts);
+	m_taskVelocitySampleCounts = 0;
+}
+
+template<class Func>
+struct dtCrowdAgentRange
+{
+	Func* func;
+	int nagents;
+	int ntasks;
+};
+
+template<class Func>
+static void runAgentRange(const int taskIndex, void* taskData)
+{
+	const dtCrowdAgentRange<Func>* range = (const dtCrowdAgentRange<Func>*)taskData;
+	const int begin = (int)((long long)range->nagents * taskIndex / range->ntasks);
+	const int end = (int)((long long)range->nagents * (taskIndex+1) / range->ntasks);
+
+	for (int i = begin; i < end; ++i)
+		(*range->func)(i, taskIndex);
+}
+
+template<class Func>
+void dtCrowd::runAgentTasks(const int nagents, Func& func)
+{
+	const int ntasks = dtMin(m_maxTasks, (nagents + MIN_AGENTS_PER_TASK-1) / MIN_AGENTS_PER_TASK);
+	if (!m_parallelFor || ntasks <= 1)
+	{
+		for (int i = 0; i < nagents; ++i)
+			func(i, 0);
+		return;
+	}
+
+	dtCrowdAgentRange<Func> range = { &func, nagents, ntasks };
+	m_parallelFor(ntasks, runAgentRange<Func>, &range, m_parallelForUserData);
+}
+
 void dtCrowd::setObstacleAvoidanceParams(const int idx, const dtObstacleAvoidanceParams* params)
 {
 	if (idx >= 0 && idx < DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS)
@@ -1073,20 +1199,22 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 	}
 	
 	// Get nearby navmesh segments and agents to collide with.
-	for (int i = 0; i < nagents; ++i)
+	auto updateNeighbours = [&](const int i, const int task)
 	{
 		dtCrowdAgent* ag = agents[i];
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
+			return;
+
+		dtNavMeshQuery* navquery = m_taskNavQueries[task];
 
 		// Update the collision boundary after certain distance has been passed or
 		// if it has become invalid.
 		const float updateThr = ag->params.collisionQueryRange*0.25f;
 		if (dtVdist2DSqr(ag->npos, ag->boundary.getCenter()) > dtSqr(updateThr) ||
-			!ag->boundary.isValid(m_navquery, &m_filters[ag->params.queryFilterType]))
+			!ag->boundary.isValid(navquery, &m_filters[ag->params.queryFilterType]))
 		{
 			ag->boundary.update(ag->corridor.getFirstPoly(), ag->npos, ag->params.collisionQueryRange,
-								m_navquery, &m_filters[ag->params.queryFilterType]);
+								navquery, &m_filters[ag->params.queryFilterType]);
 		}
 		// Query neighbour agents
 		ag->nneis = getNeighbours(ag->npos, ag->params.height, ag->params.collisionQueryRange,
@@ -1094,28 +1222,31 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 								  agents, nagents, m_grid);
 		for (int j = 0; j < ag->nneis; j++)
 			ag->neis[j].idx = getAgentIndex(agents[ag->neis[j].idx]);
-	}
+	};
+	runAgentTasks(nagents, updateNeighbours);
 	
 	// Find next corner to steer to.
-	for (int i = 0; i < nagents; ++i)
+	auto updateCorners = [&](const int i, const int task)
 	{
 		dtCrowdAgent* ag = agents[i];
 		
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
+			return;
 		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
-			continue;
+			return;
+
+		dtNavMeshQuery* navquery = m_taskNavQueries[task];
 		
 		// Find corners for steering
 		ag->ncorners = ag->corridor.findCorners(ag->cornerVerts, ag->cornerFlags, ag->cornerPolys,
-												DT_CROWDAGENT_MAX_CORNERS, m_navquery, &m_filters[ag->params.queryFilterType]);
+												DT_CROWDAGENT_MAX_CORNERS, navquery, &m_filters[ag->params.queryFilterType]);
 		
 		// Check to see if the corner after the next corner is directly visible,
 		// and short cut to there.
 		if ((ag->params.updateFlags & DT_CROWD_OPTIMIZE_VIS) && ag->ncorners > 0)
 		{
 			const float* target = &ag->cornerVerts[dtMin(1,ag->ncorners-1)*3];
-			ag->corridor.optimizePathVisibility(target, ag->params.pathOptimizationRange, m_navquery, &m_filters[ag->params.queryFilterType]);
+			ag->corridor.optimizePathVisibility(target, ag->params.pathOptimizationRange, navquery, &m_filters[ag->params.queryFilterType]);
 			
 			// Copy data for debug purposes.
 			if (debugIdx == i)
@@ -1133,7 +1264,8 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 				dtVset(debug->optEnd, 0,0,0);
 			}
 		}
-	}
+	};
+	runAgentTasks(nagents, updateCorners);
 	
 	// Trigger off-mesh connections (depends on corners).
 	for (int i = 0; i < nagents; ++i)
@@ -1177,14 +1309,14 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 	}
 		
 	// Calculate steering.
-	for (int i = 0; i < nagents; ++i)
+	auto updateSteering = [&](const int i, const int /*task*/)
 	{
 		dtCrowdAgent* ag = agents[i];
 
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
+			return;
 		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE)
-			continue;
+			return;
 		
 		float dvel[3] = {0,0,0};
 
@@ -1253,25 +1385,30 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 		
 		// Set the desired velocity.
 		dtVcopy(ag->dvel, dvel);
-	}
+	};
+	runAgentTasks(nagents, updateSteering);
 	
-	// Velocity planning.	
-	for (int i = 0; i < nagents; ++i)
+	// Velocity planning.
+	for (int i = 0; i < m_maxTasks; ++i)
+		m_taskVelocitySampleCounts[i] = 0;
+
+	auto updateVelocity = [&](const int i, const int task)
 	{
 		dtCrowdAgent* ag = agents[i];
 		
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
+			return;
 		
 		if (ag->params.updateFlags & DT_CROWD_OBSTACLE_AVOIDANCE)
 		{
-			m_obstacleQuery->reset();
+			dtObstacleAvoidanceQuery* obstacleQuery = m_taskObstacleQueries[task];
+			obstacleQuery->reset();
 			
 			// Add neighbours as obstacles.
 			for (int j = 0; j < ag->nneis; ++j)
 			{
 				const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
-				m_obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
+				obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
 			}
 
 			// Append neighbour segments as obstacles.
@@ -1280,7 +1417,7 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 				const float* s = ag->boundary.getSegment(j);
 				if (dtTriArea2D(ag->npos, s, s+3) < 0.0f)
 					continue;
-				m_obstacleQuery->addSegment(s, s+3);
+				obstacleQuery->addSegment(s, s+3);
 			}
 
 			dtObstacleAvoidanceDebugData* vod = 0;
@@ -1295,107 +1432,116 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 				
 			if (adaptive)
 			{
-				ns = m_obstacleQuery->sampleVelocityAdaptive(ag->npos, ag->params.radius, ag->desiredSpeed,
+				ns = obstacleQuery->sampleVelocityAdaptive(ag->npos, ag->params.radius, ag->desiredSpeed,
 															 ag->vel, ag->dvel, ag->nvel, params, vod);
 			}
 			else
 			{
-				ns = m_obstacleQuery->sampleVelocityGrid(ag->npos, ag->params.radius, ag->desiredSpeed,
+				ns = obstacleQuery->sampleVelocityGrid(ag->npos, ag->params.radius, ag->desiredSpeed,
 														 ag->vel, ag->dvel, ag->nvel, params, vod);
 			}
-			m_velocitySampleCount += ns;
+			m_taskVelocitySampleCounts[task] += ns;
 		}
 		else
 		{
 			// If not using velocity planning, new velocity is directly the desired velocity.
 			dtVcopy(ag->nvel, ag->dvel);
 		}
-	}
+	};
+	runAgentTasks(nagents, updateVelocity);
 
-	// Integrate.
-	for (int i = 0; i < nagents; ++i)
+	for (int i = 0; i < m_maxTasks; ++i)
+		m_velocitySampleCount += m_taskVelocitySampleCounts[i];
+
+	// Integrate, after all agents have planned with the velocities of their neighbours.
+	auto integrateAgent = [&](const int i, const int /*task*/)
 	{
 		dtCrowdAgent* ag = agents[i];
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
+			return;
 		integrate(ag, dt);
-	}
+	};
+	runAgentTasks(nagents, integrateAgent);
 	
 	// Handle collisions.
 	static const float COLLISION_RESOLVE_FACTOR = 0.7f;
-	
-	for (int iter = 0; iter < 4; ++iter)
+
+	auto updateCollisionDisplacement = [&](const int i, const int /*task*/)
 	{
-		for (int i = 0; i < nagents; ++i)
+		dtCrowdAgent* ag = agents[i];
+		const int idx0 = getAgentIndex(ag);
+		
+		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+			return;
+
+		dtVset(ag->disp, 0,0,0);
+		
+		float w = 0;
+
+		for (int j = 0; j < ag->nneis; ++j)
 		{
-			dtCrowdAgent* ag = agents[i];
-			const int idx0 = getAgentIndex(ag);
-			
-			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-				continue;
+			const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
+			const int idx1 = getAgentIndex(nei);
 
-			dtVset(ag->disp, 0,0,0);
+			float diff[3];
+			dtVsub(diff, ag->npos, nei->npos);
+			diff[1] = 0;
 			
-			float w = 0;
-
-			for (int j = 0; j < ag->nneis; ++j)
+			float dist = dtVlenSqr(diff);
+			if (dist > dtSqr(ag->params.radius + nei->params.radius))
+				continue;
+			dist = dtMathSqrtf(dist);
+			float pen = (ag->params.radius + nei->params.radius) - dist;
+			if (dist < 0.0001f)
 			{
-				const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
-				const int idx1 = getAgentIndex(nei);
-
-				float diff[3];
-				dtVsub(diff, ag->npos, nei->npos);
-				diff[1] = 0;
-				
-				float dist = dtVlenSqr(diff);
-				if (dist > dtSqr(ag->params.radius + nei->params.radius))
-					continue;
-				dist = dtMathSqrtf(dist);
-				float pen = (ag->params.radius + nei->params.radius) - dist;
-				if (dist < 0.0001f)
-				{
-					// Agents on top of each other, try to choose diverging separation directions.
-					if (idx0 > idx1)
-						dtVset(diff, -ag->dvel[2],0,ag->dvel[0]);
-					else
-						dtVset(diff, ag->dvel[2],0,-ag->dvel[0]);
-					pen = 0.01f;
-				}
+				// Agents on top of each other, try to choose diverging separation directions.
+				if (idx0 > idx1)
+					dtVset(diff, -ag->dvel[2],0,ag->dvel[0]);
 				else
-				{
-					pen = (1.0f/dist) * (pen*0.5f) * COLLISION_RESOLVE_FACTOR;
-				}
-				
-				dtVmad(ag->disp, ag->disp, diff, pen);			
-				
-				w += 1.0f;
+					dtVset(diff, ag->dvel[2],0,-ag->dvel[0]);
+				pen = 0.01f;
 			}
-			
-			if (w > 0.0001f)
+			else
 			{
-				const float iw = 1.0f / w;
-				dtVscale(ag->disp, ag->disp, iw);
+				pen = (1.0f/dist) * (pen*0.5f) * COLLISION_RESOLVE_FACTOR;
 			}
+			
+			dtVmad(ag->disp, ag->disp, diff, pen);			
+			
+			w += 1.0f;
 		}
 		
-		for (int i = 0; i < nagents; ++i)
+		if (w > 0.0001f)
 		{
-			dtCrowdAgent* ag = agents[i];
-			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-				continue;
-			
-			dtVadd(ag->npos, ag->npos, ag->disp);
+			const float iw = 1.0f / w;
+			dtVscale(ag->disp, ag->disp, iw);
 		}
+	};
+
+	auto applyCollisionDisplacement = [&](const int i, const int /*task*/)
+	{
+		dtCrowdAgent* ag = agents[i];
+		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+			return;
+		
+		dtVadd(ag->npos, ag->npos, ag->disp);
+	};
+	
+	for (int iter = 0; iter < 4; ++iter)
+	{
+		// All displacements are calculated before any are applied, as they read the positions of the neighbours.
+		runAgentTasks(nagents, updateCollisionDisplacement);
+		runAgentTasks(nagents, applyCollisionDisplacement);
 	}
 	
-	for (int i = 0; i < nagents; ++i)
+	auto moveAlongNavmesh = [&](const int i, const int task)
 	{
 		dtCrowdAgent* ag = agents[i];
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
+			return;
 		
 		// Move along navmesh.
-		ag->corridor.movePosition(ag->npos, m_navquery, &m_filters[ag->params.queryFilterType]);
+		ag->corridor.movePosition(ag->npos, m_taskNavQueries[task], &m_filters[ag->params.queryFilterType]);
 		// Get valid constrained position back.
 		dtVcopy(ag->npos, ag->corridor.getPos());
 
@@ -1405,8 +1551,8 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 			ag->corridor.reset(ag->corridor.getFirstPoly(), ag->npos);
 			ag->partial = false;
 		}
-
-	}
+	};
+	runAgentTasks(nagents, moveAlongNavmesh);
 	
 	// Update agents using off-mesh connection.
 	for (int i = 0; i < nagents; ++i)
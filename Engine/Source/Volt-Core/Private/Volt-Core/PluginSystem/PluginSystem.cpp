@@ -63,26 +63,28 @@ namespace Volt
 	void PluginSystem::InitializePlugins()
 	{
 		const auto& dependencyGraph = m_pluginRegistry->GetPluginDependencyGraph();
+		const auto& initializationOrder = dependencyGraph.GetTopologicalOrder();
 
-		Vector<UUID64> initialPlugins;
-		for (const auto& node : dependencyGraph.GetNodes())
+		if (initializationOrder.size() != dependencyGraph.GetNodes().size())
 		{
-			if (!node.GetInputEdges().empty())
-			{
-				continue;
-			}
+			VT_LOGC(Warning, LogPluginSystem, "Plugin dependencies contain a cycle! {} plugins in or depending on it will not be initialized!", dependencyGraph.GetNodes().size() - initializationOrder.size());
+		}
 
+		// Plugins come before the plugins they depend on, like when walking down from the plugins nothing depends on
+		for (const auto& nodeId : initializationOrder)
+		{
+			const auto& node = dependencyGraph.GetNodeFromID(nodeId);
 			if (!m_guidToIndexMap.contains(node.nodeData))
 			{
 				continue;
 			}
 
-			initialPlugins.emplace_back(node.id);
-		}
-
-		for (const auto& nodeId : initialPlugins)
-		{
-			InitializePluginAndDependencies(nodeId, dependencyGraph);
+			auto& pluginContainer = m_loadedPlugins.at(m_guidToIndexMap.at(node.nodeData));
+			if (!pluginContainer.initialized)
+			{
+				pluginContainer.pluginPtr->Initialize();
+				pluginContainer.initialized = true;
+			}
 		}
 	}
 
@@ -147,28 +149,6 @@ namespace Volt
 		return true;
 	}
 
-	void PluginSystem::InitializePluginAndDependencies(UUID64 nodeId, const Graph<VoltGUID, uint32_t>& dependencyGraph)
-	{
-		const auto& node = dependencyGraph.GetNodeFromID(nodeId);
-		if (!m_guidToIndexMap.contains(node.nodeData))
-		{
-			return;
-		}
-
-		auto& pluginContainer = m_loadedPlugins.at(m_guidToIndexMap.at(node.nodeData));
-		if (!pluginContainer.initialized)
-		{
-			pluginContainer.pluginPtr->Initialize();
-			pluginContainer.initialized = true;
-		}
-
-		for (const auto& edgeId : node.GetOutputEdges())
-		{
-			const auto& edge = dependencyGraph.GetEdgeFromID(edgeId);
-			InitializePluginAndDependencies(edge.endNode, dependencyGraph);
-		}
-	}
-
 	PluginFactory::PluginFactory(PFN_PluginCreateInstance createFunc, PFN_PluginDestroyInstance destroyFunc)
 		: m_createInstanceFunc(createFunc), m_destroyInstanceFunc(destroyFunc)
 	{
@@ -62,8 +62,6 @@ namespace Volt
 
 	private:
 		bool LoadPlugin(const PluginDefinition& pluginDefinition);
-		
-		void InitializePluginAndDependencies(UUID64 nodeId, const Graph<VoltGUID, uint32_t>& dependencyGraph);
 
 		PluginRegistry* m_pluginRegistry = nullptr;
 
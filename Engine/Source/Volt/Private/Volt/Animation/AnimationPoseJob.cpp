@@ -0,0 +1,40 @@
+#include "vtpch.h"
+#include "Volt/Animation/AnimationPoseJob.h"
+
+#include "Volt/Animation/MotionWeaver.h"
+
+#include <JobSystem/JobSystem.h>
+
+#include <CoreUtilities/Memory/ScratchArena.h>
+
+namespace Volt::AnimationPoseJob
+{
+	namespace Utility
+	{
+		ScratchArena& GetWorkerScratchArena()
+		{
+			static thread_local ScratchArena s_scratchArena;
+			return s_scratchArena;
+		}
+	}
+
+	void EvaluatePoses(std::span<const AnimationPoseRequest> requests, std::span<glm::mat4> outBoneMatrices)
+	{
+		VT_PROFILE_FUNCTION();
+
+		JobSystem::ParallelFor(requests.size(), [&](size_t requestIndex)
+		{
+			const AnimationPoseRequest& request = requests[requestIndex];
+			VT_ENSURE(static_cast<size_t>(request.boneOffset) + request.boneCount <= outBoneMatrices.size());
+
+			ScratchArena& scratchArena = Utility::GetWorkerScratchArena();
+			scratchArena.Reset();
+
+			std::span<glm::mat4> skinningMatrices = outBoneMatrices.subspan(request.boneOffset, request.boneCount);
+			if (!request.motionWeaver->Sample(skinningMatrices, scratchArena))
+			{
+				std::fill(skinningMatrices.begin(), skinningMatrices.end(), glm::mat4{ 1.f });
+			}
+		});
+	}
+}
@@ -6,6 +6,8 @@
 
 #include <AssetSystem/AssetManager.h>
 
+#include <CoreUtilities/Memory/ScratchArena.h>
+
 namespace Volt
 {
 
@@ -69,4 +71,25 @@ namespace Volt
 		return result;
 	}
 
-}
+	bool Volt::MotionWeaver::Sample(std::span<glm::mat4x4> outSkinningMatrices, ScratchArena& scratchArena) const
+	{
+		if (m_Animations.empty() || !m_Skeleton || outSkinningMatrices.size() != m_Skeleton->GetJointCount())
+		{
+			return false;
+		}
+
+		const auto& animation = m_Animations.front();
+
+		const float percent = m_Time / animation->GetDuration();
+		std::span<Animation::TRS> localPose = scratchArena.Allocate<Animation::TRS>(outSkinningMatrices.size());
+
+		if (!animation->SampleLocalPose(percent, true, localPose))
+		{
+			return false;
+		}
+
+		Animation::LocalPoseToSkinningMatrices(localPose, *m_Skeleton, outSkinningMatrices);
+		return true;
+	}
+
+}
\ No newline at end of file
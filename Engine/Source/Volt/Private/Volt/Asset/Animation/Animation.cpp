@@ -2,6 +2,7 @@
 #include "Volt/Asset/Animation/Animation.h"
 
 #include "Volt/Asset/Animation/Skeleton.h"
+#include "Volt/Asset/Animation/CompressedAnimationClip.h"
 #include "Volt/Animation/AnimationManager.h"
 
 namespace Volt
@@ -15,7 +16,7 @@ namespace Volt
 		const float localTime = AnimationManager::globalClock - aStartTime;
 		const float normalizedTime = localTime / m_duration;
 
-		const int32_t frameCount = (int32_t)m_frames.size();
+		const int32_t frameCount = (int32_t)GetFrameCount();
 		int32_t currentFrameIndex = frameCount - std::abs((int32_t)(std::floor(normalizedTime * (float)frameCount)) % (2 * frameCount) - frameCount);
 
 		currentFrameIndex = std::clamp(currentFrameIndex, 0, frameCount - 1);
@@ -34,10 +35,7 @@ namespace Volt
 			}
 		}
 
-		Vector<glm::mat4> result;
-		result.resize(aSkeleton->GetJointCount(), glm::mat4(1.f));
-
-		if (result.empty())
+		if (aSkeleton->GetJointCount() == 0)
 		{
 			return {};
 		}
@@ -46,46 +44,16 @@ namespace Volt
 		const float frameTime = localTime / animDelta;
 		const float deltaTime = frameTime - (float)currentFrameIndex;
 
-		const Pose& currentFrame = m_frames.at(currentFrameIndex);
-		const Pose& nextFrame = m_frames.at(nextFrameIndex);
-
-		const auto& joints = aSkeleton->GetJoints();
-		const auto& invBindPoses = aSkeleton->GetInverseBindPose();
-
-		for (size_t i = 0; i < joints.size(); i++)
+		Vector<TRS> localPose(aSkeleton->GetJointCount());
+		if (!BlendFrames(static_cast<uint32_t>(currentFrameIndex), static_cast<uint32_t>(nextFrameIndex), deltaTime, localPose))
 		{
-			const auto& joint = joints[i];
-
-			glm::mat4 parentTransform = { 1.f };
-
-			if (joint.parentIndex >= 0)
-			{
-				parentTransform = result[joint.parentIndex];
-			}
-
-			const auto& currentLocalTransform = currentFrame.localTRS[i];
-			const auto& nextLocalTransform = nextFrame.localTRS[i];
-
-			glm::mat4 resultTransform;
-
-			// Blend
-			{
-				const glm::vec3 position = glm::mix(currentLocalTransform.translation, nextLocalTransform.translation, deltaTime);
-				const glm::quat rotation = glm::slerp(glm::normalize(currentLocalTransform.rotation), glm::normalize(nextLocalTransform.rotation), deltaTime);
-				const glm::vec3 scale = glm::mix(currentLocalTransform.scale, nextLocalTransform.scale, deltaTime);
-
-				resultTransform = glm::translate(glm::mat4{ 1.f }, position) * glm::mat4_cast(rotation) * glm::scale(glm::mat4{ 1.f }, scale);
-			}
-
-			glm::mat4 resultT = parentTransform * resultTransform;
-			result[i] = resultT;
+			return {};
 		}
 
-		for (size_t i = 0; i < result.size(); i++)
-		{
-			result[i] = result[i] * invBindPoses[i];
-		}
+		Vector<glm::mat4> result;
+		result.resize_uninitialized(aSkeleton->GetJointCount());
 
+		LocalPoseToSkinningMatrices(localPose, *aSkeleton, result);
 		return result;
 	}
 
@@ -109,120 +77,94 @@ namespace Volt
 			return {};
 		}
 
-		const uint32_t frameCount = static_cast<uint32_t>(m_frames.size());
-
-		if (frameCount == 0)
+		if (GetFrameCount() == 0)
 		{
 			VT_LOG(Error, "Tried to sample animation with no frames");
 			return {};
 		}
 
-		const uint32_t frameIndexBeforeTime = static_cast<uint32_t>(std::floor(samplePercent * static_cast<float>(frameCount)));
-		//if we are looping, modulus the frame index to the frame count, otherwise clamp it
-		const uint32_t frameIndexAfterTime = looping ? ((frameIndexBeforeTime + 1) % (frameCount)) : std::clamp(frameIndexBeforeTime + 1, 0u, frameCount - 1);
-		const float percentageBetweenFrames = (samplePercent * frameCount) - frameIndexBeforeTime;
-
-		Vector<glm::mat4> result;
-		result.resize(skeleton->GetJointCount(), glm::mat4(1.f));
-
-		if (result.empty())
+		if (skeleton->GetJointCount() == 0)
 		{
 			VT_LOG(Error, "Tried to sample using a skeleton with no joints. AssetHandle: {0}", skeleton->handle);
 			return {};
 		}
 
-		//B
-		const Pose& currentFrame = m_frames.at(frameIndexBeforeTime);
-		const Pose& nextFrame = m_frames.at(frameIndexAfterTime);
+		Vector<TRS> localPose(skeleton->GetJointCount());
+		if (!SampleLocalPose(samplePercent, looping, localPose))
+		{
+			return {};
+		}
 
-		const Pose blendedPose = GetBlendedPose(currentFrame, nextFrame, percentageBetweenFrames);
-		//B
+		Vector<glm::mat4> result;
+		result.resize_uninitialized(skeleton->GetJointCount());
 
-		const Vector<Skeleton::Joint>& joints = skeleton->GetJoints();
-		const Vector<glm::mat4>& invBindPose = skeleton->GetInverseBindPose();
+		LocalPoseToSkinningMatrices(localPose, *skeleton, result);
+		return result;
+	}
 
-		for (size_t i = 0; i < joints.size(); i++)
+	bool Animation::SampleLocalPose(float samplePercent, bool looping, std::span<TRS> outLocalPose) const
+	{
+		const uint32_t frameCount = static_cast<uint32_t>(GetFrameCount());
+		if (frameCount == 0)
 		{
-			const Skeleton::Joint& joint = joints[i];
+			return false;
+		}
 
-			glm::mat4 parentTransform = { 1.f };
+		samplePercent = std::clamp(samplePercent, 0.f, 1.f);
 
-			if (joint.parentIndex >= 0)
-			{
-				parentTransform = result[joint.parentIndex];
-			}
+		const uint32_t frameIndexBeforeTime = std::min(static_cast<uint32_t>(std::floor(samplePercent * static_cast<float>(frameCount))), frameCount - 1);
+		//if we are looping, modulus the frame index to the frame count, otherwise clamp it
+		const uint32_t frameIndexAfterTime = looping ? ((frameIndexBeforeTime + 1) % (frameCount)) : std::clamp(frameIndexBeforeTime + 1, 0u, frameCount - 1);
+		const float percentageBetweenFrames = (samplePercent * frameCount) - frameIndexBeforeTime;
 
-			const Animation::TRS& localTransform = blendedPose.localTRS[i];
+		return BlendFrames(frameIndexBeforeTime, frameIndexAfterTime, percentageBetweenFrames, outLocalPose);
+	}
+
+	void Animation::LocalPoseToSkinningMatrices(std::span<const TRS> localPose, const Skeleton& skeleton, std::span<glm::mat4> outSkinningMatrices)
+	{
+		const Vector<Skeleton::Joint>& joints = skeleton.GetJoints();
+		const Vector<glm::mat4>& invBindPose = skeleton.GetInverseBindPose();
 
-			glm::mat4 resultTransform = glm::translate(glm::mat4{ 1.f }, localTransform.translation) * glm::mat4_cast(localTransform.rotation) * glm::scale(glm::mat4{ 1.f }, localTransform.scale);
+		VT_ENSURE(localPose.size() == joints.size() && outSkinningMatrices.size() == joints.size());
 
-			glm::mat4 resultT = parentTransform * resultTransform;
-			result[i] = resultT;
+		// Parents come before their children, so the global transforms are built in place
+		for (size_t i = 0; i < joints.size(); i++)
+		{
+			const TRS& localTransform = localPose[i];
+			const glm::mat4 resultTransform = glm::translate(glm::mat4{ 1.f }, localTransform.translation) * glm::mat4_cast(localTransform.rotation) * glm::scale(glm::mat4{ 1.f }, localTransform.scale);
+
+			const int32_t parentIndex = joints[i].parentIndex;
+			outSkinningMatrices[i] = parentIndex >= 0 ? outSkinningMatrices[parentIndex] * resultTransform : resultTransform;
 		}
 
-		for (size_t i = 0; i < result.size(); i++)
+		for (size_t i = 0; i < joints.size(); i++)
 		{
-			result[i] = result[i] * invBindPose[i];
+			outSkinningMatrices[i] = outSkinningMatrices[i] * invBindPose[i];
 		}
-		
-		return result;
 	}
 
 	const Vector<glm::mat4> Animation::Sample(uint32_t frameIndex, Ref<Skeleton> aSkeleton)
 	{
 		VT_PROFILE_FUNCTION();
 
-		Vector<glm::mat4> result;
-		result.resize(aSkeleton->GetJointCount(), glm::mat4(1.f));
-
-		if (result.empty())
+		if (aSkeleton->GetJointCount() == 0)
 		{
 			return {};
 		}
 
-		const Pose& currentFrame = m_frames.at(frameIndex);
-
-		const auto& joints = aSkeleton->GetJoints();
-		const auto& invBindPoses = aSkeleton->GetInverseBindPose();
-
-		for (size_t i = 0; i < joints.size(); i++)
+		Vector<TRS> localPose(aSkeleton->GetJointCount());
+		if (!BlendFrames(frameIndex, frameIndex, 0.f, localPose))
 		{
-			const auto& joint = joints[i];
-
-			glm::mat4 parentTransform = { 1.f };
-
-			if (joint.parentIndex >= 0)
-			{
-				parentTransform = result[joint.parentIndex];
-			}
-
-			const auto& currentLocalTransform = currentFrame.localTRS[i];
-
-			glm::mat4 resultTransform;
-
-			const glm::vec3 position = currentLocalTransform.translation;
-			const glm::quat rotation = glm::normalize(currentLocalTransform.rotation);
-			const glm::vec3 scale = currentLocalTransform.scale;
-
-			resultTransform = glm::translate(glm::mat4{ 1.f }, position) * glm::mat4_cast(rotation) * glm::scale(glm::mat4{ 1.f }, scale);
-
-			glm::mat4 resultT = parentTransform * resultTransform;
-			result[i] = resultT;
+			return {};
 		}
 
-		for (size_t i = 0; i < result.size(); i++)
-		{
-			result[i] = result[i] * invBindPoses[i];
-		}
+		Vector<glm::mat4> result;
+		result.resize_uninitialized(aSkeleton->GetJointCount());
 
+		LocalPoseToSkinningMatrices(localPose, *aSkeleton, result);
 		return result;
 	}
 
-	Vector<glm::mat4> Animation::LocalPoseToGlobalMatrices(const Pose& localPose, Ref<Skeleton> aSkeleton)
-	{
-		return Vector<glm::mat4>();
-	}
-
 	void Animation::BlendPoseWith(Pose& target, const Pose& poseToBlendWith, float blendFactor)
 	{
 		VT_PROFILE_FUNCTION();
@@ -278,7 +220,7 @@ namespace Volt
 		const float localTime = AnimationManager::globalClock - aStartTime;
 		const float normalizedTime = localTime / finalDuration;
 
-		const int32_t frameCount = (int32_t)m_frames.size();
+		const int32_t frameCount = (int32_t)GetFrameCount();
 		int32_t currentFrameIndex = (int32_t)(std::floor(normalizedTime * (float)frameCount)) % frameCount;
 
 		if (normalizedTime > 1.f && !looping)
@@ -307,27 +249,8 @@ namespace Volt
 		Vector<TRS> result;
 		result.resize(aSkeleton->GetJointCount(), TRS{});
 
-		const Pose& currentFrame = m_frames.at(currentFrameIndex);
-		const Pose& nextFrame = m_frames.at(nextFrameIndex);
-
-		const auto& joints = aSkeleton->GetJoints();
-
-		if (currentFrame.localTRS.size() < joints.size())
-		{
-			return result;
-		}
-
-		for (size_t i = 0; i < joints.size(); i++)
-		{
-			const auto& currentLocalTransform = currentFrame.localTRS[i];
-			const auto& nextLocalTransform = nextFrame.localTRS[i];
-
-			// Blend
-			result[i].translation = glm::mix(currentLocalTransform.translation, nextLocalTransform.translation, blendValue);
-			result[i].rotation = glm::slerp(glm::normalize(currentLocalTransform.rotation), glm::normalize(nextLocalTransform.rotation), blendValue);
-			result[i].scale = glm::mix(currentLocalTransform.scale, nextLocalTransform.scale, blendValue);
-		}
-
+		// The result stays at the default pose if the frames have fewer joints than the skeleton
+		BlendFrames(static_cast<uint32_t>(currentFrameIndex), static_cast<uint32_t>(nextFrameIndex), blendValue, result);
 		return result;
 	}
 
@@ -336,7 +259,7 @@ namespace Volt
 		const float localTime = AnimationManager::globalClock - startTime;
 		const float normalizedTime = localTime / (m_duration / speed);
 
-		const int32_t frameCount = (int32_t)m_frames.size();
+		const int32_t frameCount = (int32_t)GetFrameCount();
 		const int32_t currentFrameIndex = (int32_t)(std::floor(normalizedTime * (float)frameCount)) % frameCount;
 
 		int32_t nextFrameIndex = currentFrameIndex + 1;
@@ -356,7 +279,7 @@ namespace Volt
 
 		const float normalizedWantedTime = time / (m_duration / speed);
 
-		const int32_t frameCount = (int32_t)m_frames.size();
+		const int32_t frameCount = (int32_t)GetFrameCount();
 		const int32_t currentFrameIndex = (int32_t)(std::floor(normalizedTime * (float)frameCount)) % frameCount;
 
 		const int32_t wantedFrame = (int32_t)(std::floor(normalizedWantedTime * (float)frameCount)) % frameCount;
@@ -376,7 +299,7 @@ namespace Volt
 		const float localTime = AnimationManager::globalClock - startTime;
 		const float normalizedTime = localTime / (m_duration / speed);
 
-		const int32_t frameCount = (int32_t)m_frames.size();
+		const int32_t frameCount = (int32_t)GetFrameCount();
 		const int32_t currentFrameIndex = (int32_t)(std::floor(normalizedTime * (float)frameCount)) % frameCount;
 		return currentFrameIndex;
 	}
@@ -397,6 +320,47 @@ namespace Volt
 		//return 0.0f;
 	}
 
+	const size_t Animation::GetFrameCount() const
+	{
+		return m_compressedClip ? m_compressedClip->GetFrameCount() : m_frames.size();
+	}
+
+	bool Animation::Compress(const AnimationCompressionSettings& settings)
+	{
+		VT_PROFILE_FUNCTION();
+
+		Ref<CompressedAnimationClip> compressedClip = CompressedAnimationClip::Compress(m_frames, settings);
+		if (!compressedClip)
+		{
+			return false;
+		}
+
+		m_compressedClip = compressedClip;
+
+		m_frames.clear();
+		m_frames.shrink_to_fit();
+
+		return true;
+	}
+
+	Vector<Animation::Pose> Animation::DecompressFrames() const
+	{
+		if (!m_compressedClip)
+		{
+			return m_frames;
+		}
+
+		Vector<Pose> frames(m_compressedClip->GetFrameCount());
+		for (uint32_t frameIndex = 0; auto& frame : frames)
+		{
+			frame.localTRS.resize(m_compressedClip->GetJointCount());
+			m_compressedClip->SampleFrames(frameIndex, frameIndex, 0.f, frame.localTRS);
+			frameIndex++;
+		}
+
+		return frames;
+	}
+
 	void Animation::AddEvent(const std::string& eventName, uint32_t frame)
 	{
 		m_events.emplace_back(frame, eventName);
@@ -419,7 +383,7 @@ namespace Volt
 	{
 		PoseData animData{};
 
-		const size_t frameCount = animation.m_frames.size();
+		const size_t frameCount = animation.GetFrameCount();
 
 		animData.currentFrameIndex = (size_t)std::floorf((float)frameCount * aNormalizedTime);
 		animData.nextFrameIndex = animData.currentFrameIndex + 1;
@@ -442,5 +406,32 @@ namespace Volt
 
 		return animData;
 	}
-}
 
+	bool Animation::BlendFrames(uint32_t currentFrameIndex, uint32_t nextFrameIndex, float blend, std::span<TRS> outLocalPose) const
+	{
+		if (m_compressedClip)
+		{
+			return m_compressedClip->SampleFrames(currentFrameIndex, nextFrameIndex, blend, outLocalPose);
+		}
+
+		const Pose& currentFrame = m_frames.at(currentFrameIndex);
+		const Pose& nextFrame = m_frames.at(nextFrameIndex);
+
+		if (currentFrame.localTRS.size() < outLocalPose.size() || nextFrame.localTRS.size() < outLocalPose.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < outLocalPose.size(); i++)
+		{
+			const auto& currentLocalTransform = currentFrame.localTRS[i];
+			const auto& nextLocalTransform = nextFrame.localTRS[i];
+
+			outLocalPose[i].translation = glm::mix(currentLocalTransform.translation, nextLocalTransform.translation, blend);
+			outLocalPose[i].rotation = glm::slerp(glm::normalize(currentLocalTransform.rotation), glm::normalize(nextLocalTransform.rotation), blend);
+			outLocalPose[i].scale = glm::mix(currentLocalTransform.scale, nextLocalTransform.scale, blend);
+		}
+
+		return true;
+	}
+}
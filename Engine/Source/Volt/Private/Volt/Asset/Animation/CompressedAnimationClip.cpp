@@ -0,0 +1,401 @@
+#include "vtpch.h"
+#include "Volt/Asset/Animation/CompressedAnimationClip.h"
+
+namespace Volt
+{
+	namespace Utility
+	{
+		// The three smallest components of a unit quaternion are all within this range
+		inline static constexpr float SMALLEST_THREE_RANGE = 0.70710678f;
+		inline static constexpr float SMALLEST_THREE_MAX_VALUE = 32767.f;
+		inline static constexpr float QUANTIZED_VECTOR_MAX_VALUE = 65535.f;
+
+		VT_INLINE glm::quat NLerp(const glm::quat& lhs, const glm::quat& rhs, float blend)
+		{
+			const glm::quat target = glm::dot(lhs, rhs) < 0.f ? -rhs : rhs;
+			return glm::normalize(lhs * (1.f - blend) + target * blend);
+		}
+
+		VT_INLINE float GetVectorError(const glm::vec3& lhs, const glm::vec3& rhs)
+		{
+			const glm::vec3 difference = glm::abs(lhs - rhs);
+			return std::max(difference.x, std::max(difference.y, difference.z));
+		}
+
+		VT_INLINE float GetRotationError(const glm::quat& lhs, const glm::quat& rhs)
+		{
+			const float cosHalfAngle = std::min(std::abs(glm::dot(lhs, rhs)), 1.f);
+			return 2.f * std::acos(cosHalfAngle);
+		}
+
+		void EncodeRotation(const glm::quat& rotation, uint16_t* outData)
+		{
+			const std::array<float, 4> components = { rotation.x, rotation.y, rotation.z, rotation.w };
+
+			uint32_t largestIndex = 0;
+			for (uint32_t i = 1; i < 4; i++)
+			{
+				if (std::abs(components[i]) > std::abs(components[largestIndex]))
+				{
+					largestIndex = i;
+				}
+			}
+
+			// q and -q are the same rotation, so the largest component is made positive and left out
+			const float sign = components[largestIndex] < 0.f ? -1.f : 1.f;
+
+			uint32_t writtenCount = 0;
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				if (i == largestIndex)
+				{
+					continue;
+				}
+
+				const float normalizedValue = std::clamp(components[i] * sign / SMALLEST_THREE_RANGE * 0.5f + 0.5f, 0.f, 1.f);
+				outData[writtenCount++] = static_cast<uint16_t>(std::round(normalizedValue * SMALLEST_THREE_MAX_VALUE));
+			}
+
+			// The index of the largest component is stored in the top bits of the first two values
+			outData[0] |= static_cast<uint16_t>((largestIndex & 1u) << 15);
+			outData[1] |= static_cast<uint16_t>((largestIndex >> 1u) << 15);
+		}
+
+		VT_INLINE glm::quat DecodeRotation(const uint16_t* data)
+		{
+			const uint32_t largestIndex = (data[0] >> 15) | ((data[1] >> 15) << 1);
+
+			std::array<float, 4> components{};
+			float sumOfSquares = 0.f;
+
+			uint32_t readCount = 0;
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				if (i == largestIndex)
+				{
+					continue;
+				}
+
+				const float normalizedValue = static_cast<float>(data[readCount++] & 0x7FFF) / SMALLEST_THREE_MAX_VALUE;
+				components[i] = (normalizedValue * 2.f - 1.f) * SMALLEST_THREE_RANGE;
+				sumOfSquares += components[i] * components[i];
+			}
+
+			components[largestIndex] = std::sqrt(std::max(1.f - sumOfSquares, 0.f));
+			return glm::quat{ components[3], components[0], components[1], components[2] };
+		}
+
+		// Greedily extends every segment for as long as linear interpolation between its end keys stays within the tolerance.
+		template<typename T, typename LerpFunc, typename ErrorFunc>
+		Vector<uint32_t> ReduceKeys(std::span<const T> values, float tolerance, LerpFunc&& lerpFunc, ErrorFunc&& errorFunc)
+		{
+			const uint32_t lastFrame = static_cast<uint32_t>(values.size() - 1);
+
+			Vector<uint32_t> keys;
+			keys.emplace_back(0);
+
+			uint32_t segmentStart = 0;
+			while (segmentStart < lastFrame)
+			{
+				uint32_t segmentEnd = segmentStart + 1;
+
+				const uint32_t maxSegmentEnd = std::min(lastFrame, segmentStart + CompressedAnimationClip::MAX_KEY_SPACING);
+				for (uint32_t candidateEnd = segmentStart + 2; candidateEnd <= maxSegmentEnd; candidateEnd++)
+				{
+					bool isWithinTolerance = true;
+					for (uint32_t frame = segmentStart + 1; frame < candidateEnd; frame++)
+					{
+						const float blend = static_cast<float>(frame - segmentStart) / static_cast<float>(candidateEnd - segmentStart);
+						if (errorFunc(lerpFunc(values[segmentStart], values[candidateEnd], blend), values[frame]) > tolerance)
+						{
+							isWithinTolerance = false;
+							break;
+						}
+					}
+
+					if (!isWithinTolerance)
+					{
+						break;
+					}
+
+					segmentEnd = candidateEnd;
+				}
+
+				keys.emplace_back(segmentEnd);
+				segmentStart = segmentEnd;
+			}
+
+			return keys;
+		}
+
+		template<typename T, typename ErrorFunc>
+		bool IsConstant(std::span<const T> values, float tolerance, ErrorFunc&& errorFunc)
+		{
+			for (const auto& value : values)
+			{
+				if (errorFunc(value, values.front()) > tolerance)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	Ref<CompressedAnimationClip> CompressedAnimationClip::Compress(std::span<const Animation::Pose> frames, const AnimationCompressionSettings& settings)
+	{
+		VT_PROFILE_FUNCTION();
+
+		if (frames.empty() || frames.size() > MAX_FRAME_COUNT)
+		{
+			return nullptr;
+		}
+
+		const uint32_t jointCount = static_cast<uint32_t>(frames.front().localTRS.size());
+		for (const auto& frame : frames)
+		{
+			if (frame.localTRS.size() != jointCount)
+			{
+				return nullptr;
+			}
+		}
+
+		Ref<CompressedAnimationClip> clip = CreateRef<CompressedAnimationClip>();
+		clip->m_frameCount = static_cast<uint32_t>(frames.size());
+		clip->m_jointCount = jointCount;
+		clip->m_tracks.reserve(jointCount * static_cast<uint32_t>(TrackType::Count));
+
+		Vector<glm::vec3> vectorValues(frames.size());
+		Vector<glm::quat> rotationValues(frames.size());
+
+		for (uint32_t jointIndex = 0; jointIndex < jointCount; jointIndex++)
+		{
+			for (size_t frame = 0; frame < frames.size(); frame++)
+			{
+				vectorValues[frame] = frames[frame].localTRS[jointIndex].translation;
+			}
+
+			clip->AddVectorTrack(vectorValues, settings.translationTolerance);
+
+			for (size_t frame = 0; frame < frames.size(); frame++)
+			{
+				glm::quat rotation = glm::normalize(frames[frame].localTRS[jointIndex].rotation);
+
+				// Keep neighbouring keys in the same hemisphere, so interpolating between them takes the short way
+				if (frame > 0 && glm::dot(rotationValues[frame - 1], rotation) < 0.f)
+				{
+					rotation = -rotation;
+				}
+
+				rotationValues[frame] = rotation;
+			}
+
+			clip->AddRotationTrack(rotationValues, settings.rotationTolerance);
+
+			for (size_t frame = 0; frame < frames.size(); frame++)
+			{
+				vectorValues[frame] = frames[frame].localTRS[jointIndex].scale;
+			}
+
+			clip->AddVectorTrack(vectorValues, settings.scaleTolerance);
+		}
+
+		return clip;
+	}
+
+	bool CompressedAnimationClip::SampleFrames(uint32_t currentFrame, uint32_t nextFrame, float blend, std::span<Animation::TRS> outLocalPose) const
+	{
+		if (outLocalPose.size() > m_jointCount)
+		{
+			return false;
+		}
+
+		// Keys sit on whole frames, so a point between two neighbouring frames can be sampled straight from the keys around it
+		const bool isSingleFrame = nextFrame == currentFrame;
+		if (isSingleFrame || (nextFrame == currentFrame + 1 && blend >= 0.f && blend <= 1.f))
+		{
+			const float frameTime = static_cast<float>(currentFrame) + (isSingleFrame ? 0.f : blend);
+
+			for (uint32_t jointIndex = 0; jointIndex < static_cast<uint32_t>(outLocalPose.size()); jointIndex++)
+			{
+				outLocalPose[jointIndex] = SampleJoint(jointIndex, frameTime);
+			}
+
+			return true;
+		}
+
+		for (uint32_t jointIndex = 0; jointIndex < static_cast<uint32_t>(outLocalPose.size()); jointIndex++)
+		{
+			const Animation::TRS currentTransform = SampleJoint(jointIndex, static_cast<float>(currentFrame));
+			const Animation::TRS nextTransform = SampleJoint(jointIndex, static_cast<float>(nextFrame));
+
+			outLocalPose[jointIndex].translation = glm::mix(currentTransform.translation, nextTransform.translation, blend);
+			outLocalPose[jointIndex].rotation = glm::slerp(currentTransform.rotation, nextTransform.rotation, blend);
+			outLocalPose[jointIndex].scale = glm::mix(currentTransform.scale, nextTransform.scale, blend);
+		}
+
+		return true;
+	}
+
+	size_t CompressedAnimationClip::GetMemorySize() const
+	{
+		return sizeof(Track) * m_tracks.size() + sizeof(uint16_t) * (m_keyFrames.size() + m_keyData.size());
+	}
+
+	void CompressedAnimationClip::Serialize(BinaryStreamWriter& streamWriter, const CompressedAnimationClip& data)
+	{
+		streamWriter.Write(data.m_frameCount);
+		streamWriter.Write(data.m_jointCount);
+		streamWriter.WriteRaw(data.m_tracks);
+		streamWriter.WriteRaw(data.m_keyFrames);
+		streamWriter.WriteRaw(data.m_keyData);
+	}
+
+	void CompressedAnimationClip::Deserialize(BinaryStreamReader& streamReader, CompressedAnimationClip& outData)
+	{
+		streamReader.Read(outData.m_frameCount);
+		streamReader.Read(outData.m_jointCount);
+		streamReader.ReadRaw(outData.m_tracks);
+		streamReader.ReadRaw(outData.m_keyFrames);
+		streamReader.ReadRaw(outData.m_keyData);
+	}
+
+	void CompressedAnimationClip::AddVectorTrack(std::span<const glm::vec3> values, float tolerance)
+	{
+		Track& track = m_tracks.emplace_back();
+		track.firstKey = static_cast<uint32_t>(m_keyFrames.size());
+		track.value = glm::vec4{ values.front(), 0.f };
+		track.rangeExtent = glm::vec3{ 0.f };
+
+		if (Utility::IsConstant(values, tolerance, Utility::GetVectorError))
+		{
+			track.keyCount = 1;
+			return;
+		}
+
+		const Vector<uint32_t> keys = Utility::ReduceKeys(values, tolerance, [](const glm::vec3& lhs, const glm::vec3& rhs, float blend)
+		{
+			return glm::mix(lhs, rhs, blend);
+		}, Utility::GetVectorError);
+
+		glm::vec3 rangeMin = values[keys.front()];
+		glm::vec3 rangeMax = rangeMin;
+
+		for (const uint32_t key : keys)
+		{
+			rangeMin = glm::min(rangeMin, values[key]);
+			rangeMax = glm::max(rangeMax, values[key]);
+		}
+
+		track.keyCount = static_cast<uint32_t>(keys.size());
+		track.value = glm::vec4{ rangeMin, 0.f };
+		track.rangeExtent = rangeMax - rangeMin;
+
+		for (const uint32_t key : keys)
+		{
+			m_keyFrames.emplace_back(static_cast<uint16_t>(key));
+
+			for (glm::length_t component = 0; component < 3; component++)
+			{
+				const float extent = track.rangeExtent[component];
+				const float normalizedValue = extent > 0.f ? (values[key][component] - rangeMin[component]) / extent : 0.f;
+
+				m_keyData.emplace_back(static_cast<uint16_t>(std::round(std::clamp(normalizedValue, 0.f, 1.f) * Utility::QUANTIZED_VECTOR_MAX_VALUE)));
+			}
+		}
+	}
+
+	void CompressedAnimationClip::AddRotationTrack(std::span<const glm::quat> values, float tolerance)
+	{
+		Track& track = m_tracks.emplace_back();
+		track.firstKey = static_cast<uint32_t>(m_keyFrames.size());
+		track.value = glm::vec4{ values.front().x, values.front().y, values.front().z, values.front().w };
+		track.rangeExtent = glm::vec3{ 0.f };
+
+		if (Utility::IsConstant(values, tolerance, Utility::GetRotationError))
+		{
+			track.keyCount = 1;
+			return;
+		}
+
+		const Vector<uint32_t> keys = Utility::ReduceKeys(values, tolerance, Utility::NLerp, Utility::GetRotationError);
+		track.keyCount = static_cast<uint32_t>(keys.size());
+
+		for (const uint32_t key : keys)
+		{
+			m_keyFrames.emplace_back(static_cast<uint16_t>(key));
+
+			const size_t dataOffset = m_keyData.size();
+			m_keyData.resize(dataOffset + 3);
+
+			Utility::EncodeRotation(values[key], &m_keyData[dataOffset]);
+		}
+	}
+
+	void CompressedAnimationClip::FindKeys(const Track& track, float frameTime, uint32_t& outKey, float& outBlend) const
+	{
+		const uint16_t* keyFrames = m_keyFrames.data() + track.firstKey;
+		const uint16_t* lastKeyFrame = keyFrames + track.keyCount - 1;
+
+		// The first key after the frame ends the segment, clamped so there is always a key on both sides
+		const uint16_t* segmentEnd = std::upper_bound(keyFrames + 1, lastKeyFrame, frameTime, [](float time, uint16_t keyFrame)
+		{
+			return time < static_cast<float>(keyFrame);
+		});
+
+		outKey = static_cast<uint32_t>(segmentEnd - keyFrames) - 1;
+
+		const float segmentStartTime = static_cast<float>(keyFrames[outKey]);
+		const float segmentEndTime = static_cast<float>(keyFrames[outKey + 1]);
+
+		outBlend = std::clamp((frameTime - segmentStartTime) / (segmentEndTime - segmentStartTime), 0.f, 1.f);
+	}
+
+	glm::vec3 CompressedAnimationClip::SampleVectorTrack(const Track& track, float frameTime) const
+	{
+		if (track.keyCount == 1)
+		{
+			return glm::vec3{ track.value };
+		}
+
+		uint32_t key = 0;
+		float blend = 0.f;
+		FindKeys(track, frameTime, key, blend);
+
+		const uint16_t* keyData = m_keyData.data() + static_cast<size_t>(track.firstKey + key) * 3;
+
+		const glm::vec3 rangeMin = glm::vec3{ track.value };
+		const glm::vec3 quantizationScale = track.rangeExtent / Utility::QUANTIZED_VECTOR_MAX_VALUE;
+
+		const glm::vec3 currentValue = rangeMin + glm::vec3{ keyData[0], keyData[1], keyData[2] } * quantizationScale;
+		const glm::vec3 nextValue = rangeMin + glm::vec3{ keyData[3], keyData[4], keyData[5] } * quantizationScale;
+
+		return glm::mix(currentValue, nextValue, blend);
+	}
+
+	glm::quat CompressedAnimationClip::SampleRotationTrack(const Track& track, float frameTime) const
+	{
+		if (track.keyCount == 1)
+		{
+			return glm::quat{ track.value.w, track.value.x, track.value.y, track.value.z };
+		}
+
+		uint32_t key = 0;
+		float blend = 0.f;
+		FindKeys(track, frameTime, key, blend);
+
+		const uint16_t* keyData = m_keyData.data() + static_cast<size_t>(track.firstKey + key) * 3;
+		return Utility::NLerp(Utility::DecodeRotation(keyData), Utility::DecodeRotation(keyData + 3), blend);
+	}
+
+	Animation::TRS CompressedAnimationClip::SampleJoint(uint32_t jointIndex, float frameTime) const
+	{
+		Animation::TRS result;
+		result.translation = SampleVectorTrack(GetTrack(jointIndex, TrackType::Translation), frameTime);
+		result.rotation = SampleRotationTrack(GetTrack(jointIndex, TrackType::Rotation), frameTime);
+		result.scale = SampleVectorTrack(GetTrack(jointIndex, TrackType::Scale), frameTime);
+
+		return result;
+	}
+}
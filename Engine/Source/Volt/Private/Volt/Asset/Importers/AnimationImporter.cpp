@@ -97,12 +97,13 @@ namespace Volt
 	void AnimationImporter::Save(const AssetMetadata& metadata, const Ref<Asset>& asset) const
 	{
 		Ref<Animation> animation = std::reinterpret_pointer_cast<Animation>(asset);
+		const Vector<Animation::Pose> frames = animation->DecompressFrames();
 
 		Vector<uint8_t> outData;
 
 		AnimationHeader header{};
-		header.perFrameTransformCount = (uint32_t)animation->m_frames.front().localTRS.size();
-		header.frameCount = (uint32_t)animation->m_frames.size();
+		header.perFrameTransformCount = (uint32_t)frames.front().localTRS.size();
+		header.frameCount = (uint32_t)frames.size();
 		header.duration = animation->m_duration;
 		header.framesPerSecond = animation->m_framesPerSecond;
 
@@ -116,7 +117,7 @@ namespace Volt
 		offset += sizeof(AnimationHeader);
 
 		// Copy matrices per frame
-		for (const auto& frame : animation->m_frames)
+		for (const auto& frame : frames)
 		{
 			memcpy_s(&outData[offset], header.perFrameTransformCount * sizeof(Animation::TRS), frame.localTRS.data(), header.perFrameTransformCount * sizeof(Animation::TRS));
 			offset += header.perFrameTransformCount * sizeof(Animation::TRS);
@@ -3,9 +3,35 @@
 
 #include <AssetSystem/AssetManager.h>
 #include "Volt/Asset/Animation/Animation.h"
+#include "Volt/Asset/Animation/CompressedAnimationClip.h"
 
 namespace Volt
 {
+	// Version 1 only stored the uncompressed frames
+	struct AnimationSerializationData_V1
+	{
+		float duration;
+		uint32_t framesPerSecond;
+		Vector<Animation::Pose> frames;
+		Vector<Animation::Event> events;
+
+		static void Serialize(BinaryStreamWriter& streamWriter, const AnimationSerializationData_V1& data)
+		{
+			streamWriter.Write(data.duration);
+			streamWriter.Write(data.framesPerSecond);
+			streamWriter.Write(data.frames);
+			streamWriter.Write(data.events);
+		}
+
+		static void Deserialize(BinaryStreamReader& streamReader, AnimationSerializationData_V1& outData)
+		{
+			streamReader.Read(outData.duration);
+			streamReader.Read(outData.framesPerSecond);
+			streamReader.Read(outData.frames);
+			streamReader.Read(outData.events);
+		}
+	};
+
 	struct AnimationSerializationData
 	{
 		float duration;
@@ -13,12 +39,22 @@ namespace Volt
 		Vector<Animation::Pose> frames;
 		Vector<Animation::Event> events;
 
+		// The frames are empty when the animation is compressed
+		bool isCompressed = false;
+		CompressedAnimationClip compressedClip;
+
 		static void Serialize(BinaryStreamWriter& streamWriter, const AnimationSerializationData& data)
 		{
 			streamWriter.Write(data.duration);
 			streamWriter.Write(data.framesPerSecond);
 			streamWriter.Write(data.frames);
 			streamWriter.Write(data.events);
+			streamWriter.Write(data.isCompressed);
+
+			if (data.isCompressed)
+			{
+				streamWriter.Write(data.compressedClip);
+			}
 		}
 
 		static void Deserialize(BinaryStreamReader& streamReader, AnimationSerializationData& outData)
@@ -27,6 +63,12 @@ namespace Volt
 			streamReader.Read(outData.framesPerSecond);
 			streamReader.Read(outData.frames);
 			streamReader.Read(outData.events);
+			streamReader.Read(outData.isCompressed);
+
+			if (outData.isCompressed)
+			{
+				streamReader.Read(outData.compressedClip);
+			}
 		}
 	};
 
@@ -41,6 +83,12 @@ namespace Volt
 		serializationData.framesPerSecond = animation->m_framesPerSecond;
 		serializationData.frames = animation->m_frames;
 		serializationData.events = animation->m_events;
+
+		if (animation->m_compressedClip)
+		{
+			serializationData.isCompressed = true;
+			serializationData.compressedClip = *animation->m_compressedClip;
+		}
 	
 		const size_t compressedDataOffset = AssetSerializer::WriteMetadata(metadata, asset->GetVersion(), streamWriter);
 		streamWriter.Write(serializationData);
@@ -70,18 +118,38 @@ namespace Volt
 		}
 
 		SerializedAssetMetadata serializedMetadata = AssetSerializer::ReadMetadata(streamReader);
+		Ref<Animation> animation = std::reinterpret_pointer_cast<Animation>(destinationAsset);
+
+		if (serializedMetadata.version == 1)
+		{
+			AnimationSerializationData_V1 serializationData{};
+			streamReader.Read(serializationData);
+
+			animation->m_duration = serializationData.duration;
+			animation->m_framesPerSecond = serializationData.framesPerSecond;
+			animation->m_frames = serializationData.frames;
+			animation->m_events = serializationData.events;
+
+			// Older animations are compressed on load, they get stored compressed the next time they are saved
+			animation->Compress(AnimationCompressionSettings{});
+			return true;
+		}
+
 		VT_ASSERT_MSG(serializedMetadata.version == destinationAsset->GetVersion(), "Incompatible version!");
 
 		AnimationSerializationData serializationData{};
 		streamReader.Read(serializationData);
 
-		Ref<Animation> animation = std::reinterpret_pointer_cast<Animation>(destinationAsset);
-
 		animation->m_duration = serializationData.duration;
 		animation->m_framesPerSecond = serializationData.framesPerSecond;
 		animation->m_frames = serializationData.frames;
 		animation->m_events = serializationData.events;
 
+		if (serializationData.isCompressed)
+		{
+			animation->m_compressedClip = CreateRef<CompressedAnimationClip>(std::move(serializationData.compressedClip));
+		}
+
 		return true;
 	}
 }
@@ -9,6 +9,26 @@
 
 namespace Volt
 {
+	namespace Utility
+	{
+		// Copies the array straight out of the stream data, instead of into a temporary first.
+		// Streamed and archived meshes are read from a mapping, so this is the only copy the data goes through on its way into the mesh.
+		template<typename T>
+		void ReadRawArray(BinaryStreamReader& streamReader, Vector<T>& outData)
+		{
+			Vector<T> fallbackStorage;
+			const std::span<const T> view = streamReader.ReadRawView(fallbackStorage);
+
+			if (!view.empty() && view.data() == fallbackStorage.data())
+			{
+				outData = std::move(fallbackStorage);
+				return;
+			}
+
+			outData.assign(view.begin(), view.end());
+		}
+	}
+
 	struct MeshSerializationData_V1
 	{
 		Vector<AssetHandle> materials;
@@ -75,13 +95,13 @@ namespace Volt
 
 		static void Deserialize(BinaryStreamReader& streamReader, MeshSerializationData_V2& outData)
 		{
-			streamReader.ReadRaw(outData.vertexPositions);
-			streamReader.ReadRaw(outData.vertexMaterialData);
-			streamReader.ReadRaw(outData.vertexAnimationInfo);
-			streamReader.ReadRaw(outData.vertexAnimationData);
-			streamReader.ReadRaw(outData.vertexBoneInfluences);
-			streamReader.ReadRaw(outData.vertexBoneWeights);
-			streamReader.ReadRaw(outData.indices);
+			Utility::ReadRawArray(streamReader, outData.vertexPositions);
+			Utility::ReadRawArray(streamReader, outData.vertexMaterialData);
+			Utility::ReadRawArray(streamReader, outData.vertexAnimationInfo);
+			Utility::ReadRawArray(streamReader, outData.vertexAnimationData);
+			Utility::ReadRawArray(streamReader, outData.vertexBoneInfluences);
+			Utility::ReadRawArray(streamReader, outData.vertexBoneWeights);
+			Utility::ReadRawArray(streamReader, outData.indices);
 			streamReader.ReadRaw(outData.materials);
 			streamReader.Read(outData.boundingSphereCenter);
 			streamReader.Read(outData.boundingSphereRadius);
@@ -134,7 +154,7 @@ namespace Volt
 			return false;
 		}
 
-		BinaryStreamReader streamReader{ filePath };
+		BinaryStreamReader streamReader{ filePath, StreamReadMode::MemoryMapped };
 
 		if (!streamReader.IsStreamValid())
 		{
@@ -176,16 +196,16 @@ namespace Volt
 				i++;
 			}
 
-			mesh->m_vertexContainer.positions = serializationData.vertexPositions;
-			mesh->m_vertexContainer.materialData = serializationData.vertexMaterialData;
-			mesh->m_vertexContainer.animationInfo = serializationData.vertexAnimationInfo;
-			mesh->m_vertexContainer.animationData = serializationData.vertexAnimationData;
-			mesh->m_vertexContainer.boneInfluences = serializationData.vertexBoneInfluences;
-			mesh->m_vertexContainer.boneWeights = serializationData.vertexBoneWeights;
-			mesh->m_indices = serializationData.indices;
+			mesh->m_vertexContainer.positions = std::move(serializationData.vertexPositions);
+			mesh->m_vertexContainer.materialData = std::move(serializationData.vertexMaterialData);
+			mesh->m_vertexContainer.animationInfo = std::move(serializationData.vertexAnimationInfo);
+			mesh->m_vertexContainer.animationData = std::move(serializationData.vertexAnimationData);
+			mesh->m_vertexContainer.boneInfluences = std::move(serializationData.vertexBoneInfluences);
+			mesh->m_vertexContainer.boneWeights = std::move(serializationData.vertexBoneWeights);
+			mesh->m_indices = std::move(serializationData.indices);
 			mesh->m_boundingSphere.center = serializationData.boundingSphereCenter;
 			mesh->m_boundingSphere.radius = serializationData.boundingSphereRadius;
-			mesh->m_subMeshes = serializationData.subMeshes;
+			mesh->m_subMeshes = std::move(serializationData.subMeshes);
 		}
 
 		for (auto& subMesh : mesh->m_subMeshes)
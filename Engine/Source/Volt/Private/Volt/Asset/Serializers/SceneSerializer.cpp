@@ -19,10 +19,23 @@
 #include <CoreUtilities/FileIO/YAMLMemoryStreamWriter.h>
 #include <CoreUtilities/FileIO/YAMLMemoryStreamReader.h>
 #include <CoreUtilities/FileSystem.h>
+#include <CoreUtilities/Math/Hash.h>
+
+#include <map>
+#include <unordered_set>
 
 namespace Volt
 {
 	static constexpr const char* ENTITY_FILE_EXTENSION = ".vtent";
+	static constexpr const char* COOKED_FILE_EXTENSION = ".vtcooked";
+	static constexpr const char* COOKED_DIRECTORY_NAME = "Cooked";
+
+	enum class CookedComponentStorage : uint8_t
+	{
+		// The whole component is a single raw column, and is copied straight into the entt storage.
+		WholeComponent = 0,
+		Members = 1
+	};
 
 	template<typename T>
 	void RegisterSerializationFunction(std::unordered_map<TypeTraits::TypeIndex, std::function<void(YAMLMemoryStreamWriter&, const uint8_t*, const size_t)>>& outTypes)
@@ -47,6 +60,24 @@ namespace Volt
 		};
 	}
 
+	template<typename T>
+	void RegisterCookedSerializationFunction(std::unordered_map<TypeTraits::TypeIndex, std::function<void(BinaryStreamWriter&, const uint8_t*)>>& outTypes)
+	{
+		outTypes[TypeTraits::TypeIndex::FromType<T>()] = [](BinaryStreamWriter& streamWriter, const uint8_t* data)
+		{
+			streamWriter.Write(*reinterpret_cast<const T*>(data));
+		};
+	}
+
+	template<typename T>
+	void RegisterCookedDeserializationFunction(std::unordered_map<TypeTraits::TypeIndex, std::function<void(BinaryStreamReader&, uint8_t*)>>& outTypes)
+	{
+		outTypes[TypeTraits::TypeIndex::FromType<T>()] = [](BinaryStreamReader& streamReader, uint8_t* data)
+		{
+			streamReader.Read(*reinterpret_cast<T*>(data));
+		};
+	}
+
 	SceneSerializer::SceneSerializer()
 	{
 		RegisterSerializationFunction<int8_t>(s_typeSerializers);
@@ -115,6 +146,26 @@ namespace Volt
 		RegisterDeserializationFunction<Volt::EntityID>(s_typeDeserializers);
 		RegisterDeserializationFunction<AssetHandle>(s_typeDeserializers);
 
+		// Trivially copyable members are cooked as raw bytes
+		RegisterCookedSerializationFunction<VoltGUID>(s_cookedTypeSerializers);
+		RegisterCookedSerializationFunction<std::string>(s_cookedTypeSerializers);
+
+		RegisterCookedDeserializationFunction<VoltGUID>(s_cookedTypeDeserializers);
+		RegisterCookedDeserializationFunction<std::string>(s_cookedTypeDeserializers);
+
+		s_cookedTypeSerializers[TypeTraits::TypeIndex::FromType<std::filesystem::path>()] = [](BinaryStreamWriter& streamWriter, const uint8_t* data)
+		{
+			streamWriter.Write(reinterpret_cast<const std::filesystem::path*>(data)->string());
+		};
+
+		s_cookedTypeDeserializers[TypeTraits::TypeIndex::FromType<std::filesystem::path>()] = [](BinaryStreamReader& streamReader, uint8_t* data)
+		{
+			std::string path;
+			streamReader.Read(path);
+
+			*reinterpret_cast<std::filesystem::path*>(data) = path;
+		};
+
 		s_instance = this;
 	}
 
@@ -172,6 +223,17 @@ namespace Volt
 		SerializeEntities(metadata, scene, directoryPath);
 	}
 
+	void SceneSerializer::CookScene(const AssetMetadata& metadata, const Ref<Scene>& scene) const
+	{
+		std::filesystem::path directoryPath = AssetManager::GetFilesystemPath(metadata.filePath);
+		if (!std::filesystem::is_directory(directoryPath))
+		{
+			directoryPath = directoryPath.parent_path();
+		}
+
+		CookEntities(scene, directoryPath);
+	}
+
 	bool SceneSerializer::Deserialize(const AssetMetadata& metadata, Ref<Asset> destinationAsset) const
 	{
 		Ref<Scene> scene = reinterpret_pointer_cast<Scene>(destinationAsset);
@@ -341,64 +403,40 @@ namespace Volt
 
 		});
 
-		if (scene->GetRegistry().any_of<VertexPaintedComponent>(entity))
-		{
-			std::filesystem::path vpPath = metadata.filePath.parent_path();
-			vpPath = ProjectManager::GetRootDirectory() / vpPath / "Layers" / ("ent_" + std::to_string((uint32_t)entityId) + ".entVp");
-
-			if (std::filesystem::exists(vpPath))
-			{
-				auto& vpComp = scene->GetRegistry().get<VertexPaintedComponent>(entity);
-
-				std::ifstream vpFile(vpPath, std::ios::in | std::ios::binary);
-				if (!vpFile.is_open())
-				{
-					VT_LOG(Error, "Could not open entVp file!");
-				}
-
-				Vector<uint8_t> totalData;
-				const size_t srcSize = vpFile.seekg(0, std::ios::end).tellg();
-				totalData.resize_uninitialized(srcSize);
-				vpFile.seekg(0, std::ios::beg);
-				vpFile.read(reinterpret_cast<char*>(totalData.data()), totalData.size());
-				vpFile.close();
-
-				memcpy_s(&vpComp.meshHandle, sizeof(vpComp.meshHandle), totalData.data() + totalData.size() - sizeof(vpComp.meshHandle), sizeof(vpComp.meshHandle));
-				totalData.resize_uninitialized(totalData.size() - sizeof(vpComp.meshHandle));
-
-				vpComp.vertexColors.reserve(totalData.size() / sizeof(uint32_t));
-				for (size_t offset = 0; offset < totalData.size(); offset += sizeof(uint32_t))
-				{
-					uint32_t vpColor;
-					memcpy_s(&vpColor, sizeof(uint32_t), totalData.data() + offset, sizeof(uint32_t));
-					vpComp.vertexColors.push_back(vpColor);
-				}
-			}
-		}
+		DeserializeVertexPaintData(scene, metadata, entity);
 
 		streamReader.ExitScope();
 	}
 
-	void SceneSerializer::LoadWorldCell(const Ref<Scene>& scene, const WorldCell& worldCell) const
+	void SceneSerializer::StageWorldCell(StagedWorldCell& stagedCell) const
 	{
 		VT_PROFILE_FUNCTION();
 
-		if (worldCell.isLoaded)
-		{
-			VT_LOG(Warning, "[SceneImporter]: World Cell is already loaded!");
-			return;
-		}
-
-		if (worldCell.cellEntities.empty())
+		if (stagedCell.cellEntities.empty())
 		{
 			VT_LOG(Warning, "[SceneImporter]: Unable to load World Cell which contains zero entities!");
 			return;
 		}
 
-		const auto& metadata = AssetManager::GetMetadataFromHandle(scene->handle);
+		const AssetMetadata& metadata = stagedCell.sceneMetadata;
 		const auto filePath = AssetManager::GetFilesystemPath(metadata.filePath);
 		const std::filesystem::path sceneDirectory = filePath.parent_path();
 
+		if (stagedCell.useCookedEntities)
+		{
+			Ref<Scene> stagingScene = CreateRef<Scene>();
+			if (LoadCookedWorldCell(stagingScene, metadata, stagedCell.cellId, sceneDirectory))
+			{
+				for (const auto& entity : stagingScene->GetAllEntities())
+				{
+					stagedCell.stagedEntities.emplace_back(0u, entity.GetID());
+				}
+
+				stagedCell.stagingScenes.emplace_back(stagingScene);
+				return;
+			}
+		}
+
 		std::filesystem::path layersFolderPath = sceneDirectory / "Entities";
 		if (!std::filesystem::exists(layersFolderPath))
 		{
@@ -415,15 +453,16 @@ namespace Volt
 			}
 		}
 
+		const std::unordered_set<EntityID> cellEntities{ stagedCell.cellEntities.begin(), stagedCell.cellEntities.end() };
+
 		for (int32_t i = static_cast<int32_t>(entityPaths.size()) - 1; i >= 0; i--)
 		{
 			const auto& path = entityPaths.at(i);
 
 			const std::string stem = path.stem().string();
 			uint32_t entityId = std::stoul(stem);
-			auto it = std::ranges::find(worldCell.cellEntities, EntityID(entityId));
 
-			if (it == worldCell.cellEntities.end())
+			if (!cellEntities.contains(EntityID(entityId)))
 			{
 				entityPaths.erase(entityPaths.begin() + i);
 			}
@@ -476,6 +515,7 @@ namespace Volt
 		},
 		static_cast<uint32_t>(entityPaths.size()));
 
+		// The staging scenes are merged into the scene on the main thread, see WorldEngine::Update
 		for (const auto& dummyScene : dummyScenes)
 		{
 			if (!dummyScene)
@@ -483,13 +523,13 @@ namespace Volt
 				continue;
 			}
 
+			const uint32_t stagingSceneIndex = static_cast<uint32_t>(stagedCell.stagingScenes.size());
 			for (const auto& entity : dummyScene->GetAllEntities())
 			{
-				Entity realEntity = scene->CreateEntityWithID(entity.GetID());
-				Entity::Copy(entity, realEntity, Volt::EntityCopyFlags::None);
-
-				scene->InvalidateEntityTransform(realEntity.GetID());
+				stagedCell.stagedEntities.emplace_back(stagingSceneIndex, entity.GetID());
 			}
+
+			stagedCell.stagingScenes.emplace_back(dummyScene);
 		}
 	}
 
@@ -571,6 +611,11 @@ namespace Volt
 
 	void SceneSerializer::LoadCellEntities(const AssetMetadata& metadata, const Ref<Scene>& scene, const std::filesystem::path& sceneDirectory) const
 	{
+		if (LoadCookedCellEntities(scene, sceneDirectory))
+		{
+			return;
+		}
+
 		std::filesystem::path layersFolderPath = sceneDirectory / "Entities";
 		if (!std::filesystem::exists(layersFolderPath))
 		{
@@ -656,6 +701,403 @@ namespace Volt
 		}
 	}
 
+	void SceneSerializer::CookEntities(const Ref<Scene>& scene, const std::filesystem::path& sceneDirectory) const
+	{
+		VT_PROFILE_FUNCTION();
+
+		const std::filesystem::path cookedDirectory = sceneDirectory / COOKED_DIRECTORY_NAME;
+
+		// Cooking needs every entity in memory, so partially streamed scenes only keep the entity files up to date.
+		for (const auto& cell : scene->m_worldEngine.GetCells())
+		{
+			if (cell.state != WorldCellState::Loaded && !cell.cellEntities.empty())
+			{
+				VT_LOG(Info, "[SceneSerializer]: Not all cells are loaded, skipping cooking of scene {0}!", scene->m_name);
+				scene->m_hasCookedEntities = false;
+				return;
+			}
+		}
+
+		std::filesystem::create_directories(cookedDirectory);
+
+		auto& registry = scene->GetRegistry();
+
+		struct CookedComponentType
+		{
+			const IComponentTypeDesc* componentDesc = nullptr;
+			entt::sparse_set* storage = nullptr;
+
+			Vector<CookedMember> members;
+			bool isWholeComponent = false;
+		};
+
+		Vector<CookedComponentType> componentTypes;
+		for (auto&& curr : registry.storage())
+		{
+			auto& storage = curr.second;
+			if (storage.empty())
+			{
+				continue;
+			}
+
+			const IComponentTypeDesc* componentDesc = reinterpret_cast<const IComponentTypeDesc*>(GetComponentRegistry().GetTypeDescFromName(storage.type().name()));
+			if (!componentDesc)
+			{
+				continue;
+			}
+
+			auto& componentType = componentTypes.emplace_back();
+			componentType.componentDesc = componentDesc;
+			componentType.storage = &storage;
+
+			GetCookedMembers(componentDesc, 0, componentType.members);
+			componentType.isWholeComponent = CanCookWholeComponent(componentDesc, componentType.members);
+		}
+
+		// Same cell assignment as the entity files
+		std::map<WorldCellID, Vector<Entity>> cellEntities;
+		for (const auto& entity : scene->GetAllEntities())
+		{
+			WorldCellID cellId = scene->m_worldEngine.GetCellIDFromEntity(entity);
+			if (cellId == INVALID_WORLD_CELL_ID)
+			{
+				cellId = 0;
+			}
+
+			cellEntities[cellId].emplace_back(entity);
+		}
+
+		// Cell table
+		{
+			BinaryStreamWriter streamWriter{};
+			streamWriter.Write(COOKED_MAGIC_VAL);
+			streamWriter.Write(COOKED_VERSION);
+
+			streamWriter.Write(static_cast<uint32_t>(componentTypes.size()));
+			for (const auto& componentType : componentTypes)
+			{
+				streamWriter.Write(componentType.componentDesc->GetGUID());
+				streamWriter.Write(static_cast<uint64_t>(GetCookedLayoutHash(componentType.componentDesc)));
+			}
+
+			streamWriter.Write(static_cast<uint32_t>(cellEntities.size()));
+			for (const auto& [cellId, entities] : cellEntities)
+			{
+				Vector<EntityID> entityIds;
+				entityIds.reserve(entities.size());
+
+				for (const auto& entity : entities)
+				{
+					entityIds.emplace_back(entity.GetID());
+				}
+
+				streamWriter.Write(cellId);
+				streamWriter.WriteRaw(entityIds);
+			}
+
+			streamWriter.WriteToDisk(cookedDirectory / (std::string("Cells") + COOKED_FILE_EXTENSION), CompressionCodec::DeflateHigh, 0);
+		}
+
+		Vector<std::pair<WorldCellID, const Vector<Entity>*>> cells;
+		for (const auto& [cellId, entities] : cellEntities)
+		{
+			cells.emplace_back(cellId, &entities);
+		}
+
+		// The registry is only read from here on, so the cells are written in parallel
+		Algo::ForEachParallel([&cells, &componentTypes, cookedDirectory, this](uint32_t threadIdx, uint32_t i)
+		{
+			const auto& [cellId, entities] = cells.at(i);
+
+			BinaryStreamWriter streamWriter{};
+			streamWriter.Write(COOKED_MAGIC_VAL);
+			streamWriter.Write(COOKED_VERSION);
+
+			Vector<EntityID> entityIds;
+			entityIds.reserve(entities->size());
+
+			for (const auto& entity : *entities)
+			{
+				entityIds.emplace_back(entity.GetID());
+			}
+
+			streamWriter.WriteRaw(entityIds);
+
+			Vector<std::pair<const CookedComponentType*, Vector<uint32_t>>> cellComponentTypes;
+			for (const auto& componentType : componentTypes)
+			{
+				Vector<uint32_t> entityIndices;
+				for (uint32_t entityIndex = 0; entityIndex < static_cast<uint32_t>(entities->size()); entityIndex++)
+				{
+					if (componentType.storage->contains(entities->at(entityIndex)))
+					{
+						entityIndices.emplace_back(entityIndex);
+					}
+				}
+
+				if (!entityIndices.empty())
+				{
+					cellComponentTypes.emplace_back(&componentType, std::move(entityIndices));
+				}
+			}
+
+			streamWriter.Write(static_cast<uint32_t>(cellComponentTypes.size()));
+
+			for (const auto& [componentType, entityIndices] : cellComponentTypes)
+			{
+				Vector<const uint8_t*> components;
+				components.reserve(entityIndices.size());
+
+				for (const auto& entityIndex : entityIndices)
+				{
+					components.emplace_back(reinterpret_cast<const uint8_t*>(componentType->storage->get(entities->at(entityIndex))));
+				}
+
+				const CookedComponentStorage storageType = componentType->isWholeComponent ? CookedComponentStorage::WholeComponent : CookedComponentStorage::Members;
+
+				streamWriter.Write(componentType->componentDesc->GetGUID());
+				streamWriter.Write(storageType);
+				streamWriter.WriteRaw(entityIndices);
+
+				if (storageType == CookedComponentStorage::WholeComponent)
+				{
+					const size_t componentSize = componentType->componentDesc->GetSize();
+
+					Vector<uint8_t> column;
+					column.resize_uninitialized(components.size() * componentSize);
+
+					for (size_t componentIndex = 0; componentIndex < components.size(); componentIndex++)
+					{
+						memcpy_s(&column[componentIndex * componentSize], componentSize, components[componentIndex], componentSize);
+					}
+
+					streamWriter.WriteRaw(column);
+				}
+				else
+				{
+					SerializeCookedColumns(components, componentType->members, streamWriter);
+				}
+			}
+
+			streamWriter.WriteToDisk(cookedDirectory / ("Cell_" + std::to_string(cellId) + COOKED_FILE_EXTENSION), CompressionCodec::DeflateHigh, 0);
+		},
+		static_cast<uint32_t>(cells.size()));
+
+		// Cell files are overwritten in place, only the ones of cells that no longer exist are removed
+		for (const auto& it : std::filesystem::directory_iterator(cookedDirectory))
+		{
+			const std::string fileName = it.path().stem().string();
+			if (it.is_directory() || it.path().extension().string() != COOKED_FILE_EXTENSION || !fileName.starts_with("Cell_"))
+			{
+				continue;
+			}
+
+			const bool isCellCooked = std::any_of(cells.begin(), cells.end(), [&](const auto& cell) 
+			{
+				return fileName == "Cell_" + std::to_string(cell.first);
+			});
+
+			if (!isCellCooked)
+			{
+				std::error_code errorCode{};
+				std::filesystem::remove(it.path(), errorCode);
+			}
+		}
+
+		scene->m_hasCookedEntities = true;
+
+		VT_LOG(Info, "[SceneSerializer]: Cooked {0} cells!", cells.size());
+	}
+
+	bool SceneSerializer::LoadCookedCellEntities(const Ref<Scene>& scene, const std::filesystem::path& sceneDirectory) const
+	{
+		VT_PROFILE_FUNCTION();
+
+		scene->m_hasCookedEntities = false;
+
+		const std::filesystem::path cellTablePath = sceneDirectory / COOKED_DIRECTORY_NAME / (std::string("Cells") + COOKED_FILE_EXTENSION);
+		if (!std::filesystem::exists(cellTablePath))
+		{
+			return false;
+		}
+
+		// The entity files are the source data, so any entity saved after the cook makes the cooked data stale.
+		const auto cookedWriteTime = std::filesystem::last_write_time(cellTablePath);
+
+		const std::filesystem::path entitiesDirectoryPath = sceneDirectory / "Entities";
+		if (std::filesystem::exists(entitiesDirectoryPath))
+		{
+			for (const auto& it : std::filesystem::directory_iterator(entitiesDirectoryPath))
+			{
+				if (!it.is_directory() && it.path().extension().string() == ENTITY_FILE_EXTENSION && it.last_write_time() > cookedWriteTime)
+				{
+					VT_LOG(Warning, "[SceneSerializer]: Cooked entities of scene {0} are out of date, loading entity files!", scene->m_name);
+					return false;
+				}
+			}
+		}
+
+		BinaryStreamReader streamReader{ cellTablePath };
+		if (!streamReader.IsStreamValid())
+		{
+			return false;
+		}
+
+		uint32_t magicVal = 0;
+		uint32_t version = 0;
+		streamReader.Read(magicVal);
+		streamReader.Read(version);
+
+		if (magicVal != COOKED_MAGIC_VAL || version != COOKED_VERSION)
+		{
+			VT_LOG(Warning, "[SceneSerializer]: Cooked entities of scene {0} have an unsupported version, loading entity files!", scene->m_name);
+			return false;
+		}
+
+		uint32_t componentTypeCount = 0;
+		streamReader.Read(componentTypeCount);
+
+		for (uint32_t i = 0; i < componentTypeCount; i++)
+		{
+			VoltGUID componentGuid = VoltGUID::Null();
+			uint64_t layoutHash = 0;
+
+			streamReader.Read(componentGuid);
+			streamReader.Read(layoutHash);
+
+			const ICommonTypeDesc* typeDesc = GetComponentRegistry().GetTypeDescFromGUID(componentGuid);
+			if (!typeDesc || typeDesc->GetValueType() != ValueType::Component || GetCookedLayoutHash(reinterpret_cast<const IComponentTypeDesc*>(typeDesc)) != layoutHash)
+			{
+				VT_LOG(Warning, "[SceneSerializer]: Cooked entities of scene {0} were cooked with different components, loading entity files!", scene->m_name);
+				return false;
+			}
+		}
+
+		uint32_t cellCount = 0;
+		streamReader.Read(cellCount);
+
+		auto& worldEngine = scene->m_worldEngine;
+		for (uint32_t i = 0; i < cellCount; i++)
+		{
+			WorldCellID cellId = 0;
+			Vector<EntityID> entityIds;
+
+			streamReader.Read(cellId);
+			streamReader.ReadRaw(entityIds);
+
+			worldEngine.AddEntitiesToCell(cellId, entityIds);
+		}
+
+		scene->m_hasCookedEntities = true;
+		return true;
+	}
+
+	bool SceneSerializer::LoadCookedWorldCell(const Ref<Scene>& scene, const AssetMetadata& metadata, WorldCellID cellId, const std::filesystem::path& sceneDirectory) const
+	{
+		VT_PROFILE_FUNCTION();
+
+		const std::filesystem::path cellPath = sceneDirectory / COOKED_DIRECTORY_NAME / ("Cell_" + std::to_string(cellId) + COOKED_FILE_EXTENSION);
+		if (!std::filesystem::exists(cellPath))
+		{
+			return false;
+		}
+
+		BinaryStreamReader streamReader{ cellPath };
+		if (!streamReader.IsStreamValid())
+		{
+			return false;
+		}
+
+		uint32_t magicVal = 0;
+		uint32_t version = 0;
+		streamReader.Read(magicVal);
+		streamReader.Read(version);
+
+		if (magicVal != COOKED_MAGIC_VAL || version != COOKED_VERSION)
+		{
+			VT_LOG(Error, "[SceneSerializer]: File {0} is not a valid cooked cell!", cellPath);
+			return false;
+		}
+
+		Vector<EntityID> entityIds;
+		streamReader.ReadRaw(entityIds);
+
+		auto& registry = scene->GetRegistry();
+
+		Vector<entt::entity> entityHandles;
+		entityHandles.reserve(entityIds.size());
+
+		for (const auto& entity : scene->CreateEntitiesWithIDs(entityIds))
+		{
+			entityHandles.emplace_back(entity.GetHandle());
+		}
+
+		uint32_t componentTypeCount = 0;
+		streamReader.Read(componentTypeCount);
+
+		Vector<std::pair<const IComponentTypeDesc*, Vector<uint32_t>>> loadedComponents;
+		loadedComponents.reserve(componentTypeCount);
+
+		Vector<entt::entity> componentEntities;
+		Vector<void*> components;
+		Vector<uint8_t> wholeComponents;
+
+		for (uint32_t i = 0; i < componentTypeCount; i++)
+		{
+			VoltGUID componentGuid = VoltGUID::Null();
+			CookedComponentStorage storageType = CookedComponentStorage::Members;
+			Vector<uint32_t> entityIndices;
+
+			streamReader.Read(componentGuid);
+			streamReader.Read(storageType);
+			streamReader.ReadRaw(entityIndices);
+
+			// The layouts have been validated against the cell table
+			const IComponentTypeDesc* componentDesc = reinterpret_cast<const IComponentTypeDesc*>(GetComponentRegistry().GetTypeDescFromGUID(componentGuid));
+			VT_ENSURE(componentDesc);
+
+			componentEntities.clear();
+			for (const auto& entityIndex : entityIndices)
+			{
+				componentEntities.emplace_back(entityHandles.at(entityIndex));
+			}
+
+			if (storageType == CookedComponentStorage::WholeComponent)
+			{
+				streamReader.ReadRaw(wholeComponents);
+				ComponentRegistry::Helpers::InsertComponentsWithGUID(componentGuid, registry, componentEntities, wholeComponents.data());
+			}
+			else
+			{
+				components.resize(componentEntities.size());
+				ComponentRegistry::Helpers::GetOrAddComponentsWithGUID(componentGuid, registry, componentEntities, components);
+
+				Vector<CookedMember> members;
+				GetCookedMembers(componentDesc, 0, members);
+
+				DeserializeCookedColumns({ reinterpret_cast<uint8_t* const*>(components.data()), components.size() }, members, streamReader);
+			}
+
+			loadedComponents.emplace_back(componentDesc, std::move(entityIndices));
+		}
+
+		// Same callback as deserializing the entity files
+		for (const auto& [componentDesc, entityIndices] : loadedComponents)
+		{
+			for (const auto& entityIndex : entityIndices)
+			{
+				componentDesc->OnComponentDeserialized(scene->GetEntityHelperFromEntityID(entityIds.at(entityIndex)));
+			}
+		}
+
+		for (size_t i = 0; i < entityIds.size(); i++)
+		{
+			DeserializeVertexPaintData(scene, metadata, Entity{ entityHandles.at(i), scene });
+		}
+
+		return true;
+	}
+
 	Entity SceneSerializer::CreateEntityFromUUIDThreadSafe(EntityID entityId, const Ref<Scene>& scene) const
 	{
 		static std::mutex createEntityMutex;
@@ -664,6 +1106,46 @@ namespace Volt
 		return scene->CreateEntityWithID(entityId);
 	}
 	
+	void SceneSerializer::DeserializeVertexPaintData(const Ref<Scene>& scene, const AssetMetadata& metadata, Entity entity) const
+	{
+		if (!scene->GetRegistry().any_of<VertexPaintedComponent>(entity))
+		{
+			return;
+		}
+
+		std::filesystem::path vpPath = metadata.filePath.parent_path();
+		vpPath = ProjectManager::GetRootDirectory() / vpPath / "Layers" / ("ent_" + std::to_string((uint32_t)entity.GetID()) + ".entVp");
+
+		if (std::filesystem::exists(vpPath))
+		{
+			auto& vpComp = scene->GetRegistry().get<VertexPaintedComponent>(entity);
+
+			std::ifstream vpFile(vpPath, std::ios::in | std::ios::binary);
+			if (!vpFile.is_open())
+			{
+				VT_LOG(Error, "Could not open entVp file!");
+			}
+
+			Vector<uint8_t> totalData;
+			const size_t srcSize = vpFile.seekg(0, std::ios::end).tellg();
+			totalData.resize_uninitialized(srcSize);
+			vpFile.seekg(0, std::ios::beg);
+			vpFile.read(reinterpret_cast<char*>(totalData.data()), totalData.size());
+			vpFile.close();
+
+			memcpy_s(&vpComp.meshHandle, sizeof(vpComp.meshHandle), totalData.data() + totalData.size() - sizeof(vpComp.meshHandle), sizeof(vpComp.meshHandle));
+			totalData.resize_uninitialized(totalData.size() - sizeof(vpComp.meshHandle));
+
+			vpComp.vertexColors.reserve(totalData.size() / sizeof(uint32_t));
+			for (size_t offset = 0; offset < totalData.size(); offset += sizeof(uint32_t))
+			{
+				uint32_t vpColor;
+				memcpy_s(&vpColor, sizeof(uint32_t), totalData.data() + offset, sizeof(uint32_t));
+				vpComp.vertexColors.push_back(vpColor);
+			}
+		}
+	}
+
 	void SceneSerializer::SerializeClass(const uint8_t* data, const size_t offset, const IComponentTypeDesc* compDesc, YAMLMemoryStreamWriter& streamWriter, bool isSubComponent) const
 	{
 		if (!isSubComponent)
@@ -881,4 +1363,330 @@ namespace Volt
 			arrayDesc->DestroyElement(tempDataStorage);
 		});
 	}
+
+	void SceneSerializer::GetCookedMembers(const IComponentTypeDesc* compDesc, const size_t offset, Vector<CookedMember>& outMembers) const
+	{
+		for (const auto& member : compDesc->GetMembers())
+		{
+			if ((member.flags & ComponentMemberFlag::NoSerialize) != ComponentMemberFlag::None)
+			{
+				continue;
+			}
+
+			const size_t memberOffset = offset + member.offset;
+
+			if (member.typeDesc != nullptr)
+			{
+				switch (member.typeDesc->GetValueType())
+				{
+					case ValueType::Component:
+						GetCookedMembers(reinterpret_cast<const IComponentTypeDesc*>(member.typeDesc), memberOffset, outMembers);
+						break;
+
+					case ValueType::Enum:
+						outMembers.emplace_back(&member, memberOffset, true);
+						break;
+
+					case ValueType::Array:
+						outMembers.emplace_back(&member, memberOffset, false);
+						break;
+				}
+			}
+			else if (member.isTriviallyCopyable)
+			{
+				outMembers.emplace_back(&member, memberOffset, true);
+			}
+			else if (s_cookedTypeSerializers.contains(member.typeIndex))
+			{
+				outMembers.emplace_back(&member, memberOffset, false);
+			}
+		}
+	}
+
+	size_t SceneSerializer::GetCookedLayoutHash(const IComponentTypeDesc* compDesc) const
+	{
+		Vector<CookedMember> members;
+		GetCookedMembers(compDesc, 0, members);
+
+		size_t hash = std::hash<size_t>()(compDesc->GetSize());
+		for (const auto& cookedMember : members)
+		{
+			const ComponentMember& member = *cookedMember.member;
+
+			hash = Math::HashCombine(hash, std::hash<std::string_view>()(member.name));
+			hash = Math::HashCombine(hash, std::hash<size_t>()(cookedMember.offset));
+			hash = Math::HashCombine(hash, std::hash<size_t>()(member.size));
+			hash = Math::HashCombine(hash, std::hash<bool>()(cookedMember.isRaw));
+
+			if (member.typeDesc && member.typeDesc->GetValueType() == ValueType::Array)
+			{
+				const IArrayTypeDesc* arrayDesc = reinterpret_cast<const IArrayTypeDesc*>(member.typeDesc);
+				hash = Math::HashCombine(hash, std::hash<size_t>()(arrayDesc->GetElementTypeSize()));
+
+				const ICommonTypeDesc* elementDesc = arrayDesc->GetElementTypeDesc();
+				if (elementDesc && elementDesc->GetValueType() == ValueType::Component)
+				{
+					hash = Math::HashCombine(hash, GetCookedLayoutHash(reinterpret_cast<const IComponentTypeDesc*>(elementDesc)));
+				}
+			}
+		}
+
+		return hash;
+	}
+
+	bool SceneSerializer::CanCookWholeComponent(const IComponentTypeDesc* compDesc, const Vector<CookedMember>& members) const
+	{
+		if (!compDesc->IsTriviallyCopyable())
+		{
+			return false;
+		}
+
+		// Every byte of the component has to be a serialized member, otherwise unreflected members would be loaded as well.
+		size_t memberSize = 0;
+		for (const auto& cookedMember : members)
+		{
+			if (!cookedMember.isRaw)
+			{
+				return false;
+			}
+
+			memberSize += cookedMember.member->size;
+		}
+
+		return memberSize == compDesc->GetSize();
+	}
+
+	void SceneSerializer::SerializeCookedColumns(std::span<const uint8_t* const> objects, const Vector<CookedMember>& members, BinaryStreamWriter& streamWriter) const
+	{
+		Vector<uint8_t> column;
+
+		for (const auto& cookedMember : members)
+		{
+			const ComponentMember& member = *cookedMember.member;
+
+			if (cookedMember.isRaw)
+			{
+				column.resize_uninitialized(objects.size() * member.size);
+				for (size_t i = 0; i < objects.size(); i++)
+				{
+					memcpy_s(&column[i * member.size], member.size, objects[i] + cookedMember.offset, member.size);
+				}
+
+				streamWriter.WriteRaw(column);
+			}
+			else if (member.typeDesc && member.typeDesc->GetValueType() == ValueType::Array)
+			{
+				const IArrayTypeDesc* arrayDesc = reinterpret_cast<const IArrayTypeDesc*>(member.typeDesc);
+				for (const auto& object : objects)
+				{
+					SerializeCookedArray(object + cookedMember.offset, arrayDesc, streamWriter);
+				}
+			}
+			else
+			{
+				const auto& serializer = s_cookedTypeSerializers.at(member.typeIndex);
+				for (const auto& object : objects)
+				{
+					serializer(streamWriter, object + cookedMember.offset);
+				}
+			}
+		}
+	}
+
+	void SceneSerializer::SerializeCookedArray(const void* arrayPtr, const IArrayTypeDesc* arrayDesc, BinaryStreamWriter& streamWriter) const
+	{
+		const ICommonTypeDesc* elementDesc = arrayDesc->GetElementTypeDesc();
+		const ValueType elementValueType = elementDesc ? elementDesc->GetValueType() : ValueType::Default;
+
+		const auto& elementTypeIndex = arrayDesc->GetElementTypeIndex();
+		const bool isRawElement = elementValueType == ValueType::Enum || (elementValueType == ValueType::Default && arrayDesc->IsElementTriviallyCopyable());
+
+		if (elementValueType == ValueType::Default && !isRawElement && !s_cookedTypeSerializers.contains(elementTypeIndex))
+		{
+			streamWriter.Write(uint32_t(0));
+			return;
+		}
+
+		const uint32_t elementCount = static_cast<uint32_t>(arrayDesc->Size(arrayPtr));
+		streamWriter.Write(elementCount);
+
+		if (elementCount == 0)
+		{
+			return;
+		}
+
+		if (isRawElement)
+		{
+			const size_t elementSize = arrayDesc->GetElementTypeSize();
+
+			Vector<uint8_t> column;
+			column.resize_uninitialized(elementCount * elementSize);
+
+			for (uint32_t i = 0; i < elementCount; i++)
+			{
+				memcpy_s(&column[i * elementSize], elementSize, arrayDesc->At(arrayPtr, i), elementSize);
+			}
+
+			streamWriter.WriteRaw(column);
+			return;
+		}
+
+		switch (elementValueType)
+		{
+			case ValueType::Component:
+			{
+				Vector<const uint8_t*> elements;
+				elements.reserve(elementCount);
+
+				for (uint32_t i = 0; i < elementCount; i++)
+				{
+					elements.emplace_back(reinterpret_cast<const uint8_t*>(arrayDesc->At(arrayPtr, i)));
+				}
+
+				Vector<CookedMember> elementMembers;
+				GetCookedMembers(reinterpret_cast<const IComponentTypeDesc*>(elementDesc), 0, elementMembers);
+
+				SerializeCookedColumns(elements, elementMembers, streamWriter);
+				break;
+			}
+
+			case ValueType::Array:
+			{
+				for (uint32_t i = 0; i < elementCount; i++)
+				{
+					SerializeCookedArray(arrayDesc->At(arrayPtr, i), reinterpret_cast<const IArrayTypeDesc*>(elementDesc), streamWriter);
+				}
+				break;
+			}
+
+			default:
+			{
+				const auto& serializer = s_cookedTypeSerializers.at(elementTypeIndex);
+				for (uint32_t i = 0; i < elementCount; i++)
+				{
+					serializer(streamWriter, reinterpret_cast<const uint8_t*>(arrayDesc->At(arrayPtr, i)));
+				}
+				break;
+			}
+		}
+	}
+
+	void SceneSerializer::DeserializeCookedColumns(std::span<uint8_t* const> objects, const Vector<CookedMember>& members, BinaryStreamReader& streamReader) const
+	{
+		Vector<uint8_t> fallbackStorage;
+
+		for (const auto& cookedMember : members)
+		{
+			const ComponentMember& member = *cookedMember.member;
+
+			if (cookedMember.isRaw)
+			{
+				const std::span<const uint8_t> column = streamReader.ReadRawView(fallbackStorage);
+				VT_ENSURE(column.size() == objects.size() * member.size);
+
+				for (size_t i = 0; i < objects.size(); i++)
+				{
+					memcpy_s(objects[i] + cookedMember.offset, member.size, &column[i * member.size], member.size);
+				}
+			}
+			else if (member.typeDesc && member.typeDesc->GetValueType() == ValueType::Array)
+			{
+				const IArrayTypeDesc* arrayDesc = reinterpret_cast<const IArrayTypeDesc*>(member.typeDesc);
+				for (const auto& object : objects)
+				{
+					DeserializeCookedArray(object + cookedMember.offset, arrayDesc, streamReader);
+				}
+			}
+			else
+			{
+				const auto& deserializer = s_cookedTypeDeserializers.at(member.typeIndex);
+				for (const auto& object : objects)
+				{
+					deserializer(streamReader, object + cookedMember.offset);
+				}
+			}
+		}
+	}
+
+	void SceneSerializer::DeserializeCookedArray(void* arrayPtr, const IArrayTypeDesc* arrayDesc, BinaryStreamReader& streamReader) const
+	{
+		// The cooked array replaces the default value of the member
+		while (arrayDesc->Size(arrayPtr) > 0)
+		{
+			arrayDesc->Erase(arrayPtr, arrayDesc->Size(arrayPtr) - 1);
+		}
+
+		uint32_t elementCount = 0;
+		streamReader.Read(elementCount);
+
+		if (elementCount == 0)
+		{
+			return;
+		}
+
+		for (uint32_t i = 0; i < elementCount; i++)
+		{
+			arrayDesc->EmplaceBack(arrayPtr, nullptr);
+		}
+
+		const ICommonTypeDesc* elementDesc = arrayDesc->GetElementTypeDesc();
+		const ValueType elementValueType = elementDesc ? elementDesc->GetValueType() : ValueType::Default;
+
+		const bool isRawElement = elementValueType == ValueType::Enum || (elementValueType == ValueType::Default && arrayDesc->IsElementTriviallyCopyable());
+
+		if (isRawElement)
+		{
+			const size_t elementSize = arrayDesc->GetElementTypeSize();
+
+			Vector<uint8_t> fallbackStorage;
+			const std::span<const uint8_t> column = streamReader.ReadRawView(fallbackStorage);
+			VT_ENSURE(column.size() == elementCount * elementSize);
+
+			for (uint32_t i = 0; i < elementCount; i++)
+			{
+				memcpy_s(arrayDesc->At(arrayPtr, i), elementSize, &column[i * elementSize], elementSize);
+			}
+
+			return;
+		}
+
+		switch (elementValueType)
+		{
+			case ValueType::Component:
+			{
+				Vector<uint8_t*> elements;
+				elements.reserve(elementCount);
+
+				for (uint32_t i = 0; i < elementCount; i++)
+				{
+					elements.emplace_back(reinterpret_cast<uint8_t*>(arrayDesc->At(arrayPtr, i)));
+				}
+
+				Vector<CookedMember> elementMembers;
+				GetCookedMembers(reinterpret_cast<const IComponentTypeDesc*>(elementDesc), 0, elementMembers);
+
+				DeserializeCookedColumns(elements, elementMembers, streamReader);
+				break;
+			}
+
+			case ValueType::Array:
+			{
+				for (uint32_t i = 0; i < elementCount; i++)
+				{
+					DeserializeCookedArray(arrayDesc->At(arrayPtr, i), reinterpret_cast<const IArrayTypeDesc*>(elementDesc), streamReader);
+				}
+				break;
+			}
+
+			default:
+			{
+				const auto& deserializer = s_cookedTypeDeserializers.at(arrayDesc->GetElementTypeIndex());
+				for (uint32_t i = 0; i < elementCount; i++)
+				{
+					deserializer(streamReader, reinterpret_cast<uint8_t*>(arrayDesc->At(arrayPtr, i)));
+				}
+				break;
+			}
+		}
+	}
 }
@@ -5,6 +5,7 @@
 #include "Volt/Asset/Mesh/Mesh.h"
 #include "Volt/Asset/Rendering/Material.h"
 #include "Volt/Asset/Animation/Skeleton.h"
+#include "Volt/Asset/Animation/CompressedAnimationClip.h"
 
 #include "Volt/Rendering/Mesh/MeshCommon.h"
 
@@ -680,6 +681,11 @@ namespace Volt
 			localFrameCounter++;
 		}
 
+		if (!voltAnimation->Compress(AnimationCompressionSettings{}))
+		{
+			userData.OnWarning(std::format("The FBX anim stack {} could not be compressed, its frames are stored uncompressed", animStackName.Buffer()));
+		}
+
 		return voltAnimation;
 	}
 
@@ -58,7 +58,11 @@ namespace Volt
 
 	void RegisterModule(ECSBuilder& builder)
 	{
-		builder.GetGameLoop(GameLoop::Variable).RegisterSystem(CommonSystem);
+		// None of the core systems touch anything but their own components and the cached world transforms.
+		// Systems that move entities must be registered with SetIsExclusive(true).
+		builder.GetGameLoop(GameLoop::Variable).SetParallelExecutionEnabled(true);
+
+		builder.GetGameLoop(GameLoop::Variable).RegisterSystem(CommonSystem).SetIsParallelSafe(true);
 		builder.GetGameLoop(GameLoop::Variable).RegisterSystem(CameraSystem);
 		builder.GetGameLoop(GameLoop::Variable).RegisterSystem(MotionWeaveSystem);
 	}
@@ -29,10 +29,10 @@ namespace Volt::MosaicNodes
 
 		for (const auto& edgeId : underlyingNode.GetInputEdges())
 		{
-			const auto edge = underlyingNode.GetEdgeFromID(edgeId);
+			const auto edge = m_graph->GetUnderlyingGraph().GetEdgeFromID(edgeId);
 			const uint32_t paramIndex = edge.metaDataType->GetParameterInputIndex();
 		
-			const auto& node = underlyingNode.GetNodeFromID(edge.startNode);
+			const auto& node = m_graph->GetUnderlyingGraph().GetNodeFromID(edge.startNode);
 			const Mosaic::ResultInfo info = node.nodeData->GetShaderCode(node, edge.metaDataType->GetParameterOutputIndex(), appendableShaderString);
 
 			if (paramIndex == 0)
@@ -85,10 +85,10 @@ namespace Volt::MosaicNodes
 
 		for (const auto& edgeId : underlyingNode.GetInputEdges())
 		{
-			const auto edge = underlyingNode.GetEdgeFromID(edgeId);
+			const auto edge = m_graph->GetUnderlyingGraph().GetEdgeFromID(edgeId);
 			const uint32_t paramIndex = edge.metaDataType->GetParameterInputIndex();
 
-			const auto& node = underlyingNode.GetNodeFromID(edge.startNode);
+			const auto& node = m_graph->GetUnderlyingGraph().GetNodeFromID(edge.startNode);
 			const Mosaic::ResultInfo info = node.nodeData->GetShaderCode(node, edge.metaDataType->GetParameterOutputIndex(), appendableShaderString);
 
 			if (paramIndex == 0)
@@ -0,0 +1,72 @@
+#include "vtpch.h"
+#include "Volt/Particles/Particle.h"
+
+#include "Volt/Asset/ParticlePreset.h"
+
+#include <CoreUtilities/Math/SIMD.h>
+
+namespace Volt
+{
+	void ParticlePresetSimulationData::CopyFrom(const ParticlePreset& preset)
+	{
+		texture = preset.texture;
+
+		// Assigning reuses the existing allocations
+		colors = preset.colors;
+		sizes = preset.sizes;
+
+		gravity = preset.gravity;
+		startVelocity = preset.startVelocity;
+		endVelocity = preset.endVelocity;
+	}
+
+	void ParticleStorage::Resize(uint32_t capacity)
+	{
+		m_capacity = capacity;
+		m_aliveCount = std::min(m_aliveCount, capacity);
+
+		const uint32_t paddedCapacity = SIMD::AlignToWidth(capacity);
+
+		for (auto& stream : m_streams)
+		{
+			stream.resize(paddedCapacity, 0.f);
+		}
+
+		m_colors.resize(paddedCapacity);
+		m_sizes.resize(paddedCapacity);
+	}
+
+	void ParticleStorage::Clear()
+	{
+		m_aliveCount = 0;
+	}
+
+	uint32_t ParticleStorage::Spawn()
+	{
+		if (m_aliveCount >= m_capacity)
+		{
+			return INVALID_PARTICLE;
+		}
+
+		return m_aliveCount++;
+	}
+
+	void ParticleStorage::Kill(uint32_t index)
+	{
+		VT_ENSURE(index < m_aliveCount);
+
+		const uint32_t lastIndex = --m_aliveCount;
+		if (index == lastIndex)
+		{
+			return;
+		}
+
+		for (auto& stream : m_streams)
+		{
+			stream[index] = stream[lastIndex];
+		}
+
+		m_colors[index] = m_colors[lastIndex];
+		m_sizes[index] = m_sizes[lastIndex];
+	}
+}
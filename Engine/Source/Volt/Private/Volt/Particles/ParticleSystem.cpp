@@ -18,46 +18,91 @@
 #include <AssetSystem/AssetManager.h>
 #include <AssetSystem/Asset.h>
 
-#include <JobSystem/TaskGraph.h>
+#include <JobSystem/JobSystem.h>
 
 #include <CoreUtilities/Random.h>
+#include <CoreUtilities/Math/SIMD.h>
 
 #include <yaml-cpp/yaml.h>
 #include <fstream>
 #include <filesystem>
 #include <random>
 
+namespace Volt::Utility
+{
+	// Keys are evenly spaced over the life time, and blended linearly.
+	template<typename T>
+	void SampleParticleCurve(const Vector<T>& keys, const float* normalizedAges, uint32_t count, Vector<T>& outValues)
+	{
+		if (keys.empty())
+		{
+			return;
+		}
+
+		const uint32_t lastKey = static_cast<uint32_t>(keys.size() - 1);
+		const float keyScale = static_cast<float>(lastKey);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const float scaledTime = normalizedAges[i] * keyScale;
+			const uint32_t key = std::min(static_cast<uint32_t>(scaledTime), lastKey);
+			const uint32_t nextKey = std::min(key + 1, lastKey);
+
+			outValues[i] = glm::mix(keys[key], keys[nextKey], scaledTime - static_cast<float>(key));
+		}
+	}
+}
+
 void Volt::ParticleSystem::Update(entt::registry& registry, Weak<Scene> scene, const float deltaTime)
 {
 	VT_PROFILE_FUNCTION();
 
 	std::set<entt::entity> emittersAliveThisFrame;
+	std::unordered_set<AssetHandle> presetsUsedThisFrame;
 	
 	auto view = registry.view<ParticleEmitterComponent, TransformComponent>();
 	view.each([&](const entt::entity id, ParticleEmitterComponent& particleEmitterComponent, TransformComponent& transformComp) 
 	{
 		if (particleEmitterComponent.preset == Asset::Null())
 		{
-			m_particleStorage[id].particles.resize(0);
-			m_particleStorage[id].numberOfAliveParticles = 0;
+			m_particleStorage[id].particles.Resize(0);
 			return;
 		}
 		Ref<ParticlePreset> preset = AssetManager::GetAsset<ParticlePreset>(particleEmitterComponent.preset);
 		if (preset != nullptr)
 		{
+			auto& particleStorage = m_particleStorage[id];
+
 			if (particleEmitterComponent.preset != particleEmitterComponent.currentPreset)
 			{
 				particleEmitterComponent.currentPreset = particleEmitterComponent.preset;
 
-				for (auto& p : m_particleStorage[id].particles)
-					p.dead = true;
-
-				m_particleStorage[id].particles.resize(10000);
-				m_particleStorage[id].numberOfAliveParticles = 0;
-				m_particleStorage[id].preset = particleEmitterComponent.currentPreset;
+				particleStorage.particles.Clear();
+				particleStorage.preset = particleEmitterComponent.currentPreset;
 				particleEmitterComponent.emissionTimer = preset->emittionTime;
 				particleEmitterComponent.internalTimer = 0;
 			}
+
+			// The pool follows the preset, which can be edited while the emitter is running
+			const uint32_t maxAliveParticleCount = preset->GetMaxAliveParticleCount();
+			if (particleStorage.particles.GetCapacity() != maxAliveParticleCount)
+			{
+				particleStorage.particles.Resize(maxAliveParticleCount);
+			}
+
+			auto& simulationData = m_presetSimulationData[particleEmitterComponent.preset];
+			if (presetsUsedThisFrame.insert(particleEmitterComponent.preset).second)
+			{
+				if (!simulationData)
+				{
+					simulationData = CreateRef<ParticlePresetSimulationData>();
+				}
+
+				simulationData->CopyFrom(*preset);
+			}
+
+			particleStorage.simulationData = simulationData;
+
 			emittersAliveThisFrame.insert(id);
 			particleEmitterComponent.isLooping = preset->isLooping;
 			Volt::Entity ent = { id, scene };
@@ -77,65 +122,56 @@ void Volt::ParticleSystem::Update(entt::registry& registry, Weak<Scene> scene, c
 					}
 					if (!preset->isBurst || particleEmitterComponent.burstTimer < 0)
 					{
-						SendParticles(particleEmitterComponent, id, ent.GetPosition(), 1 / preset->intensity);
+						SendParticles(particleEmitterComponent, particleStorage, *preset, ent.GetPosition(), 1 / preset->intensity);
 					}
 				}
 			}
 		}
 	});
 
+	// Emitters which are still fading out keep their own reference to the data
+	std::erase_if(m_presetSimulationData, [&](const auto& presetData)
+	{
+		return !presetsUsedThisFrame.contains(presetData.first);
+	});
+
 	Vector<entt::entity> emittersToRemove{};
-	Vector<std::future<void>> futures{};
 	std::mutex emittersToRemoveMutex;
 
-	TaskGraph taskGraph{};
+	Vector<std::pair<entt::entity, ParticleSystemInternalStorage*>> emitters{};
+	emitters.reserve(m_particleStorage.size());
 
 	for (auto& [id, particleStorage] : m_particleStorage)
 	{
-		taskGraph.AddTask([&]() 
-		{
-			VT_PROFILE_SCOPE("Update particle system");
+		emitters.emplace_back(id, &particleStorage);
+	}
 
-			Entity entity{ id, scene };
-			if (!entity)
-			{
-				std::scoped_lock lock{ emittersToRemoveMutex };
-				emittersToRemove.emplace_back(id);
-				return;
-			}
+	JobSystem::ParallelFor(emitters.size(), [&](size_t emitterIndex)
+	{
+		VT_PROFILE_SCOPE("Update particle system");
 
-			const auto forward = entity.GetForward();
+		const entt::entity id = emitters[emitterIndex].first;
+		ParticleSystemInternalStorage& particleStorage = *emitters[emitterIndex].second;
 
-			Vector<Particle>& p_vec = particleStorage.particles;
-			for (int index = 0; index < particleStorage.numberOfAliveParticles; index++)
-			{
-				Particle& p = p_vec[index];
+		Entity entity{ id, scene };
+		if (!entity)
+		{
+			std::scoped_lock lock{ emittersToRemoveMutex };
+			emittersToRemove.emplace_back(id);
+			return;
+		}
 
-				if (ParticleKillCheck(p, deltaTime))
-				{
-					std::swap(p, p_vec[particleStorage.numberOfAliveParticles - 1]);
-					particleStorage.numberOfAliveParticles--;
-					continue;
-				}
+		SimulateParticles(particleStorage, entity.GetForward(), deltaTime);
 
-				ParticlePositionUpdate(p, deltaTime, forward);
-				ParticleSizeUpdate(p, deltaTime);
-				ParticleVelocityUpdate(p, deltaTime);
-				ParticleColorUpdate(p, deltaTime);
-				ParticleTimeUpdate(p, deltaTime);
-			}
-			if (particleStorage.numberOfAliveParticles == 0)
+		if (particleStorage.particles.GetAliveCount() == 0)
+		{
+			if (!emittersAliveThisFrame.contains(id))
 			{
-				if (!emittersAliveThisFrame.contains(id))
-				{
-					std::scoped_lock lock{ emittersToRemoveMutex };
-					emittersToRemove.emplace_back(id);
-				}
+				std::scoped_lock lock{ emittersToRemoveMutex };
+				emittersToRemove.emplace_back(id);
 			}
-		});
-	}
-
-	taskGraph.ExecuteAndWait();
+		}
+	});
 
 	for (const auto& emitter : emittersToRemove)
 	{
@@ -143,143 +179,161 @@ void Volt::ParticleSystem::Update(entt::registry& registry, Weak<Scene> scene, c
 	}
 }
 
-void Volt::ParticleSystem::SendParticles(ParticleEmitterComponent& particleEmitterComponent, entt::entity id, glm::vec3 aEntityPos, const float& intencity)
+void Volt::ParticleSystem::SendParticles(ParticleEmitterComponent& particleEmitterComponent, ParticleSystemInternalStorage& particleStorage, const ParticlePreset& preset, glm::vec3 aEntityPos, float intencity)
 {
-	auto e = AssetManager::GetAsset<ParticlePreset>(particleEmitterComponent.preset);
+	if (preset.colors.empty() || preset.sizes.empty())
+	{
+		return;
+	}
+
+	ParticleStorage& particles = particleStorage.particles;
+
 	while (particleEmitterComponent.internalTimer > 0)
 	{
-		if (m_particleStorage[id].particles.size() <= m_particleStorage[id].numberOfAliveParticles || e->colors.empty())
+		const uint32_t index = particles.Spawn();
+		if (index == ParticleStorage::INVALID_PARTICLE)
+		{
 			return;
-
-		auto& p = m_particleStorage[id].particles[m_particleStorage[id].numberOfAliveParticles];
+		}
 
 		glm::vec3 dir = { 0.f, 1.f, 0.f };
-		float radius = e->sphereRadius;
-		if (e->shape == 0)
+		glm::vec3 position = aEntityPos;
+
+		float radius = preset.sphereRadius;
+		if (preset.shape == 0)
 		{
 			// #mmax: make different starting patterns <func>
-			if (e->sphereSpawnOnEdge)
+			dir = glm::normalize(glm::vec3{ Random::Float(-radius, radius), Random::Float(-radius, radius), Random::Float(-radius, radius) });
+
+			if (preset.sphereSpawnOnEdge)
 			{
-				dir = glm::normalize(glm::vec3{ Random::Float(-radius, radius), Random::Float(-radius, radius), Random::Float(-radius, radius) });
-				p.position = aEntityPos + dir * radius;
+				position = aEntityPos + dir * radius;
 			}
 			else
 			{
-				dir = glm::normalize(glm::vec3{ Random::Float(-radius, radius), Random::Float(-radius, radius), Random::Float(-radius, radius) });
-				p.position = aEntityPos + dir * Random::Float(0, radius);
+				position = aEntityPos + dir * Random::Float(0, radius);
 			}
 		}
 
-		p.dead = false;
-		p.direction = dir;
+		const float lifeTime = Random::Float(preset.minLifeTime, (preset.minLifeTime >= preset.maxLifeTime) ? preset.minLifeTime : preset.maxLifeTime);
 
-		p.lifeTime = Random::Float(e->minLifeTime, (e->minLifeTime >= e->maxLifeTime) ? e->minLifeTime : e->maxLifeTime);
-		p.totalLifeTime = p.lifeTime;
+		particles.GetStream(ParticleStream::PositionX)[index] = position.x;
+		particles.GetStream(ParticleStream::PositionY)[index] = position.y;
+		particles.GetStream(ParticleStream::PositionZ)[index] = position.z;
 
-		p.colors = e->colors;
-		p.color = e->colors[0];
-		p.texture = e->texture;
+		particles.GetStream(ParticleStream::DirectionX)[index] = dir.x;
+		particles.GetStream(ParticleStream::DirectionY)[index] = dir.y;
+		particles.GetStream(ParticleStream::DirectionZ)[index] = dir.z;
 
-		p.sizes = e->sizes;
-		p.size = e->sizes[0];
-		p.rotation = { Random::Float(0, 6.28318531f), Random::Float(0, 6.28318531f), Random::Float(0, 6.28318531f) };
+		particles.GetStream(ParticleStream::RotationX)[index] = Random::Float(0, 6.28318531f);
+		particles.GetStream(ParticleStream::RotationY)[index] = Random::Float(0, 6.28318531f);
+		particles.GetStream(ParticleStream::RotationZ)[index] = Random::Float(0, 6.28318531f);
 
-		p.velocity = e->startVelocity;
-		p.startVelocity = p.velocity;
-		p.endVelocity = e->endVelocity;
-		p.gravity = e->gravity;
+		particles.GetStream(ParticleStream::Velocity)[index] = preset.startVelocity;
+		particles.GetStream(ParticleStream::LifeTime)[index] = lifeTime;
+		particles.GetStream(ParticleStream::TotalLifeTime)[index] = lifeTime;
+		particles.GetStream(ParticleStream::Distance)[index] = 0.f;
+		particles.GetStream(ParticleStream::RandomValue)[index] = Random::Float(0.f, 1.f);
+		particles.GetStream(ParticleStream::TimeSinceSpawn)[index] = 0.f;
+		particles.GetStream(ParticleStream::NormalizedAge)[index] = 0.f;
 
-		p.randomValue = Random::Float(0.f, 1.f);
-		p.timeSinceSpawn = 0.f;
+		particles.GetColors()[index] = preset.colors[0];
+		particles.GetSizes()[index] = preset.sizes[0];
 
-		m_particleStorage[id].numberOfAliveParticles++;
 		particleEmitterComponent.internalTimer -= intencity;
 	}
 }
 
-bool Volt::ParticleSystem::ParticleKillCheck(Particle& particle, const float& deltaTime)
+void Volt::ParticleSystem::SimulateParticles(ParticleSystemInternalStorage& particleStorage, const glm::vec3& entityForward, float deltaTime)
 {
-	if (particle.lifeTime <= 0)
+	ParticleStorage& particles = particleStorage.particles;
+
+	// Particles are killed the frame after their life time runs out
+	const float* lifeTimes = particles.GetStream(ParticleStream::LifeTime);
+	for (uint32_t index = 0; index < particles.GetAliveCount();)
 	{
-		particle.dead = true;
+		if (lifeTimes[index] <= 0.f)
+		{
+			particles.Kill(index);
+			continue;
+		}
+
+		index++;
 	}
-	else
+
+	const uint32_t aliveCount = particles.GetAliveCount();
+	if (aliveCount == 0)
 	{
-		particle.lifeTime -= deltaTime;
+		return;
 	}
-	return particle.dead;
-}
-
-void Volt::ParticleSystem::ParticlePositionUpdate(Particle& particle, const float& deltaTime, const glm::vec3& entityForward)
-{
-	const glm::vec3 dir = glm::normalize(entityForward + particle.direction);
-
-	particle.position += particle.velocity * dir * deltaTime;
-	particle.distance += particle.velocity * deltaTime;
-	particle.direction += particle.gravity * deltaTime;
-}
-
-void Volt::ParticleSystem::ParticleSizeUpdate(Particle& particle, const float&)
-{
-	float sizePersentage = (particle.totalLifeTime - particle.lifeTime) / particle.totalLifeTime;
-	if (sizePersentage > 1)
-		sizePersentage = 1;
-	float scaledTime = sizePersentage * ((float)particle.sizes.size() - 1);
-	//glm::vec4 colorArray[3] = { particle.startColor, particle.middleColor, particle.endColor };
-	glm::vec4 oldSize = glm::vec4{ particle.sizes[(int)scaledTime], 0.f };
-	auto newScaled = (int)(scaledTime + 1.0f);
-	glm::vec4 newSize = glm::vec4{ particle.sizes[(newScaled >= particle.sizes.size()) ? particle.sizes.size() - 1 : newScaled], 1.f };
-	float newT = scaledTime - (int)(scaledTime);
-
-	float x = glm::mix(oldSize.x, newSize.x, newT);
-	float y = glm::mix(oldSize.y, newSize.y, newT);
-	float z = glm::mix(oldSize.z, newSize.z, newT);
-
-	particle.size = glm::vec3{ x,y,z };
-
-	//float w = glm::mix(oldColor.w, newColor.w, newT);
-
-
-	/*float sizePersentage = (particle.totalLifeTime - particle.lifeTime) / particle.totalLifeTime;
-	glm::vec3 newSize = glm::mix(particle.startSize, particle.endSize, sizePersentage);
-
-	particle.size = newSize;*/
-}
-
-void Volt::ParticleSystem::ParticleVelocityUpdate(Particle& particle, const float&)
-{
-	float velocityPersentage = (particle.totalLifeTime - particle.lifeTime) / particle.totalLifeTime;
-	float newVelocity = glm::mix(particle.startVelocity, particle.endVelocity, velocityPersentage);
 
-	particle.velocity = newVelocity;
-}
-
-
-void Volt::ParticleSystem::ParticleColorUpdate(Particle& particle, const float&)
-{
-	float colorPersentage = (particle.totalLifeTime - particle.lifeTime) / particle.totalLifeTime;
-	if (colorPersentage > 1)
-		colorPersentage = 1;
-	float scaledTime = colorPersentage * ((float)particle.colors.size() - 1);
-	//glm::vec4 colorArray[3] = { particle.startColor, particle.middleColor, particle.endColor };
-	glm::vec4 oldColor = particle.colors[(int)scaledTime];
-	auto newScaled = (int)(scaledTime + 1.0f);
-	glm::vec4 newColor = particle.colors[(newScaled >= particle.colors.size()) ? particle.colors.size() - 1 : newScaled];
-	float newT = scaledTime - (int)(scaledTime);
-
-	float x = glm::mix(oldColor.x, newColor.x, newT);
-	float y = glm::mix(oldColor.y, newColor.y, newT);
-	float z = glm::mix(oldColor.z, newColor.z, newT);
-	float w = glm::mix(oldColor.w, newColor.w, newT);
-
-	particle.color = glm::vec4{ x,y,z,w };
-}
-
-void Volt::ParticleSystem::ParticleTimeUpdate(Particle& particle, float deltaTime)
-{
-	particle.timeSinceSpawn += deltaTime;
-}
+	const ParticlePresetSimulationData& simulationData = *particleStorage.simulationData;
+
+	float* positionX = particles.GetStream(ParticleStream::PositionX);
+	float* positionY = particles.GetStream(ParticleStream::PositionY);
+	float* positionZ = particles.GetStream(ParticleStream::PositionZ);
+	float* directionX = particles.GetStream(ParticleStream::DirectionX);
+	float* directionY = particles.GetStream(ParticleStream::DirectionY);
+	float* directionZ = particles.GetStream(ParticleStream::DirectionZ);
+	float* velocities = particles.GetStream(ParticleStream::Velocity);
+	float* lifeTimeStream = particles.GetStream(ParticleStream::LifeTime);
+	float* totalLifeTimes = particles.GetStream(ParticleStream::TotalLifeTime);
+	float* distances = particles.GetStream(ParticleStream::Distance);
+	float* timesSinceSpawn = particles.GetStream(ParticleStream::TimeSinceSpawn);
+	float* normalizedAges = particles.GetStream(ParticleStream::NormalizedAge);
+
+	const SIMD::FloatV zero = SIMD::Set(0.f);
+	const SIMD::FloatV one = SIMD::Set(1.f);
+	const SIMD::FloatV dt = SIMD::Set(deltaTime);
+
+	const SIMD::FloatV forwardX = SIMD::Set(entityForward.x);
+	const SIMD::FloatV forwardY = SIMD::Set(entityForward.y);
+	const SIMD::FloatV forwardZ = SIMD::Set(entityForward.z);
+
+	const SIMD::FloatV gravityStepX = SIMD::Set(simulationData.gravity.x * deltaTime);
+	const SIMD::FloatV gravityStepY = SIMD::Set(simulationData.gravity.y * deltaTime);
+	const SIMD::FloatV gravityStepZ = SIMD::Set(simulationData.gravity.z * deltaTime);
+
+	const SIMD::FloatV startVelocity = SIMD::Set(simulationData.startVelocity);
+	const SIMD::FloatV velocityRange = SIMD::Set(simulationData.endVelocity - simulationData.startVelocity);
+
+	// The streams are padded, so the last register may update dead slots, which are overwritten on spawn
+	for (uint32_t i = 0; i < aliveCount; i += SIMD::Width)
+	{
+		const SIMD::FloatV lifeTime = SIMD::Sub(SIMD::Load(lifeTimeStream + i), dt);
+		const SIMD::FloatV totalLifeTime = SIMD::Load(totalLifeTimes + i);
+		const SIMD::FloatV lifePercentage = SIMD::Div(SIMD::Sub(totalLifeTime, lifeTime), totalLifeTime);
+
+		SIMD::Store(lifeTimeStream + i, lifeTime);
+		SIMD::Store(timesSinceSpawn + i, SIMD::Add(SIMD::Load(timesSinceSpawn + i), dt));
+
+		// Particles move along the emitter forward, bent by their own direction
+		const SIMD::FloatV dirX = SIMD::Load(directionX + i);
+		const SIMD::FloatV dirY = SIMD::Load(directionY + i);
+		const SIMD::FloatV dirZ = SIMD::Load(directionZ + i);
+
+		const SIMD::FloatV moveX = SIMD::Add(forwardX, dirX);
+		const SIMD::FloatV moveY = SIMD::Add(forwardY, dirY);
+		const SIMD::FloatV moveZ = SIMD::Add(forwardZ, dirZ);
+		const SIMD::FloatV moveLength = SIMD::Sqrt(SIMD::MulAdd(moveX, moveX, SIMD::MulAdd(moveY, moveY, SIMD::Mul(moveZ, moveZ))));
+
+		const SIMD::FloatV velocity = SIMD::Load(velocities + i);
+		const SIMD::FloatV travelled = SIMD::Mul(velocity, dt);
+		const SIMD::FloatV step = SIMD::Div(travelled, moveLength);
+
+		SIMD::Store(positionX + i, SIMD::MulAdd(moveX, step, SIMD::Load(positionX + i)));
+		SIMD::Store(positionY + i, SIMD::MulAdd(moveY, step, SIMD::Load(positionY + i)));
+		SIMD::Store(positionZ + i, SIMD::MulAdd(moveZ, step, SIMD::Load(positionZ + i)));
+		SIMD::Store(distances + i, SIMD::Add(SIMD::Load(distances + i), travelled));
+
+		SIMD::Store(directionX + i, SIMD::Add(dirX, gravityStepX));
+		SIMD::Store(directionY + i, SIMD::Add(dirY, gravityStepY));
+		SIMD::Store(directionZ + i, SIMD::Add(dirZ, gravityStepZ));
+
+		SIMD::Store(velocities + i, SIMD::MulAdd(velocityRange, lifePercentage, startVelocity));
+		SIMD::Store(normalizedAges + i, SIMD::Clamp(lifePercentage, zero, one));
+	}
 
-void Volt::ParticleSystem::UpdateParticles(ParticleEmitterComponent&, TransformComponent&, const float&)
-{
+	Utility::SampleParticleCurve(simulationData.sizes, normalizedAges, aliveCount, particles.GetSizes());
+	Utility::SampleParticleCurve(simulationData.colors, normalizedAges, aliveCount, particles.GetColors());
 }
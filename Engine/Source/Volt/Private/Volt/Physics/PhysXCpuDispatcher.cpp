@@ -0,0 +1,29 @@
+#include "vtpch.h"
+#include "Volt/Physics/PhysXCpuDispatcher.h"
+
+#include <JobSystem/JobSystem.h>
+
+#include <PhysX/task/PxTask.h>
+
+namespace Volt
+{
+	void PhysXCpuDispatcher::submitTask(physx::PxBaseTask& task)
+	{
+		physx::PxBaseTask* taskPtr = &task;
+
+		JobSystem::CreateAndRunJob([taskPtr]()
+		{
+			VT_PROFILE_SCOPE(taskPtr->getName());
+
+			taskPtr->run();
+
+			// Releasing the task may start its continuation, which is submitted back to the dispatcher
+			taskPtr->release();
+		});
+	}
+
+	uint32_t PhysXCpuDispatcher::getWorkerCount() const
+	{
+		return JobSystem::GetWorkerCount();
+	}
+}
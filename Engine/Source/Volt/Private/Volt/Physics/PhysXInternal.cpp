@@ -33,8 +33,6 @@ namespace Volt
 		extensionsLoaded;
 		VT_ASSERT_MSG(extensionsLoaded, "Failed to initialize PhysX extensions");
 
-		myPhysXData->physxCPUDispatcher = physx::PxDefaultCpuDispatcherCreate(4);
-
 #ifdef VT_DEBUG
 		PxSetAssertHandler(myPhysXData->assertHandler);
 #endif
@@ -46,9 +44,6 @@ namespace Volt
 	{
 		CookingFactory::Shutdown();
 
-		myPhysXData->physxCPUDispatcher->release();
-		myPhysXData->physxCPUDispatcher = nullptr;
-
 		PxCloseExtensions();
 
 		PhysXDebugger::StopDebugging();
@@ -73,7 +68,7 @@ namespace Volt
 
 	physx::PxCpuDispatcher* PhysXInternal::GetCPUDispatcher()
 	{
-		return myPhysXData->physxCPUDispatcher;
+		return &myPhysXData->physxCPUDispatcher;
 	}
 
 	physx::PxDefaultAllocator& PhysXInternal::GetAllocator()
@@ -86,43 +86,56 @@ namespace Volt
 		UpdateInvalidPrimitiveData(renderGraph);
 		CompactValidPrimitiveDrawDatas(renderGraph);
 
-		// Temporary animation sampling
+		UpdateAnimationBuffer();
+	}
+
+	void RenderScene::UpdateAnimationBuffer()
+	{
+		VT_PROFILE_FUNCTION();
+
 		m_currentBoneCount = 0;
+		m_animationPoseRequests.clear();
+		m_boneOffsetFromMotionWeaver.clear();
+
+		// The render objects of an animated mesh's sub meshes share a motion weaver, so each weaver is only evaluated once
 		for (const auto& animatedObject : m_animatedRenderObjects)
 		{
 			auto& primitiveDrawData = m_primitiveDrawData.at(m_primitiveIndexFromRenderObjectID.at(animatedObject));
-			primitiveDrawData.boneOffset = m_currentBoneCount;
-
 			const auto& renderObject = GetRenderObjectFromID(animatedObject);
-			m_currentBoneCount += static_cast<uint32_t>(renderObject.motionWeaver->GetSkeleton()->GetJointCount());
-		}
+			const MotionWeaver* motionWeaver = renderObject.motionWeaver.get();
 
-		m_animationBufferStorage.resize(m_currentBoneCount);
-		if (m_currentBoneCount > 0)
-		{
-			for (const auto& animatedObject : m_animatedRenderObjects)
+			auto [it, inserted] = m_boneOffsetFromMotionWeaver.try_emplace(motionWeaver, m_currentBoneCount);
+			if (inserted)
 			{
-				const auto& primitiveDrawData = m_primitiveDrawData.at(m_primitiveIndexFromRenderObjectID.at(animatedObject));
-				const auto& renderObject = GetRenderObjectFromID(animatedObject);
+				auto& request = m_animationPoseRequests.emplace_back();
+				request.motionWeaver = motionWeaver;
+				request.boneOffset = m_currentBoneCount;
+				request.boneCount = static_cast<uint32_t>(motionWeaver->GetSkeleton()->GetJointCount());
 
-				const auto sample = renderObject.motionWeaver->Sample();
-				memcpy_s(m_animationBufferStorage.data() + primitiveDrawData.boneOffset, sizeof(glm::mat4) * sample.size(), sample.data(), sizeof(glm::mat4) * sample.size());
+				m_currentBoneCount += request.boneCount;
 			}
+
+			primitiveDrawData.boneOffset = it->second;
 		}
 
-		if (m_currentBoneCount > 0)
+		if (m_currentBoneCount == 0)
 		{
-			auto bonesBuffer = m_buffers.bonesBuffer;
+			return;
+		}
 
-			if (bonesBuffer->GetResource()->GetCount() < m_animationBufferStorage.size())
-			{
-				bonesBuffer->GetResource()->ResizeWithCount(static_cast<uint32_t>(m_animationBufferStorage.size()));
-				bonesBuffer->MarkAsDirty();
-			}
+		// Every bone is written by the job
+		m_animationBufferStorage.resize_uninitialized(m_currentBoneCount);
+		AnimationPoseJob::EvaluatePoses(m_animationPoseRequests, m_animationBufferStorage);
+
+		auto bonesBuffer = m_buffers.bonesBuffer;
 
-			bonesBuffer->GetResource()->SetData(m_animationBufferStorage.data(), m_animationBufferStorage.size() * sizeof(glm::mat4));
-			m_animationBufferStorage.clear();
+		if (bonesBuffer->GetResource()->GetCount() < m_animationBufferStorage.size())
+		{
+			bonesBuffer->GetResource()->ResizeWithCount(static_cast<uint32_t>(m_animationBufferStorage.size()));
+			bonesBuffer->MarkAsDirty();
 		}
+
+		bonesBuffer->GetResource()->SetData(m_animationBufferStorage.data(), m_animationBufferStorage.size() * sizeof(glm::mat4));
 	}
 
 	void RenderScene::InvalidateRenderObject(UUID64 renderObject)
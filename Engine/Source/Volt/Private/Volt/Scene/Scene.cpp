@@ -59,6 +59,7 @@ namespace Volt
 		m_timeSinceStart = 0.f;
 
 		m_entityScene.OnRuntimeStart();
+		UpdateCameraStreamingObserver();
 	}
 
 	void Scene::OnRuntimeEnd()
@@ -66,6 +67,12 @@ namespace Volt
 		m_entityScene.OnRuntimeEnd();
 		m_isPlaying = false;
 
+		if (m_cameraStreamingObserver != INVALID_STREAMING_OBSERVER_ID)
+		{
+			m_worldEngine.RemoveStreamingObserver(m_cameraStreamingObserver);
+			m_cameraStreamingObserver = INVALID_STREAMING_OBSERVER_ID;
+		}
+
 		Physics::DestroyScene();
 	}
 
@@ -85,6 +92,8 @@ namespace Volt
 		VT_PROFILE_FUNCTION();
 		m_statistics.entityCount = m_entityScene.GetEntityAliveCount();
 		
+		UpdateCameraStreamingObserver();
+		m_worldEngine.Update();
 		m_entityScene.Update(aDeltaTime);
 
 		AnimationManager::Update(aDeltaTime);
@@ -104,7 +113,11 @@ namespace Volt
 	{
 		VT_PROFILE_FUNCTION();
 
+		m_worldEngine.Update();
+
 		m_statistics.entityCount = m_entityScene.GetEntityAliveCount();
+		m_entityScene.SortSceneIfDirty();
+		m_entityScene.UpdateTransformCache();
 
 		ForEachWithComponents<CameraComponent, const TransformComponent>([&](entt::entity id, CameraComponent& cameraComp, const TransformComponent& transComp)
 		{
@@ -126,6 +139,7 @@ namespace Volt
 
 	void Scene::UpdateSimulation(float aDeltaTime)
 	{
+		m_worldEngine.Update();
 		Physics::GetScene()->Simulate(aDeltaTime);
 
 		m_statistics.entityCount = m_entityScene.GetEntityAliveCount();
@@ -158,6 +172,22 @@ namespace Volt
 		return newEntity;
 	}
 
+	Vector<Entity> Scene::CreateEntitiesWithIDs(const Vector<EntityID>& ids, const std::string& tag)
+	{
+		Vector<EntityHelper> newHelpers = m_entityScene.CreateEntitiesWithIDs(ids, tag);
+
+		Vector<Entity> result;
+		result.reserve(newHelpers.size());
+
+		for (const auto& newHelper : newHelpers)
+		{
+			Entity& newEntity = result.emplace_back(newHelper.GetHandle(), this);
+			m_worldEngine.AddEntity(newEntity);
+		}
+
+		return result;
+	}
+
 	Entity Scene::GetEntityFromID(const EntityID id) const
 	{
 		EntityHelper helper = m_entityScene.GetEntityHelperFromEntityID(id);
@@ -177,8 +207,90 @@ namespace Volt
 
 	void Scene::DestroyEntity(Entity entity)
 	{
+		// The scene is sorted before the next update, so multiple destroys in a frame only sort once.
 		m_entityScene.DestroyEntity(entity.GetID());
-		SortScene();
+	}
+
+	void Scene::DestroyEntities(const Vector<EntityID>& entityIds)
+	{
+		VT_PROFILE_FUNCTION();
+
+		m_entityScene.DestroyEntities(entityIds);
+	}
+
+	Entity Scene::GetActiveCameraEntity() const
+	{
+		Entity cameraEntity{};
+		int32_t highestPriority = -1;
+
+		m_entityScene.GetRegistry().view<const CameraComponent>().each([&](const entt::entity id, const CameraComponent& cameraComponent)
+		{
+			if (static_cast<int32_t>(cameraComponent.priority) > highestPriority)
+			{
+				highestPriority = static_cast<int32_t>(cameraComponent.priority);
+				cameraEntity = GetEntityFromHandle(id);
+			}
+		});
+
+		return cameraEntity;
+	}
+
+	void Scene::UpdateCameraStreamingObserver()
+	{
+		if (!m_sceneSettings.useWorldEngine || !m_isPlaying)
+		{
+			return;
+		}
+
+		// Without a camera the observer stays where the last one was
+		Entity cameraEntity = GetActiveCameraEntity();
+		if (!cameraEntity)
+		{
+			return;
+		}
+
+		const glm::vec3 cameraPosition = cameraEntity.GetPosition();
+
+		if (m_cameraStreamingObserver == INVALID_STREAMING_OBSERVER_ID)
+		{
+			m_cameraStreamingObserver = m_worldEngine.AddStreamingObserver(cameraPosition);
+		}
+		else
+		{
+			m_worldEngine.SetStreamingObserverPosition(m_cameraStreamingObserver, cameraPosition);
+		}
+	}
+
+	Vector<EntityHelper> Scene::CreateEntitiesFromCommandBuffer(size_t count)
+	{
+		Vector<EntityHelper> newHelpers = m_entityScene.CreateEntities(count);
+
+		for (const auto& newHelper : newHelpers)
+		{
+			m_worldEngine.AddEntity(Entity(newHelper.GetHandle(), this));
+		}
+
+		return newHelpers;
+	}
+
+	void Scene::DestroyEntitiesFromCommandBuffer(const Vector<EntityID>& entityIds)
+	{
+		// Children are destroyed with their parent, so they have to leave their cells as well
+		for (const auto& entityId : entityIds)
+		{
+			Entity entity = GetEntityFromID(entityId);
+			if (!entity.IsValid())
+			{
+				continue;
+			}
+
+			for (const auto& hierarchyEntity : FlattenEntityHeirarchy(entity))
+			{
+				m_worldEngine.RemoveEntity(hierarchyEntity);
+			}
+		}
+
+		DestroyEntities(entityIds);
 	}
 
 	void Scene::ParentEntity(Entity parent, Entity child)
@@ -238,17 +350,7 @@ namespace Volt
 
 	void Scene::InvalidateEntityTransform(const EntityID& entityId)
 	{
-		Vector<EntityID> invalidatedEntities = m_entityScene.InvalidateEntityTransform(entityId);
-
-		for (const auto& id : invalidatedEntities)
-		{
-			Entity currentEntity = GetEntityFromID(id);
-
-			if (m_sceneSettings.useWorldEngine)
-			{
-				m_worldEngine.OnEntityMoved(currentEntity);
-			}
-		}
+		m_entityScene.InvalidateEntityTransform(entityId);
 	}
 
 	bool Scene::IsEntityValid(EntityID entityId) const
@@ -365,6 +467,24 @@ namespace Volt
 
 		m_entityScene.SetRenderScene(m_renderScene.get());
 
+		EntityCommandPlaybackCallbacks playbackCallbacks{};
+		playbackCallbacks.createEntities = [this](size_t count) { return CreateEntitiesFromCommandBuffer(count); };
+		playbackCallbacks.destroyEntities = [this](const Vector<EntityID>& entityIds) { DestroyEntitiesFromCommandBuffer(entityIds); };
+		m_entityScene.SetCommandPlaybackCallbacks(playbackCallbacks);
+
+		m_entityScene.SetTransformsChangedCallback([this](const Vector<entt::entity>& movedEntities)
+		{
+			if (!m_sceneSettings.useWorldEngine)
+			{
+				return;
+			}
+
+			for (const auto& entity : movedEntities)
+			{
+				m_worldEngine.OnEntityMoved(Entity(entity, this));
+			}
+		});
+
 		m_worldEngine.Reset(this, 16, 4);
 	}
 
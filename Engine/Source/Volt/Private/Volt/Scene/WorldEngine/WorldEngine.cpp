@@ -10,10 +10,21 @@
 
 #include "Volt/Math/Math.h"
 
+#include <AssetSystem/AssetManager.h>
 #include <JobSystem/JobSystem.h>
 
+#include <CoreUtilities/Time/ScopedTimer.h>
+
 namespace Volt
 {
+	namespace Utility
+	{
+		VT_INLINE uint64_t GetCellCoordinatesKey(const glm::ivec2& coordinates)
+		{
+			return (static_cast<uint64_t>(static_cast<uint32_t>(coordinates.x)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(coordinates.y));
+		}
+	}
+
 	void WorldEngine::Reset(Scene* scene, uint32_t initialCellCount, uint32_t cellCountWidth)
 	{
 		m_scene = scene;
@@ -44,52 +55,58 @@ namespace Volt
 			return;
 		}
 
-		const auto position = entity.GetPosition();
-		const glm::ivec3 intPosition = position;
-
-		const int32_t closestXPos = Math::RoundToClosestMultiple(intPosition.x, m_settings.cellSize / 2);
-		const int32_t closestZPos = Math::RoundToClosestMultiple(intPosition.z, m_settings.cellSize / 2);
-
-		for (auto& cell : m_cells)
+		const WorldCellID cellId = GetCellIDFromPosition(entity.GetPosition());
+		if (cellId == INVALID_WORLD_CELL_ID)
 		{
-			if (cell.origin == glm::ivec3{ closestXPos, 0, closestZPos })
-			{
-				cell.cellEntities.emplace_back(entity.GetID());
-			}
+			RemoveEntity(entity);
+			return;
 		}
+
+		AddEntityToCell(GetCellFromID(cellId), entity.GetID());
 	}
 
 	void WorldEngine::RemoveEntity(const Entity& entity)
 	{
-		for (auto& cell : m_cells)
+		auto it = m_entityCells.find(entity.GetID());
+		if (it == m_entityCells.end())
 		{
-			auto it = std::find_if(cell.cellEntities.begin(), cell.cellEntities.end(), [&](const auto id) { return id == entity.GetID(); });
-			if (it != cell.cellEntities.end())
-			{
-				cell.cellEntities.erase(it);
-			}
+			return;
 		}
+
+		RemoveEntityFromCell(it->second, it->first);
+		m_entityCells.erase(it);
 	}
 
 	void WorldEngine::AddCell(const glm::ivec3& origin, WorldCellID id)
 	{
-		for (const auto& cell : m_cells)
+		const glm::ivec2 coordinates = GetCellCoordinates(glm::vec3{ origin });
+		const uint64_t coordinatesKey = Utility::GetCellCoordinatesKey(coordinates);
+
+		if (m_cellIndexFromCoordinates.contains(coordinatesKey))
 		{
-			if (cell.origin == origin)
-			{
-				// Cell with that origin already exists!
-				return;
-			}
+			// Cell with that origin already exists!
+			return;
 		}
 
+		const uint32_t cellIndex = static_cast<uint32_t>(m_cells.size());
+
 		auto& newCell = m_cells.emplace_back();
 		newCell.origin = origin;
-		newCell.cellId = id == std::numeric_limits<uint32_t>::max() ? static_cast<WorldCellID>(m_cells.size() - 1) : id;
+		newCell.coordinates = coordinates;
+		newCell.cellId = id == std::numeric_limits<uint32_t>::max() ? static_cast<WorldCellID>(cellIndex) : id;
+
+		m_cellIndexFromCoordinates[coordinatesKey] = cellIndex;
+		m_cellIndexFromID[newCell.cellId] = cellIndex;
 	}
 
 	void WorldEngine::GenerateCells()
 	{
 		m_cells.clear();
+		m_cellIndexFromCoordinates.clear();
+		m_cellIndexFromID.clear();
+		m_entityCells.clear();
+		m_activeCells.clear();
+		m_mergeQueue.clear();
 
 		const glm::uvec2& worldSize = m_settings.worldSize;
 
@@ -99,6 +116,10 @@ namespace Volt
 		const uint32_t cellCountX = Math::DivideRoundUp(worldSize.x, static_cast<uint32_t>(m_settings.cellSize));
 		const uint32_t cellCountY = Math::DivideRoundUp(worldSize.y, static_cast<uint32_t>(m_settings.cellSize));
 
+		m_cells.reserve(cellCountX * cellCountY);
+		m_cellIndexFromCoordinates.reserve(cellCountX * cellCountY);
+		m_cellIndexFromID.reserve(cellCountX * cellCountY);
+
 		for (uint32_t x = 0; x < cellCountX; x++)
 		{
 			for (uint32_t y = 0; y < cellCountY; y++)
@@ -117,88 +138,402 @@ namespace Volt
 
 	void WorldEngine::AddEntitiesToCell(WorldCellID cellId, const Vector<EntityID>& entities)
 	{
-		auto cellIt = std::find_if(m_cells.begin(), m_cells.end(), [cellId](const WorldCell& cell) 
-		{
-			return cell.cellId == cellId;
-		});
-
-		if (cellIt == m_cells.end())
+		auto& cell = GetCellFromID(cellId);
+		if (cell.cellId == INVALID_WORLD_CELL_ID)
 		{
 			return;
 		}
 
-		WorldCell& cell = *cellIt;
-		cell.cellEntities.insert(cell.cellEntities.end(), entities.begin(), entities.end());
+		cell.cellEntities.reserve(cell.cellEntities.size() + entities.size());
+
+		for (const auto& entityId : entities)
+		{
+			AddEntityToCell(cell, entityId);
+		}
 	}
 
 	void WorldEngine::OnEntityMoved(const Entity& entity)
 	{
-		RemoveEntity(entity);
+		if (entity.GetComponent<TransformComponent>().movability == Movability::Movable)
+		{
+			RemoveEntity(entity);
+			return;
+		}
+
 		AddEntity(entity);
 	}
 
 	void WorldEngine::BeginStreamingCell(WorldCellID cellId)
 	{
 		auto& cell = GetCellFromID(cellId);
-		if (cell.cellId == INVALID_WORLD_CELL_ID)
+		if (cell.cellId == INVALID_WORLD_CELL_ID || cell.state != WorldCellState::Unloaded)
 		{
 			return;
 		}
 
-		JobSystem::CreateAndRunJob([cellId, this]() 
+		if (cell.cellEntities.empty())
 		{
-			auto& cell = GetCellFromID(cellId);
+			cell.state = WorldCellState::Loaded;
+			m_activeCells.insert(cellId);
+			return;
+		}
+
+		cell.state = WorldCellState::Streaming;
+		cell.streamingGeneration = ++m_streamingGeneration;
+		m_activeCells.insert(cellId);
+
+		Ref<StagedWorldCell> stagedCell = CreateRef<StagedWorldCell>();
+		stagedCell->cellId = cellId;
+		stagedCell->streamingGeneration = cell.streamingGeneration;
+		stagedCell->sceneMetadata = AssetManager::GetMetadataFromHandle(m_scene->handle);
+		stagedCell->cellEntities = cell.cellEntities;
+		stagedCell->useCookedEntities = m_scene->m_hasCookedEntities;
 
-			SceneSerializer::Get().LoadWorldCell(m_scene->shared_from_this(), cell);
-			cell.isLoaded = true;
+		// The job only touches the staged cell and the queue, the scene is left alone until the merge.
+		JobSystem::CreateAndRunJob([stagedCell, stagingQueue = m_stagingQueue]()
+		{
+			SceneSerializer::Get().StageWorldCell(*stagedCell);
+
+			std::scoped_lock lock{ stagingQueue->mutex };
+			stagingQueue->stagedCells.emplace_back(stagedCell);
 		});
 	}
 
-	WorldCellID WorldEngine::GetCellIDFromEntity(const Entity& entity) const
+	void WorldEngine::UnloadCell(WorldCellID cellId)
 	{
-		for (const auto& cell : m_cells)
+		auto& cell = GetCellFromID(cellId);
+		if (cell.cellId == INVALID_WORLD_CELL_ID || cell.state == WorldCellState::Unloaded)
 		{
-			auto it = std::find_if(cell.cellEntities.begin(), cell.cellEntities.end(), [&](const auto id) { return id == entity.GetID(); });
-			if (it != cell.cellEntities.end())
+			return;
+		}
+
+		// Anything still being staged for the cell is dropped when it lands.
+		cell.streamingGeneration = ++m_streamingGeneration;
+
+		if (cell.state == WorldCellState::Loaded)
+		{
+			m_scene->DestroyEntities(cell.cellEntities);
+		}
+
+		cell.state = WorldCellState::Unloaded;
+		m_activeCells.erase(cellId);
+	}
+
+	WorldStreamingObserverID WorldEngine::AddStreamingObserver(const glm::vec3& position)
+	{
+		const WorldStreamingObserverID observerId = m_nextObserverId++;
+		m_streamingObservers.emplace_back(StreamingObserver{ observerId, position });
+
+		return observerId;
+	}
+
+	void WorldEngine::SetStreamingObserverPosition(WorldStreamingObserverID observerId, const glm::vec3& position)
+	{
+		for (auto& observer : m_streamingObservers)
+		{
+			if (observer.id == observerId)
+			{
+				observer.position = position;
+				return;
+			}
+		}
+	}
+
+	void WorldEngine::RemoveStreamingObserver(WorldStreamingObserverID observerId)
+	{
+		m_streamingObservers.erase_with_predicate([observerId](const StreamingObserver& observer)
+		{
+			return observer.id == observerId;
+		});
+	}
+
+	void WorldEngine::Update(float mergeBudget)
+	{
+		VT_PROFILE_FUNCTION();
+
+		if (!m_streamingObservers.empty())
+		{
+			UpdateStreaming();
+		}
+
+		{
+			std::scoped_lock lock{ m_stagingQueue->mutex };
+			for (auto& stagedCell : m_stagingQueue->stagedCells)
+			{
+				m_mergeQueue.emplace_back(std::move(stagedCell));
+			}
+
+			m_stagingQueue->stagedCells.clear();
+		}
+
+		if (m_mergeQueue.empty())
+		{
+			return;
+		}
+
+		ScopedTimer mergeTimer{};
+		bool hasMergedEntities = false;
+
+		while (!m_mergeQueue.empty() && mergeTimer.GetTime() < mergeBudget)
+		{
+			StagedWorldCell& stagedCell = *m_mergeQueue.front();
+			WorldCell& cell = GetCellFromID(stagedCell.cellId);
+
+			// The cell was unloaded, or streamed again, while it was being staged.
+			if (cell.cellId == INVALID_WORLD_CELL_ID || cell.streamingGeneration != stagedCell.streamingGeneration)
 			{
-				return cell.cellId;
+				m_mergeQueue.erase(m_mergeQueue.begin());
+				continue;
 			}
+
+			hasMergedEntities |= MergeStagedEntities(stagedCell);
+
+			cell.state = WorldCellState::Loaded;
+			m_mergeQueue.erase(m_mergeQueue.begin());
 		}
 
-		return INVALID_WORLD_CELL_ID;
+		// Copying brings over the original creation times, so the scene is sorted once per frame instead of per cell.
+		if (hasMergedEntities)
+		{
+			m_scene->SortScene();
+		}
+	}
+
+	WorldCellID WorldEngine::GetCellIDFromEntity(const Entity& entity) const
+	{
+		auto it = m_entityCells.find(entity.GetID());
+		if (it == m_entityCells.end())
+		{
+			return INVALID_WORLD_CELL_ID;
+		}
+
+		return it->second;
+	}
+
+	WorldCellID WorldEngine::GetCellIDFromPosition(const glm::vec3& position) const
+	{
+		auto it = m_cellIndexFromCoordinates.find(Utility::GetCellCoordinatesKey(GetCellCoordinates(position)));
+		if (it == m_cellIndexFromCoordinates.end())
+		{
+			return INVALID_WORLD_CELL_ID;
+		}
+
+		return m_cells.at(it->second).cellId;
+	}
+
+	glm::ivec2 WorldEngine::GetCellCoordinates(const glm::vec3& position) const
+	{
+		// Cells are laid out from the corner of the world, which is centered around zero.
+		const glm::vec2 gridPosition = glm::vec2{ position.x, position.z } + glm::vec2{ m_settings.worldSize / 2u };
+		return glm::ivec2{ glm::floor(gridPosition / static_cast<float>(m_settings.cellSize)) };
 	}
 
 	bool WorldEngine::IsCellLoaded(WorldCellID cellId) const
 	{
 		const auto& cell = GetCellFromID(cellId);
-		return cell.isLoaded;
+		return cell.state == WorldCellState::Loaded;
 	}
 
-	WorldCell& WorldEngine::GetCellFromID(WorldCellID cellId)
+	bool WorldEngine::MergeStagedEntities(StagedWorldCell& stagedCell)
 	{
-		for (auto& cell : m_cells)
+		VT_PROFILE_FUNCTION();
+
+		Vector<std::pair<uint32_t, EntityID>> mergedEntities;
+		Vector<EntityID> mergedEntityIds;
+
+		mergedEntities.reserve(stagedCell.stagedEntities.size());
+		mergedEntityIds.reserve(stagedCell.stagedEntities.size());
+
+		for (const auto& stagedEntity : stagedCell.stagedEntities)
 		{
-			if (cell.cellId == cellId)
+			if (m_scene->IsEntityValid(stagedEntity.second))
 			{
-				return cell;
+				VT_LOG(Warning, "[WorldEngine]: Entity {0} of cell {1} already exists in the scene!", stagedEntity.second, stagedCell.cellId);
+				continue;
 			}
+
+			mergedEntities.emplace_back(stagedEntity);
+			mergedEntityIds.emplace_back(stagedEntity.second);
+		}
+
+		if (mergedEntityIds.empty())
+		{
+			return false;
+		}
+
+		// The entities are already part of the cell, so they are created without being added to it again.
+		// All of them exist before any components are copied, so every parent is in place by the time its children are.
+		const Vector<EntityHelper> newHelpers = m_scene->m_entityScene.CreateEntitiesWithIDs(mergedEntityIds);
+
+		for (size_t i = 0; i < newHelpers.size(); i++)
+		{
+			const auto& [stagingSceneIndex, entityId] = mergedEntities.at(i);
+
+			Entity stagedEntity = stagedCell.stagingScenes.at(stagingSceneIndex)->GetEntityFromID(entityId);
+			Entity newEntity{ newHelpers.at(i).GetHandle(), m_scene };
+
+			Entity::Copy(stagedEntity, newEntity, EntityCopyFlags::None);
+			m_scene->InvalidateEntityTransform(entityId);
+		}
+
+		return true;
+	}
+
+	WorldCell& WorldEngine::GetCellFromID(WorldCellID cellId)
+	{
+		auto it = m_cellIndexFromID.find(cellId);
+		if (it != m_cellIndexFromID.end())
+		{
+			return m_cells.at(it->second);
 		}
 
-		static WorldCell nullCell{};
+		static WorldCell nullCell{ INVALID_WORLD_CELL_ID };
 		return nullCell;
 	}
 
 	const WorldCell& WorldEngine::GetCellFromID(WorldCellID cellId) const
 	{
-		for (auto& cell : m_cells)
+		auto it = m_cellIndexFromID.find(cellId);
+		if (it != m_cellIndexFromID.end())
+		{
+			return m_cells.at(it->second);
+		}
+
+		static WorldCell nullCell{ INVALID_WORLD_CELL_ID };
+		return nullCell;
+	}
+
+	void WorldEngine::AddEntityToCell(WorldCell& cell, EntityID entityId)
+	{
+		auto [it, inserted] = m_entityCells.try_emplace(entityId, cell.cellId);
+		if (!inserted)
 		{
-			if (cell.cellId == cellId)
+			if (it->second == cell.cellId)
 			{
-				return cell;
+				return;
 			}
+
+			RemoveEntityFromCell(it->second, entityId);
+			it->second = cell.cellId;
 		}
 
-		static WorldCell nullCell{};
-		return nullCell;
+		cell.cellEntities.emplace_back(entityId);
+	}
+
+	void WorldEngine::RemoveEntityFromCell(WorldCellID cellId, EntityID entityId)
+	{
+		auto& cell = GetCellFromID(cellId);
+
+		auto it = std::find(cell.cellEntities.begin(), cell.cellEntities.end(), entityId);
+		if (it == cell.cellEntities.end())
+		{
+			return;
+		}
+
+		// The order of the cell entities doesn't matter
+		*it = cell.cellEntities.back();
+		cell.cellEntities.pop_back();
+	}
+
+	void WorldEngine::UpdateStreaming()
+	{
+		VT_PROFILE_FUNCTION();
+
+		const float loadDistance = m_streamingSettings.loadDistance;
+		const float unloadDistance = std::max(m_streamingSettings.unloadDistance, loadDistance);
+
+		// Unload the cells which every observer has moved away from, furthest first
+		Vector<std::pair<float, WorldCellID>> unloadCandidates;
+		for (const WorldCellID cellId : m_activeCells)
+		{
+			const auto& cell = GetCellFromID(cellId);
+
+			float closestDistance = std::numeric_limits<float>::max();
+			for (const auto& observer : m_streamingObservers)
+			{
+				closestDistance = std::min(closestDistance, GetDistanceToCell(cell, observer.position));
+			}
+
+			if (closestDistance > unloadDistance)
+			{
+				unloadCandidates.emplace_back(closestDistance, cellId);
+			}
+		}
+
+		std::sort(unloadCandidates.begin(), unloadCandidates.end(), std::greater<>());
+
+		const size_t unloadCount = std::min(unloadCandidates.size(), static_cast<size_t>(m_streamingSettings.maxCellUnloadsPerFrame));
+		for (size_t i = 0; i < unloadCount; i++)
+		{
+			UnloadCell(unloadCandidates.at(i).second);
+		}
+
+		// Load the unloaded cells in range of an observer, closest first
+		const int32_t cellRange = static_cast<int32_t>(std::ceil(loadDistance / static_cast<float>(m_settings.cellSize)));
+
+		Vector<std::pair<float, WorldCellID>> loadCandidates;
+		for (const auto& observer : m_streamingObservers)
+		{
+			const glm::ivec2 observerCoordinates = GetCellCoordinates(observer.position);
+
+			for (int32_t x = observerCoordinates.x - cellRange; x <= observerCoordinates.x + cellRange; x++)
+			{
+				for (int32_t y = observerCoordinates.y - cellRange; y <= observerCoordinates.y + cellRange; y++)
+				{
+					auto it = m_cellIndexFromCoordinates.find(Utility::GetCellCoordinatesKey({ x, y }));
+					if (it == m_cellIndexFromCoordinates.end())
+					{
+						continue;
+					}
+
+					const auto& cell = m_cells.at(it->second);
+					if (cell.state != WorldCellState::Unloaded)
+					{
+						continue;
+					}
+
+					const float distance = GetDistanceToCell(cell, observer.position);
+					if (distance <= loadDistance)
+					{
+						loadCandidates.emplace_back(distance, cell.cellId);
+					}
+				}
+			}
+		}
+
+		std::sort(loadCandidates.begin(), loadCandidates.end());
+
+		// Empty cells load instantly, so they don't count towards the budget
+		uint32_t startedLoads = 0;
+		for (const auto& [distance, cellId] : loadCandidates)
+		{
+			if (startedLoads >= m_streamingSettings.maxCellLoadsPerFrame)
+			{
+				break;
+			}
+
+			auto& cell = GetCellFromID(cellId);
+			if (cell.state != WorldCellState::Unloaded)
+			{
+				// Already picked up through another observer
+				continue;
+			}
+
+			BeginStreamingCell(cellId);
+
+			if (cell.state == WorldCellState::Streaming)
+			{
+				startedLoads++;
+			}
+		}
+	}
+
+	float WorldEngine::GetDistanceToCell(const WorldCell& cell, const glm::vec3& position) const
+	{
+		// Distance to the closest point of the cell on the XZ plane, zero when inside it.
+		const glm::vec2 halfCellSize = glm::vec2{ static_cast<float>(m_settings.cellSize) * 0.5f };
+		const glm::vec2 delta = glm::abs(glm::vec2{ position.x, position.z } - glm::vec2{ cell.origin.x, cell.origin.z });
+
+		return glm::length(glm::max(delta - halfCellSize, glm::vec2{ 0.f }));
 	}
 }
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <CoreUtilities/Containers/Vector.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <span>
+
+namespace Volt
+{
+	class MotionWeaver;
+
+	struct AnimationPoseRequest
+	{
+		const MotionWeaver* motionWeaver = nullptr;
+
+		// Range of the bone buffer the skinning matrices are written to, one per skeleton joint.
+		uint32_t boneOffset = 0;
+		uint32_t boneCount = 0;
+	};
+
+	namespace AnimationPoseJob
+	{
+		// Evaluates all requests in parallel, writing the skinning matrices straight into their range of outBoneMatrices.
+		// Intermediate poses come from per worker scratch arenas, so nothing is allocated once the arenas have grown.
+		void EvaluatePoses(std::span<const AnimationPoseRequest> requests, std::span<glm::mat4> outBoneMatrices);
+	}
+}
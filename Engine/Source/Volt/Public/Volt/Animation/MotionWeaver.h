@@ -5,6 +5,10 @@
 #include "Volt/Core/Base.h"
 #include "glm/mat4x4.hpp"
 
+#include <span>
+
+class ScratchArena;
+
 namespace Volt
 {
 	class Animation;
@@ -23,6 +27,10 @@ namespace Volt
 		void Update(float deltaTime);
 
 		Vector<glm::mat4x4> Sample();
+
+		// Writes one skinning matrix per skeleton joint, with the intermediate pose taken from the arena.
+		// Returns false if there is nothing to sample. Safe to call from several threads on different weavers.
+		bool Sample(std::span<glm::mat4x4> outSkinningMatrices, ScratchArena& scratchArena) const;
 		
 		VT_NODISCARD VT_INLINE Weak<Skeleton> GetSkeleton() const { return m_Skeleton; }
 
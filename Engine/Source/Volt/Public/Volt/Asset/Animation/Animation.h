@@ -10,9 +10,14 @@
 
 #include <glm/glm.hpp>
 
+#include <span>
+
 namespace Volt
 {
 	class Skeleton;
+	class CompressedAnimationClip;
+	struct AnimationCompressionSettings;
+
 	class Animation : public Asset
 	{
 	public:
@@ -74,7 +79,11 @@ namespace Volt
 		const Vector<glm::mat4> Sample(float samplePercent, Ref<Skeleton> skeleton, bool looping);
 		const Vector<glm::mat4> Sample(uint32_t frameIndex, Ref<Skeleton> aSkeleton);
 
-		static Vector<glm::mat4> LocalPoseToGlobalMatrices(const Pose& localPose, Ref<Skeleton> aSkeleton);
+		// Blends the two frames around the sample point into outLocalPose, one TRS per joint. Doesn't allocate.
+		bool SampleLocalPose(float samplePercent, bool looping, std::span<TRS> outLocalPose) const;
+
+		// Writes the skinning matrices, global joint transforms times the inverse bind pose, for a local pose. Doesn't allocate.
+		static void LocalPoseToSkinningMatrices(std::span<const TRS> localPose, const Skeleton& skeleton, std::span<glm::mat4> outSkinningMatrices);
 		static void BlendPoseWith(Pose& target, const Pose& poseToBlendWith, float blendFactor);
 		static Pose GetBlendedPose(const Pose& target, const Pose& poseToBlendWith, float blendFactor);
 
@@ -86,9 +95,16 @@ namespace Volt
 		const float GetNormalizedCurrentTimeFromStartTime(float startTime, float speed, bool looping);
 
 		inline const float GetDuration() const { return m_duration; }
-		inline const size_t GetFrameCount() const { return m_frames.size(); }
+		const size_t GetFrameCount() const;
 		inline const uint32_t GetFramesPerSecond() const { return m_framesPerSecond; }
 
+		// Replaces the frames with a compressed clip. Returns false, keeping the frames, if they can't be compressed.
+		bool Compress(const AnimationCompressionSettings& settings);
+		inline const bool IsCompressed() const { return m_compressedClip != nullptr; }
+
+		// Expands the compressed clip back into frames, or returns a copy of the frames if the animation isn't compressed.
+		Vector<Pose> DecompressFrames() const;
+
 		void AddEvent(const std::string& eventName, uint32_t frame);
 		void RemoveEvent(const std::string& eventName, uint32_t frame);
 		inline const bool HasEvents() const { return !m_events.empty(); }
@@ -96,7 +112,7 @@ namespace Volt
 
 		static AssetType GetStaticType() { return AssetTypes::Animation; }
 		AssetType GetType() override { return GetStaticType(); };
-		uint32_t GetVersion() const override { return 1; }
+		uint32_t GetVersion() const override { return 2; }
 
 	private:
 		struct PoseData
@@ -108,11 +124,16 @@ namespace Volt
 
 		static const PoseData GetFrameDataFromAnimation(Animation& animation, const float aNormalizedTime);
 
+		// Blends two frames into outLocalPose from either the compressed clip or the frames. Returns false if they have fewer joints than the pose.
+		bool BlendFrames(uint32_t currentFrameIndex, uint32_t nextFrameIndex, float blend, std::span<TRS> outLocalPose) const;
+
 		friend class FbxSourceImporter;
 		friend class AnimationImporter;
 		friend class AnimationSerializer;
 
+		// Empty once the animation has been compressed
 		Vector<Pose> m_frames;
+		Ref<CompressedAnimationClip> m_compressedClip;
 		Vector<Event> m_events;
 
 		uint32_t m_framesPerSecond = 0;
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Volt/Asset/Animation/Animation.h"
+
+#include <CoreUtilities/FileIO/BinaryStreamWriter.h>
+#include <CoreUtilities/FileIO/BinaryStreamReader.h>
+
+#include <glm/glm.hpp>
+
+#include <span>
+
+namespace Volt
+{
+	struct AnimationCompressionSettings
+	{
+		// The largest error a dropped key may introduce, per track. The rotation tolerance is an angle in radians.
+		float translationTolerance = 0.01f;
+		float rotationTolerance = 0.0005f;
+		float scaleTolerance = 0.0001f;
+	};
+
+	// Animation frames compressed per joint track:
+	// - Keys that linear interpolation between their neighbours reproduces within the tolerance are dropped.
+	// - Tracks which never change are stored as a single full precision value.
+	// - Translation and scale keys are quantized to 16 bits per component within the track's range.
+	// - Rotation keys are stored as their three smallest components, 15 bits each, with the index of the largest one.
+	// Sampling decodes straight from the key streams, the frames are never expanded.
+	class CompressedAnimationClip
+	{
+	public:
+		enum class TrackType : uint32_t
+		{
+			Translation,
+			Rotation,
+			Scale,
+
+			Count
+		};
+
+		inline static constexpr uint32_t MAX_FRAME_COUNT = std::numeric_limits<uint16_t>::max();
+		inline static constexpr uint32_t MAX_KEY_SPACING = 256;
+
+		// Returns nullptr if the frames can't be compressed, in which case they should be kept as is.
+		static Ref<CompressedAnimationClip> Compress(std::span<const Animation::Pose> frames, const AnimationCompressionSettings& settings = {});
+
+		// Blends two frames, like the uncompressed frames are blended. Returns false if the clip has fewer joints than the pose.
+		bool SampleFrames(uint32_t currentFrame, uint32_t nextFrame, float blend, std::span<Animation::TRS> outLocalPose) const;
+
+		VT_NODISCARD VT_INLINE uint32_t GetFrameCount() const { return m_frameCount; }
+		VT_NODISCARD VT_INLINE uint32_t GetJointCount() const { return m_jointCount; }
+		VT_NODISCARD size_t GetMemorySize() const;
+
+		static void Serialize(BinaryStreamWriter& streamWriter, const CompressedAnimationClip& data);
+		static void Deserialize(BinaryStreamReader& streamReader, CompressedAnimationClip& outData);
+
+	private:
+		struct Track
+		{
+			uint32_t firstKey;
+			uint32_t keyCount;
+
+			// Single key tracks keep their full precision value here, rotations as xyzw.
+			// Quantized translation and scale tracks keep the minimum of their range in xyz.
+			glm::vec4 value;
+			glm::vec3 rangeExtent;
+		};
+
+		void AddVectorTrack(std::span<const glm::vec3> values, float tolerance);
+		void AddRotationTrack(std::span<const glm::quat> values, float tolerance);
+
+		VT_NODISCARD VT_INLINE const Track& GetTrack(uint32_t jointIndex, TrackType type) const
+		{
+			return m_tracks[jointIndex * static_cast<uint32_t>(TrackType::Count) + static_cast<uint32_t>(type)];
+		}
+
+		glm::vec3 SampleVectorTrack(const Track& track, float frameTime) const;
+		glm::quat SampleRotationTrack(const Track& track, float frameTime) const;
+		Animation::TRS SampleJoint(uint32_t jointIndex, float frameTime) const;
+
+		// Finds the pair of keys around the frame, and how far between them it is.
+		void FindKeys(const Track& track, float frameTime, uint32_t& outKey, float& outBlend) const;
+
+		uint32_t m_frameCount = 0;
+		uint32_t m_jointCount = 0;
+
+		Vector<Track> m_tracks;
+
+		// Indexed by key, tracks own a contiguous range. Every key is three 16 bit values.
+		Vector<uint16_t> m_keyFrames;
+		Vector<uint16_t> m_keyData;
+	};
+}
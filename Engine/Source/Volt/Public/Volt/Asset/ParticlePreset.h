@@ -12,6 +12,8 @@ namespace Volt
 	class ParticlePreset : public Asset
 	{
 	public:
+		inline static constexpr uint32_t MAX_POOL_SIZE = 100'000;
+
 		enum class eType : int
 		{
 			MESH = 0,
@@ -53,8 +55,30 @@ namespace Volt
 		float burstInterval = 0;
 		float burstLength = 0;
 
+		// Overrides the pool size derived from the emission rate when above zero
 		int poolSize = 0;
 
+		// The most particles an emitter with this preset can have alive at once.
+		uint32_t GetMaxAliveParticleCount() const
+		{
+			if (poolSize > 0)
+			{
+				return static_cast<uint32_t>(poolSize);
+			}
+
+			// Particles are spawned at intensity per second and live for at most the max life time.
+			// The slack covers frame rounding, a particle is only killed the frame after its life time runs out.
+			const float longestLifeTime = std::max(minLifeTime, maxLifeTime);
+			float aliveCount = intensity * longestLifeTime * 1.1f;
+
+			if (!isLooping)
+			{
+				aliveCount = std::min(aliveCount, intensity * emittionTime);
+			}
+
+			return std::min(static_cast<uint32_t>(std::ceil(std::max(aliveCount, 0.f))) + 16u, MAX_POOL_SIZE);
+		}
+
 		static AssetType GetStaticType() { return AssetTypes::ParticlePreset; }
 		AssetType GetType() override { return GetStaticType(); }
 		uint32_t GetVersion() const override { return 1; }
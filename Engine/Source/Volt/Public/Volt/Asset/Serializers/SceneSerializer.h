@@ -8,6 +8,8 @@
 
 #include <CoreUtilities/TypeTraits/TypeIndex.h>
 
+#include <span>
+
 class YAMLMemoryStreamWriter;
 class YAMLMemoryStreamReader;
 
@@ -17,6 +19,8 @@ namespace Volt
 	class IArrayTypeDesc;
 	class MonoScriptFieldCache;
 	class IComponentTypeDesc;
+	struct ComponentMember;
+	struct StagedWorldCell;
 
 	class SceneSerializer : public AssetSerializer
 	{
@@ -30,13 +34,29 @@ namespace Volt
 		void SerializeEntity(entt::entity id, const AssetMetadata& metadata, const Ref<Scene>& scene, YAMLMemoryStreamWriter& streamWriter) const;
 		void DeserializeEntity(const Ref<Scene>& scene, const AssetMetadata& metadata, YAMLMemoryStreamReader& streamReader) const;
 
-		void LoadWorldCell(const Ref<Scene>& scene, const WorldCell& worldCell) const;
+		// Writes the cooked entities of the scene next to its entity files. Part of the game build, saving only writes the entity files.
+		void CookScene(const AssetMetadata& metadata, const Ref<Scene>& scene) const;
+
+		// Decodes the cell's entities into isolated staging scenes. Doesn't touch the scene, so it can run on any thread.
+		void StageWorldCell(StagedWorldCell& stagedCell) const;
 
 		static SceneSerializer& Get() { return *s_instance; }
 
 		inline static constexpr uint32_t ENTITY_MAGIC_VAL = 1515;
+		inline static constexpr uint32_t COOKED_MAGIC_VAL = 1516;
+		inline static constexpr uint32_t COOKED_VERSION = 1;
 
 	private:
+		// A reflected member flattened out of its (sub) component, with the offset relative to the top level object.
+		struct CookedMember
+		{
+			const ComponentMember* member = nullptr;
+			size_t offset = 0;
+
+			// Stored as a column of raw bytes, otherwise the member is written per object.
+			bool isRaw = false;
+		};
+
 		inline static SceneSerializer* s_instance = nullptr;
 
 		void SerializeWorldEngine(const Ref<Scene>& scene, YAMLMemoryStreamWriter& streamWriter) const;
@@ -46,6 +66,23 @@ namespace Volt
 		void LoadCellEntities(const AssetMetadata& metadata, const Ref<Scene>& scene, const std::filesystem::path& sceneDirectory) const;
 
 		Entity CreateEntityFromUUIDThreadSafe(EntityID entityId, const Ref<Scene>& scene) const;
+		void DeserializeVertexPaintData(const Ref<Scene>& scene, const AssetMetadata& metadata, Entity entity) const;
+
+		// Cooked entities are a binary copy of the YAML entity files, stored column-wise per cell and component type.
+		// They are only written by CookScene when the whole scene is loaded, and ignored when older than the entity files.
+		void CookEntities(const Ref<Scene>& scene, const std::filesystem::path& sceneDirectory) const;
+		bool LoadCookedCellEntities(const Ref<Scene>& scene, const std::filesystem::path& sceneDirectory) const;
+		bool LoadCookedWorldCell(const Ref<Scene>& scene, const AssetMetadata& metadata, WorldCellID cellId, const std::filesystem::path& sceneDirectory) const;
+
+		void GetCookedMembers(const IComponentTypeDesc* compDesc, const size_t offset, Vector<CookedMember>& outMembers) const;
+		size_t GetCookedLayoutHash(const IComponentTypeDesc* compDesc) const;
+		bool CanCookWholeComponent(const IComponentTypeDesc* compDesc, const Vector<CookedMember>& members) const;
+
+		void SerializeCookedColumns(std::span<const uint8_t* const> objects, const Vector<CookedMember>& members, BinaryStreamWriter& streamWriter) const;
+		void SerializeCookedArray(const void* arrayPtr, const IArrayTypeDesc* arrayDesc, BinaryStreamWriter& streamWriter) const;
+
+		void DeserializeCookedColumns(std::span<uint8_t* const> objects, const Vector<CookedMember>& members, BinaryStreamReader& streamReader) const;
+		void DeserializeCookedArray(void* arrayPtr, const IArrayTypeDesc* arrayDesc, BinaryStreamReader& streamReader) const;
 
 		void SerializeClass(const uint8_t* data, const size_t offset, const IComponentTypeDesc* compDesc, YAMLMemoryStreamWriter& streamWriter, bool isSubComponent) const;
 		void SerializeArray(const uint8_t* data, const size_t offset, const IArrayTypeDesc* arrayDesc, YAMLMemoryStreamWriter& streamWriter) const;
@@ -55,6 +92,10 @@ namespace Volt
 
 		inline static std::unordered_map<TypeTraits::TypeIndex, std::function<void(YAMLMemoryStreamWriter&, const uint8_t*, const size_t)>> s_typeSerializers;
 		inline static std::unordered_map<TypeTraits::TypeIndex, std::function<void(YAMLMemoryStreamReader&, uint8_t*, const size_t)>> s_typeDeserializers;
+
+		// Only needed for types which can't be stored as raw bytes
+		inline static std::unordered_map<TypeTraits::TypeIndex, std::function<void(BinaryStreamWriter&, const uint8_t*)>> s_cookedTypeSerializers;
+		inline static std::unordered_map<TypeTraits::TypeIndex, std::function<void(BinaryStreamReader&, uint8_t*)>> s_cookedTypeDeserializers;
 	};
 
 	VT_REGISTER_ASSET_SERIALIZER(AssetTypes::Scene, SceneSerializer);
@@ -1,37 +1,94 @@
 #pragma once
 
+#include <AssetSystem/Asset.h>
+
 #include <CoreUtilities/Containers/Vector.h>
 
 #include <glm/glm.hpp>
 
+#include <array>
+
 namespace Volt
 {
-	struct Particle
+	class ParticlePreset;
+
+	// Curves and constants shared by every emitter using a preset, instead of being copied into each particle.
+	struct ParticlePresetSimulationData
 	{
-		Volt::AssetHandle texture = Volt::Asset::Null();
+		AssetHandle texture = Asset::Null();
 
 		Vector<glm::vec4> colors;
-		glm::vec4 color;
+		Vector<glm::vec3> sizes;
 
-		glm::vec3 direction;
-		glm::vec3 position;
+		glm::vec3 gravity = 0.f;
+		float startVelocity = 0.f;
+		float endVelocity = 0.f;
 
-		glm::vec3 gravity;
-		glm::vec3 rotation;
-		Vector<glm::vec3> sizes;
-		glm::vec3 size;
+		void CopyFrom(const ParticlePreset& preset);
+	};
+
+	enum class ParticleStream : uint32_t
+	{
+		PositionX,
+		PositionY,
+		PositionZ,
+
+		DirectionX,
+		DirectionY,
+		DirectionZ,
+
+		RotationX,
+		RotationY,
+		RotationZ,
+
+		Velocity,
+		LifeTime,
+		TotalLifeTime,
+		Distance,
+		RandomValue,
+		TimeSinceSpawn,
+
+		// How far along its life time the particle is, from zero to one
+		NormalizedAge,
+
+		Count
+	};
+
+	// The particles of one emitter as a structure of arrays. Alive particles are kept packed at the front,
+	// and the streams are padded to the SIMD width so the update never needs a scalar tail.
+	class ParticleStorage
+	{
+	public:
+		inline static constexpr uint32_t INVALID_PARTICLE = std::numeric_limits<uint32_t>::max();
+
+		void Resize(uint32_t capacity);
+		void Clear();
+
+		// Returns INVALID_PARTICLE when the pool is full. The particle's values are left for the caller to fill in.
+		uint32_t Spawn();
+
+		// Moves the last alive particle into the slot.
+		void Kill(uint32_t index);
+
+		VT_NODISCARD VT_INLINE uint32_t GetAliveCount() const { return m_aliveCount; }
+		VT_NODISCARD VT_INLINE uint32_t GetCapacity() const { return m_capacity; }
+
+		VT_NODISCARD VT_INLINE float* GetStream(ParticleStream stream) { return m_streams[static_cast<uint32_t>(stream)].data(); }
+		VT_NODISCARD VT_INLINE const float* GetStream(ParticleStream stream) const { return m_streams[static_cast<uint32_t>(stream)].data(); }
 
-		float velocity;
-		float startVelocity;
-		float endVelocity;
+		VT_NODISCARD VT_INLINE Vector<glm::vec4>& GetColors() { return m_colors; }
+		VT_NODISCARD VT_INLINE const Vector<glm::vec4>& GetColors() const { return m_colors; }
+		VT_NODISCARD VT_INLINE Vector<glm::vec3>& GetSizes() { return m_sizes; }
+		VT_NODISCARD VT_INLINE const Vector<glm::vec3>& GetSizes() const { return m_sizes; }
 
-		float totalLifeTime;
-		float lifeTime;
+	private:
+		std::array<Vector<float>, static_cast<uint32_t>(ParticleStream::Count)> m_streams;
 
-		float distance;
-		float randomValue = 0.f;
-		float timeSinceSpawn = 0.f;
+		// Evaluated from the preset curves every update, kept interleaved for rendering.
+		Vector<glm::vec4> m_colors;
+		Vector<glm::vec3> m_sizes;
 
-		bool dead = true;
+		uint32_t m_aliveCount = 0;
+		uint32_t m_capacity = 0;
 	};
 }
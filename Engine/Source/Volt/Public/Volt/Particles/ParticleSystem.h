@@ -11,15 +11,13 @@
 namespace Volt
 {
 	struct ParticleEmitterComponent;
-	struct TransformComponent;
-	struct Particle;
 	class Scene;
 	class ParticlePreset;
 
 	struct ParticleSystemInternalStorage
 	{
-		int numberOfAliveParticles = 0;
-		Vector<Particle> particles;
+		ParticleStorage particles;
+		Ref<ParticlePresetSimulationData> simulationData;
 		AssetHandle preset;
 	};
 
@@ -33,18 +31,14 @@ namespace Volt
 		const auto& GetParticleStorage() const { return m_particleStorage; }
 
 	private:
-		void UpdateParticles(ParticleEmitterComponent& particleEmitterComponent, TransformComponent& transformComp, const float& deltaTime);
-		void SendParticles(ParticleEmitterComponent& particleEmitterComponent, entt::entity id, glm::vec3 aEntityPos, const float& deltaTime);
-
-		bool ParticleKillCheck(Particle& particle, const float& deltaTime);
-		void ParticlePositionUpdate(Particle& particle, const float& deltaTime, const glm::vec3& entityForward);
-		void ParticleSizeUpdate(Particle& particle, const float& deltaTime);
-		void ParticleVelocityUpdate(Particle& particle, const float& deltaTime);
-		void ParticleColorUpdate(Particle& particle, const float& deltaTime);
-		void ParticleTimeUpdate(Particle& particle, float deltaTime);
+		void SendParticles(ParticleEmitterComponent& particleEmitterComponent, ParticleSystemInternalStorage& particleStorage, const ParticlePreset& preset, glm::vec3 aEntityPos, float intensity);
+		void SimulateParticles(ParticleSystemInternalStorage& particleStorage, const glm::vec3& entityForward, float deltaTime);
 
 		std::unordered_map<entt::entity, ParticleSystemInternalStorage> m_particleStorage;
 
+		// Shared by all emitters using the preset, refreshed once per frame.
+		std::unordered_map<AssetHandle, Ref<ParticlePresetSimulationData>> m_presetSimulationData;
+
 		std::shared_mutex m_updateMutex;
 	};
 }
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <PhysX/task/PxCpuDispatcher.h>
+
+namespace Volt
+{
+	// Runs PhysX tasks as jobs on the engine job system, so physics shares its workers with the rest of the engine
+	// instead of running on threads of its own.
+	class PhysXCpuDispatcher : public physx::PxCpuDispatcher
+	{
+	public:
+		PhysXCpuDispatcher() = default;
+		~PhysXCpuDispatcher() override = default;
+
+		void submitTask(physx::PxBaseTask& task) override;
+		uint32_t getWorkerCount() const override;
+	};
+}
@@ -2,6 +2,7 @@
 
 #include "Volt/Core/Base.h"
 #include "PhysicsSettings.h"
+#include "PhysXCpuDispatcher.h"
 
 #include <PhysX/PxPhysicsAPI.h>
 
@@ -39,7 +40,7 @@ namespace Volt
 		struct PhysXData
 		{
 			physx::PxFoundation* physxFoundation{};
-			physx::PxDefaultCpuDispatcher* physxCPUDispatcher{};
+			PhysXCpuDispatcher physxCPUDispatcher;
 			physx::PxPhysics* physxSDK{};
 
 			physx::PxDefaultAllocator allocator{};
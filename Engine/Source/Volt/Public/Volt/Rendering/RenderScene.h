@@ -3,6 +3,7 @@
 #include "Volt/Asset/Mesh/Mesh.h"
 
 #include "Volt/Rendering/RenderObject.h"
+#include "Volt/Animation/AnimationPoseJob.h"
 
 #include <RenderCore/Resources/BindlessResource.h>
 #include <CoreUtilities/Containers/Map.h>
@@ -100,6 +101,7 @@ namespace Volt
 		void UpdateInvalidMeshes(RenderGraph& renderGraph);
 		void UpdateInvalidPrimitiveData(RenderGraph& renderGraph);
 		void CompactValidPrimitiveDrawDatas(RenderGraph& renderGraph);
+		void UpdateAnimationBuffer();
 
 		struct InvalidMaterial
 		{
@@ -150,6 +152,10 @@ namespace Volt
 		Vector<Weak<Material>> m_individualMaterials;
 		Vector<glm::mat4> m_animationBufferStorage;
 
+		// Rebuilt every frame, kept around so their memory is reused.
+		Vector<AnimationPoseRequest> m_animationPoseRequests;
+		vt::map<const MotionWeaver*, uint32_t> m_boneOffsetFromMotionWeaver;
+
 		GPUSceneBuffers m_buffers;
 
 		Scene* m_scene = nullptr;
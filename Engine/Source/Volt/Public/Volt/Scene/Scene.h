@@ -79,6 +79,7 @@ namespace Volt
 
 		Entity CreateEntity(const std::string& tag = "");
 		Entity CreateEntityWithID(const EntityID& id, const std::string& tag = "");
+		Vector<Entity> CreateEntitiesWithIDs(const Vector<EntityID>& ids, const std::string& tag = "");
 
 		Entity GetEntityFromID(const EntityID id) const;
 		Entity GetEntityFromHandle(entt::entity entityHandle) const;
@@ -87,6 +88,7 @@ namespace Volt
 
 		bool IsRelatedTo(Entity entity, Entity otherEntity);
 		void DestroyEntity(Entity entity);
+		void DestroyEntities(const Vector<EntityID>& entityIds);
 		void ParentEntity(Entity parent, Entity child);
 		void UnparentEntity(Entity entity);
 
@@ -122,9 +124,20 @@ namespace Volt
 		friend class Entity;
 		friend class SceneImporter;
 		friend class SceneSerializer;
+		friend class WorldEngine;
 
 		void Initialize();
 
+		// Structural changes played back from the command buffers of the entity scene
+		Vector<EntityHelper> CreateEntitiesFromCommandBuffer(size_t count);
+		void DestroyEntitiesFromCommandBuffer(const Vector<EntityID>& entityIds);
+
+		// The camera with the highest priority, the same one the game is rendered from.
+		Entity GetActiveCameraEntity() const;
+
+		// Keeps the world engine streaming around the active camera while playing.
+		void UpdateCameraStreamingObserver();
+
 		void IsRecursiveChildOf(Entity mainParent, Entity currentEntity, bool& outChild);
 		void ConvertToWorldSpace(Entity entity);
 		void ConvertToLocalSpace(Entity entity);
@@ -136,6 +149,10 @@ namespace Volt
 		SceneSettings m_sceneSettings;
 		Statistics m_statistics;
 		WorldEngine m_worldEngine;
+		WorldStreamingObserverID m_cameraStreamingObserver = INVALID_STREAMING_OBSERVER_ID;
+
+		// Cells are streamed from the cooked entity data instead of the entity files
+		bool m_hasCookedEntities = false;
 
 		bool m_isPlaying = false;
 		float m_timeSinceStart = 0.f;
@@ -12,12 +12,28 @@ namespace Volt
 
 	static constexpr WorldCellID INVALID_WORLD_CELL_ID = std::numeric_limits<uint32_t>::max();
 
+	enum class WorldCellState : uint8_t
+	{
+		Unloaded,
+
+		// The entities are being decoded into staging scenes on a worker thread.
+		Streaming,
+
+		Loaded
+	};
+
 	struct WorldCell
 	{
 		WorldCellID cellId = 0;
 		Vector<EntityID> cellEntities;
 		glm::ivec3 origin;
 
-		bool isLoaded = false;
+		// Integer position in the cell grid, derived from the origin.
+		glm::ivec2 coordinates = 0;
+
+		WorldCellState state = WorldCellState::Unloaded;
+
+		// Bumped every time the cell starts streaming or is unloaded, so stale staged data is dropped.
+		uint32_t streamingGeneration = 0;
 	};
 }
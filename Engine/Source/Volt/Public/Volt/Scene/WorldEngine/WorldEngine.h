@@ -2,6 +2,12 @@
 
 #include "WorldCell.h"
 
+#include <AssetSystem/Asset.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace Volt
 {
 	struct WorldGridSettings
@@ -10,12 +16,44 @@ namespace Volt
 		glm::uvec2 worldSize = { 128'000, 128'000 };
 	};
 
+	struct WorldStreamingSettings
+	{
+		// Cells closer than the load distance to an observer are streamed in. They are only unloaded once
+		// every observer is further away than the unload distance, so cells on the border don't flicker.
+		float loadDistance = 25'600.f;
+		float unloadDistance = 38'400.f;
+
+		uint32_t maxCellLoadsPerFrame = 4;
+		uint32_t maxCellUnloadsPerFrame = 4;
+	};
+
+	typedef uint32_t WorldStreamingObserverID;
+	static constexpr WorldStreamingObserverID INVALID_STREAMING_OBSERVER_ID = std::numeric_limits<uint32_t>::max();
+
 	class Scene;
 	class Entity;
 
+	// A cell decoded off the main thread, waiting to be merged into the scene.
+	struct StagedWorldCell
+	{
+		WorldCellID cellId = INVALID_WORLD_CELL_ID;
+		uint32_t streamingGeneration = 0;
+
+		// Copied when streaming starts, the worker thread never reads the scene.
+		AssetMetadata sceneMetadata;
+		Vector<EntityID> cellEntities;
+		bool useCookedEntities = false;
+
+		// Isolated scenes the entities are decoded into, and the entities as (staging scene index, entity ID).
+		Vector<Ref<Scene>> stagingScenes;
+		Vector<std::pair<uint32_t, EntityID>> stagedEntities;
+	};
+
 	class WorldEngine
 	{
 	public:
+		inline static constexpr float DEFAULT_MERGE_BUDGET = 2.f;
+
 		WorldEngine() = default;
 
 		void Reset(Scene* scene, uint32_t initialCellCount, uint32_t cellCountWidth);
@@ -27,21 +65,76 @@ namespace Volt
 		void OnEntityMoved(const Entity& entity);
 
 		void BeginStreamingCell(WorldCellID cellId);
+		void UnloadCell(WorldCellID cellId);
+
+		// Observers drive the streaming, cells are loaded and unloaded around them in Update.
+		WorldStreamingObserverID AddStreamingObserver(const glm::vec3& position);
+		void SetStreamingObserverPosition(WorldStreamingObserverID observerId, const glm::vec3& position);
+		void RemoveStreamingObserver(WorldStreamingObserverID observerId);
+
+		// Streams cells around the observers and merges staged cells into the scene until the budget (in milliseconds) is used up. Called on the main thread.
+		// A cell is always merged as a whole, so the scene never contains part of a cell, or children without their parents.
+		void Update(float mergeBudget = DEFAULT_MERGE_BUDGET);
 
 		WorldCellID GetCellIDFromEntity(const Entity& entity) const;
+		WorldCellID GetCellIDFromPosition(const glm::vec3& position) const;
+		[[nodiscard]] glm::ivec2 GetCellCoordinates(const glm::vec3& position) const;
 		[[nodiscard]] bool IsCellLoaded(WorldCellID cellId) const;
 
 		[[nodiscard]] inline const Vector<WorldCell>& GetCells() const { return m_cells; }
 		[[nodiscard]] inline const WorldGridSettings& GetSettings() const { return m_settings; }
 		[[nodiscard]] inline WorldGridSettings& GetSettingsMutable() { return m_settings; }
+		[[nodiscard]] inline const WorldStreamingSettings& GetStreamingSettings() const { return m_streamingSettings; }
+		[[nodiscard]] inline WorldStreamingSettings& GetStreamingSettingsMutable() { return m_streamingSettings; }
 
 	private:
+		struct StagingQueue
+		{
+			std::mutex mutex;
+			Vector<Ref<StagedWorldCell>> stagedCells;
+		};
+
+		struct StreamingObserver
+		{
+			WorldStreamingObserverID id;
+			glm::vec3 position;
+		};
+
 		WorldCell& GetCellFromID(WorldCellID cellId);
 		const WorldCell& GetCellFromID(WorldCellID cellId) const;
 
+		void AddEntityToCell(WorldCell& cell, EntityID entityId);
+		void RemoveEntityFromCell(WorldCellID cellId, EntityID entityId);
+
+		void UpdateStreaming();
+		float GetDistanceToCell(const WorldCell& cell, const glm::vec3& position) const;
+
+		bool MergeStagedEntities(StagedWorldCell& stagedCell);
+
 		WorldGridSettings m_settings;
+		WorldStreamingSettings m_streamingSettings;
+
 		Vector<WorldCell> m_cells;
 
+		// Indices into m_cells, keyed on packed cell coordinates and on cell ID.
+		std::unordered_map<uint64_t, uint32_t> m_cellIndexFromCoordinates;
+		std::unordered_map<WorldCellID, uint32_t> m_cellIndexFromID;
+
+		std::unordered_map<EntityID, WorldCellID> m_entityCells;
+
+		// Every cell which isn't unloaded, so the streaming never has to visit the whole grid.
+		std::unordered_set<WorldCellID> m_activeCells;
+
+		Vector<StreamingObserver> m_streamingObservers;
+		WorldStreamingObserverID m_nextObserverId = 0;
+
+		// Shared by all cells, so staged data from before the cells were regenerated can never match.
+		uint32_t m_streamingGeneration = 0;
+
+		// Filled by the streaming jobs, which only hold a reference to the queue.
+		Ref<StagingQueue> m_stagingQueue = CreateRef<StagingQueue>();
+		Vector<Ref<StagedWorldCell>> m_mergeQueue;
+
 		Scene* m_scene = nullptr;
 	};
 }